@@ -12,7 +12,7 @@ public class Orion : ModuleRules
 
         PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "AIModule", "Niagara", "UMG", "Slate", "SlateCore", "ChaosVehicles", "Json", "JsonUtilities"});
 
-        PrivateDependencyModuleNames.AddRange(new string[] { "NavigationSystem" });
+        PrivateDependencyModuleNames.AddRange(new string[] { "NavigationSystem", "EngineSettings" });
 
         // Uncomment if you are using Slate UI
         // PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
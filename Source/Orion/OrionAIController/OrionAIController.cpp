@@ -221,7 +221,8 @@ AActor* AOrionAIController::GetClosestHostileActor() const
 		return nullptr;
 	}
 
-	const EFaction MyFaction = MyControlledPawn->AttributeComp->ActorFaction;
+	// One AND per candidate: hostile row of my faction against the target's cached faction bit
+	const uint32 MyHostileMask = FactionManager->GetHostileMask(MyControlledPawn->AttributeComp->ActorFaction);
 	const FVector MyLocation = MyControlledPawn->GetActorLocation();
 
 	// 分别跟踪非 BaseStorage 和 BaseStorage 的最近目标
@@ -236,11 +237,11 @@ AActor* AOrionAIController::GetClosestHostileActor() const
 		if (!Actor || Actor == MyControlledPawn) return;
 
 		// Check for AttributeComponent
-		const UOrionAttributeComponent* TargetAttr = Actor->FindComponentByClass<UOrionAttributeComponent>();
+		const UOrionAttributeComponent* TargetAttr = UOrionAttributeComponent::FindOnActor(Actor);
 		if (!TargetAttr || !TargetAttr->IsAlive()) return;
 
 		// Check Faction
-		if (!FactionManager->IsHostile(MyFaction, TargetAttr->ActorFaction)) return;
+		if (!(MyHostileMask & TargetAttr->FactionBit)) return;
 
 		// Check Distance
 		float Dist2 = FVector::DistSquared(MyLocation, Actor->GetActorLocation());
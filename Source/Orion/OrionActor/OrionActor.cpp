@@ -5,6 +5,7 @@
 #include "Orion/OrionComponents/OrionInventoryComponent.h"
 #include "Orion/OrionComponents/OrionStructureComponent.h"
 #include "Orion/OrionComponents/OrionAttributeComponent.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
 
 AOrionActor::AOrionActor()
 {
@@ -45,6 +46,11 @@ void AOrionActor::BeginPlay()
 
 	InitSerializable(ActorSerializable); // Distribute the sole identifier of this game object.
 
+	if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+	{
+		AutosaveManager->MarkDirty(this);
+	}
+
 	if (InventoryComp)
 	{
 		InventoryComp->AvailableInventoryMap = AvailableInventoryMap;
@@ -59,6 +65,37 @@ void AOrionActor::BeginPlay()
 	}
 }
 
+void AOrionActor::MarkAutosaveDirty()
+{
+	if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+	{
+		AutosaveManager->MarkDirty(this);
+	}
+}
+
+void AOrionActor::SetActorStatus(const EActorStatus NewStatus)
+{
+	if (ActorStatus != NewStatus)
+	{
+		ActorStatus = NewStatus;
+		MarkAutosaveDirty();
+	}
+}
+
+void AOrionActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Only real removals, not level teardown
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+		{
+			AutosaveManager->MarkRemoved(ActorSerializable.GameId);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AOrionActor::InitSerializable(const FSerializable& /*In*/)
 {
 	if (!ActorSerializable.GameId.IsValid())
@@ -94,7 +131,7 @@ void AOrionActor::Die()
 {
 	UE_LOG(LogTemp, Log, TEXT("OrionActor::Die: %s died."), *GetName());
 
-	ActorStatus = EActorStatus::NotInteractable;
+	SetActorStatus(EActorStatus::NotInteractable);
 	SpawnDeathEffect(GetActorLocation());
 }
 
@@ -37,6 +37,10 @@ struct FOrionActorFullRecord
 
 	UPROPERTY(SaveGame)
 	TArray<uint8> SerializedBytes;
+
+	/* SerializedBytes refer to the name table of the save (FOrionNameTableArchive), old saves hold strings */
+	UPROPERTY(SaveGame)
+	bool bUsesNameTable = false;
 };
 
 
@@ -74,6 +78,10 @@ public:
 	FSerializable ActorSerializable;
 
 	virtual void InitSerializable(const FSerializable& InSerializable) override;
+
+	/* SaveGame state changed (status, workers, production): written by the next delta autosave */
+	void MarkAutosaveDirty();
+	void SetActorStatus(EActorStatus NewStatus);
 	virtual FSerializable GetSerializable() const override { return ActorSerializable; }
 
 	/* --- 交互 / 分类 --- */
@@ -128,6 +136,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	void Die();
 	void HandleDelayedDestroy();
 
@@ -33,11 +33,11 @@ void AOrionActorOre::Tick(float DeltaTime)
 	if (OreCategory == EOreCategory::StoneOre &&
 		InventoryComp && InventoryComp->FullInventoryStatus.FindRef(2))
 	{
-		ActorStatus = EActorStatus::NotInteractable;
+		SetActorStatus(EActorStatus::NotInteractable);
 	}
 	else
 	{
-		ActorStatus = EActorStatus::Interactable;
+		SetActorStatus(EActorStatus::Interactable);
 	}
 }
 
@@ -85,6 +85,7 @@ void AOrionActorOre::ProductionProgressUpdate(float DeltaTime)
 
 	// Accumulate the progress.
 	ProductionProgress += ProgressIncrement;
+	MarkAutosaveDirty();
 
 	// When production progress reaches or exceeds 100, consider production complete.
 	while (ProductionProgress >= 100.0f)
@@ -42,11 +42,11 @@ void AOrionActorProduction::Tick(float DeltaTime)
 	if (ProductionCategory == EProductionCategory::Bullets &&
 		InventoryComp && InventoryComp->FullInventoryStatus.FindRef(3))
 	{
-		ActorStatus = EActorStatus::NotInteractable;
+		SetActorStatus(EActorStatus::NotInteractable);
 	}
 	else
 	{
-		ActorStatus = EActorStatus::Interactable;
+		SetActorStatus(EActorStatus::Interactable);
 	}
 }
 
@@ -67,6 +67,7 @@ void AOrionActorProduction::ProductionProgressUpdate(float DeltaTime)
 
 	// Accumulate the progress.
 	ProductionProgress += ProgressIncrement;
+	MarkAutosaveDirty();
 
 	// When production progress reaches or exceeds 100, consider production complete.
 	while (ProductionProgress >= 100.0f)
@@ -26,6 +26,7 @@
 #include "Components/PrimitiveComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
 
 class OrionActorStorage;
 
@@ -78,6 +79,20 @@ void AOrionChara::InitSerializable(const FSerializable& InSerializable)
 	}
 }
 
+void AOrionChara::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Only real removals, not level teardown
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+		{
+			AutosaveManager->MarkRemoved(GameSerializable.GameId);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 FSerializable AOrionChara::GetSerializable() const
 {
 	return GameSerializable;
@@ -89,6 +104,11 @@ void AOrionChara::BeginPlay()
 
 	InitSerializable(GameSerializable);
 
+	if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+	{
+		AutosaveManager->MarkDirty(this);
+	}
+
 	OrionAIControllerInstance = Cast<AOrionAIController>(GetController());
 
 	InitOrionCharaMovement();
@@ -1230,6 +1250,7 @@ bool AOrionChara::InteractWithActorStart(const EInteractWithActorState& State)
 	}
 
 	CurrentInteractActor->CurrWorkers += 1;
+	CurrentInteractActor->MarkAutosaveDirty();
 
 	FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(
 		GetActorLocation(),
@@ -1277,6 +1298,7 @@ void AOrionChara::InteractWithActorStop(EInteractWithActorState& State)
 		if (CurrentInteractActor)
 		{
 			CurrentInteractActor->CurrWorkers -= 1;
+			CurrentInteractActor->MarkAutosaveDirty();
 		}
 
 		if (InteractAnimationKind == EInteractCategory::Mining)
@@ -1412,6 +1434,15 @@ std::vector<AOrionChara*> AOrionChara::GetOtherCharasByProximity() const
 
 	std::vector<AOrionChara*> Enemies;
 	Enemies.reserve(AllActors.Num());
+
+	// [Refactor] Use Faction System via AttributeComp instead of CharaSide
+	const UOrionFactionManager* FactionManager = GetGameInstance()->GetSubsystem<UOrionFactionManager>();
+	if (!AttributeComp || !FactionManager)
+	{
+		return Enemies;
+	}
+	const uint32 MyHostileMask = FactionManager->GetHostileMask(AttributeComp->ActorFaction);
+
 	for (AActor* Actor : AllActors)
 	{
 		if (Actor == this)
@@ -1421,16 +1452,9 @@ std::vector<AOrionChara*> AOrionChara::GetOtherCharasByProximity() const
 
 		if (AOrionChara* Other = Cast<AOrionChara>(Actor))
 		{
-			// [Refactor] Use Faction System via AttributeComp instead of CharaSide
-			if (AttributeComp && Other->AttributeComp)
+			if (Other->AttributeComp && (MyHostileMask & Other->AttributeComp->FactionBit))
 			{
-				if (const UOrionFactionManager* FactionManager = GetGameInstance()->GetSubsystem<UOrionFactionManager>())
-				{
-					if (FactionManager->IsHostile(AttributeComp->ActorFaction, Other->AttributeComp->ActorFaction))
-					{
-						Enemies.push_back(Other);
-					}
-				}
+				Enemies.push_back(Other);
 			}
 		}
 	}
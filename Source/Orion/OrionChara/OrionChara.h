@@ -40,6 +40,10 @@ struct FOrionCharaSerializable
 
 	UPROPERTY(SaveGame)
 	TArray<uint8> SerializedBytes;
+
+	/* SerializedBytes refer to the name table of the save (FOrionNameTableArchive), old saves hold strings */
+	UPROPERTY(SaveGame)
+	bool bUsesNameTable = false;
 };
 
 
@@ -98,6 +102,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 	/* 1. References to External Resources*/
@@ -1,4 +1,5 @@
 #include "OrionActionComponent.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
 
 UOrionActionComponent::UOrionActionComponent()
 {
@@ -8,6 +9,16 @@ UOrionActionComponent::UOrionActionComponent()
 void UOrionActionComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	ProceduralActionQueue.Actions.OnArrayChanged.AddUObject(this, &UOrionActionComponent::OnProceduralQueueChanged);
+}
+
+void UOrionActionComponent::OnProceduralQueueChanged(FName /*Operation*/)
+{
+	if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+	{
+		AutosaveManager->MarkDirty(GetOwner());
+	}
 }
 
 void UOrionActionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -235,6 +235,9 @@ private:
 	// Helper to handle state transitions
 	void SwitchAction(FOrionAction* OldAction, FOrionAction* NewAction, FGuid& TrackedID);
 
+	// The procedural queue is saved with the owner: any change marks it for the next autosave
+	void OnProceduralQueueChanged(FName Operation);
+
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config(Non-null)")
 	bool bIsProceduralMode = false;
@@ -2,6 +2,9 @@
 
 
 #include "OrionAttributeComponent.h"
+#include "Orion/OrionActor/OrionActor.h"
+#include "Orion/OrionChara/OrionChara.h"
+#include "Orion/OrionStructure/OrionStructure.h"
 
 // Sets default values for this component's properties
 UOrionAttributeComponent::UOrionAttributeComponent()
@@ -23,6 +26,38 @@ void UOrionAttributeComponent::BeginPlay()
 
 	// Ensure Health starts at MaxHealth
 	Health = MaxHealth;
+
+	// Faction may have been set in editor / Blueprint defaults
+	FactionBit = UOrionFactionManager::GetFactionBit(ActorFaction);
+}
+
+void UOrionAttributeComponent::SetActorFaction(const EFaction NewFaction)
+{
+	ActorFaction = NewFaction;
+	FactionBit = UOrionFactionManager::GetFactionBit(NewFaction);
+}
+
+UOrionAttributeComponent* UOrionAttributeComponent::FindOnActor(const AActor* Actor)
+{
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	if (const AOrionChara* Chara = Cast<AOrionChara>(Actor))
+	{
+		return Chara->AttributeComp;
+	}
+	if (const AOrionActor* OrionActor = Cast<AOrionActor>(Actor))
+	{
+		return OrionActor->AttributeComp;
+	}
+	if (const AOrionStructure* Structure = Cast<AOrionStructure>(Actor))
+	{
+		return Structure->AttributeComp;
+	}
+
+	return Actor->FindComponentByClass<UOrionAttributeComponent>();
 }
 
 
@@ -35,9 +35,18 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attributes")
 	float Health = 100.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetActorFaction, Category = "Attributes")
 	EFaction ActorFaction = EFaction::PlayerFaction;
 
+	/* Cached UOrionFactionManager::GetFactionBit(ActorFaction), kept in sync by SetActorFaction */
+	uint32 FactionBit = UOrionFactionManager::GetFactionBit(EFaction::PlayerFaction);
+
+	UFUNCTION(BlueprintSetter)
+	void SetActorFaction(EFaction NewFaction);
+
+	/* Reads the AttributeComp pointer cached on Orion actor classes, falls back to FindComponentByClass */
+	static UOrionAttributeComponent* FindOnActor(const AActor* Actor);
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Attributes")
 	bool IsBaseStorage = false;
 
@@ -2,15 +2,12 @@
 #include "Components/TextRenderComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionItemManager.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
 #include "Orion/OrionGlobals/OrionDataItem.h"
 #include "Orion/OrionHUD/OrionHUD.h"
 
-TArray<FOrionDataItem> UOrionInventoryComponent::ItemInfoTable = {
-	{1, FName("Log"), FText::FromString("Log"), FText::FromString(TEXT("原木")), 1.f, 30.f},
-	{2, FName("StoneOre"), FText::FromString("Stone Ore"), FText::FromString(TEXT("石矿")), 2.f, 30.f},
-	{3, FName("Bullet"), FText::FromString("Bullet"), FText::FromString(TEXT("子弹")), 2.f, 30.f},
-};
-
 UOrionInventoryComponent::UOrionInventoryComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -22,10 +19,6 @@ UOrionInventoryComponent::UOrionInventoryComponent()
 		{3, 300}, // Bullet
 		{4, 300}, // 预留
 	};
-
-	static const FString Path = TEXT("/Game/_Orion/UI/UI_ResourceFloat/WB_ResourceFloat.WB_ResourceFloat_C");
-	FloatWidgetClass = LoadClass<UOrionUserWidgetResourceFloat>(nullptr, *Path);
-	checkf(FloatWidgetClass, TEXT("Cannot load resource floating ui from %s"), *Path);
 }
 
 void UOrionInventoryComponent::BeginPlay()
@@ -37,6 +30,18 @@ void UOrionInventoryComponent::BeginPlay()
 
 	InventoryManagerInstance->RegisterInventoryComponent(this);
 
+	ItemManagerInstance = GetWorld()->GetGameInstance()->GetSubsystem<UOrionItemManager>();
+	checkf(ItemManagerInstance, TEXT("UOrionInventoryComponent::BeginPlay: cannot find ItemManagerInstance"));
+
+	// 浮动 UI 类在启动时已预加载
+	const UOrionAssetPreloadManager* PreloadManager = UOrionAssetPreloadManager::Get(this);
+	checkf(PreloadManager, TEXT("UOrionInventoryComponent::BeginPlay: cannot find PreloadManager"));
+
+	FloatWidgetClass = PreloadManager->FindOrLoadClass<UOrionUserWidgetResourceFloat>(
+		UOrionAssetPreloadManager::ResourceFloatWidgetPath);
+	checkf(FloatWidgetClass, TEXT("Cannot load resource floating ui from %s"),
+	       UOrionAssetPreloadManager::ResourceFloatWidgetPath);
+
 	this->OnInventoryChanged.AddDynamic(Cast<AOrionHUD>(GetWorld()->GetFirstPlayerController()->GetHUD()), &AOrionHUD::UpdatePlayerFactionResourceDisplay);
 }
 
@@ -62,20 +67,14 @@ void UOrionInventoryComponent::RefreshInventoryText()
 			int32 ItemId = Pair.Key;
 			int32 Quantity = Pair.Value;
 
-			FString Name;
-			switch (ItemId)
+			if (const FOrionDataItem& Info = GetItemInfo(ItemId); Info.ItemId != 0)
 			{
-			case 1: Name = TEXT("Log");
-				break;
-			case 2: Name = TEXT("StoneOre");
-				break;
-			case 3: Name = TEXT("Bullet");
-				break;
-			default: Name = FString::Printf(TEXT("Item%d"), ItemId);
-				break;
+				Out += FString::Printf(TEXT("%s:%d  "), *Info.Name.ToString(), Quantity);
+			}
+			else
+			{
+				Out += FString::Printf(TEXT("Item%d:%d  "), ItemId, Quantity);
 			}
-
-			Out += FString::Printf(TEXT("%s:%d  "), *Name, Quantity);
 		}
 
 		if (Out.IsEmpty())
@@ -91,7 +90,7 @@ void UOrionInventoryComponent::RefreshInventoryText()
 
 void UOrionInventoryComponent::SpawnResourceFloatUI(const int32 ItemId, const int32 Quantity) const
 {
-	const FOrionDataItem Info = GetItemInfo(ItemId);
+	const FOrionDataItem& Info = GetItemInfo(ItemId);
 	const FString Name = Info.DisplayName.ToString();
 	const FString Prefix = (Quantity > 0 ? TEXT("+") : TEXT("-"));
 	const FString Text = FString::Printf(TEXT("%s%d %s"), *Prefix, FMath::Abs(Quantity), *Name);
@@ -197,9 +196,10 @@ void UOrionInventoryComponent::SpawnNewResourceFloatUI(const int32 ItemId, const
 		return;
 	}
 
-	if (const TSoftObjectPtr<UTexture2D>* TexturePtr = ItemIDToTextureMap.Find(ItemId))
+	const UOrionItemManager* ItemManager = GetItemManager();
+	if (UTexture2D* Icon = ItemManager ? ItemManager->GetItemIcon(ItemId) : nullptr)
 	{
-		W->SetIcon(TexturePtr->LoadSynchronous());
+		W->SetIcon(Icon);
 	}
 	W->DeltaText->SetText(FText::FromString(FString::Printf(TEXT("%s%d %s"), (Quantity > 0 ? TEXT("+") : TEXT("-")),
 	                                                        FMath::Abs(Quantity),
@@ -254,22 +254,31 @@ TArray<FIntPoint> UOrionInventoryComponent::GetAllItems() const
 	return Out;
 }
 
-FOrionDataItem UOrionInventoryComponent::GetItemInfo(int32 ItemId) const
+UOrionItemManager* UOrionInventoryComponent::GetItemManager() const
+{
+	return ItemManagerInstance ? ItemManagerInstance : UOrionItemManager::Get(this);
+}
+
+const FOrionDataItem& UOrionInventoryComponent::GetItemInfo(int32 ItemId) const
 {
-	for (const auto& Info : ItemInfoTable)
+	if (const UOrionItemManager* ItemManager = GetItemManager())
 	{
-		if (Info.ItemId == ItemId)
-		{
-			return Info;
-		}
+		return ItemManager->GetItemInfo(ItemId);
 	}
 
-	return FOrionDataItem{};
+	static const FOrionDataItem Invalid;
+	return Invalid;
 }
 
 const TArray<FOrionDataItem>& UOrionInventoryComponent::GetAllItemInfos() const
 {
-	return ItemInfoTable;
+	if (const UOrionItemManager* ItemManager = GetItemManager())
+	{
+		return ItemManager->GetAllItemInfos();
+	}
+
+	static const TArray<FOrionDataItem> Empty;
+	return Empty;
 }
 
 void UOrionInventoryComponent::OnInventoryChange()
@@ -287,5 +296,11 @@ void UOrionInventoryComponent::OnInventoryChange()
 	}
 
 	RefreshInventoryText();
+
+	if (UOrionAutosaveManager* AutosaveManager = UOrionAutosaveManager::Get(this))
+	{
+		AutosaveManager->MarkDirty(GetOwner());
+	}
+
 	OnInventoryChanged.Broadcast();
 }
@@ -8,6 +8,7 @@
 
 
 class UOrionInventoryManager;
+class UOrionItemManager;
 
 USTRUCT(BlueprintType)
 struct FOrionInventorySerializable
@@ -37,6 +38,7 @@ public:
 
 	/* External Resources References */
 	UPROPERTY() UOrionInventoryManager* InventoryManagerInstance;
+	UPROPERTY() UOrionItemManager* ItemManagerInstance;
 
 
 	const TMap<int32, int32>& GetInventoryMap() const { return InventoryMap; }
@@ -99,9 +101,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<FIntPoint> GetAllItems() const;
 
-	/** Query static item information by ItemId, return nullptr if not found */
+	/** Query static item information by ItemId, return an empty definition (ItemId == 0) if not found */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-	FOrionDataItem GetItemInfo(int32 ItemId) const;
+	const FOrionDataItem& GetItemInfo(int32 ItemId) const;
 
 	/** Return all preset item information list */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
@@ -117,5 +119,6 @@ public:
 
 	virtual void BeginPlay() override;
 
-	static TArray<FOrionDataItem> ItemInfoTable;
+private:
+	UOrionItemManager* GetItemManager() const;
 };
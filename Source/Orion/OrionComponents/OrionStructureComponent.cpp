@@ -64,16 +64,24 @@ void UOrionStructureComponent::BeginPlay()
 
 
 	// Decay Adjustment
-	if (OrionStructureType == EOrionStructure::Wall || OrionStructureType == EOrionStructure::DoubleWall)
-		StabilityDecay = 0.1f;
-	else 
-		StabilityDecay = 0.25f;
+	StabilityDecay = GetDefaultStabilityDecay(OrionStructureType);
 
 	if (bAutoRegisterSockets && !BIsPreviewStructure)
 	{
 		SocketsRegistryHandler();
-		// 注意：BeginPlay 时不需要手动调 UpdateStability，
-		// 因为 BuildingManager::DelaySpawnNewStructure 里会调。
+
+		// 接入连通图（读档时没有 DelaySpawnNewStructure，支撑关系在这里建立）
+		// 注意：这里不做崩塌判定，读档顺序可能先生成上层结构；
+		// 放置时由 BuildingManager::DelaySpawnNewStructure 调 UpdateStability 完成判定。
+		// 批量读档时只登记，由 EndBulkLoad 统一连边并求解一次
+		if (BuildingManager->IsBulkLoading())
+		{
+			BuildingManager->AddBulkStructure(this);
+		}
+		else
+		{
+			BuildingManager->AddStructureNode(this, CheckIsTouchingGround());
+		}
 	}
 }
 
@@ -85,76 +93,13 @@ void UOrionStructureComponent::UpdateStability()
 {
 	if (!BuildingManager) return;
 
-	float NewStability = 0.0f;
+	// 1. (重新) 接入连通图：接地检测 + 邻居连接，获得的支撑会立即传播给邻居
+	BuildingManager->AddStructureNode(this, CheckIsTouchingGround());
 
-	// 1. 接地检测 (Anchor = 100%)
-	if (CheckIsTouchingGround())
+	// 2. 崩塌检测：没有任何支撑，交给崩塌队列统一处理
+	if (CurrentStability <= 0.0f)
 	{
-		NewStability = 1.0f;
-	}
-	else
-	{
-		// 2. 获取所有物理连接的邻居
-		TArray<UOrionStructureComponent*> Neighbors = BuildingManager->GetConnectedNeighbors(GetOwner());
-		
-		float MaxNeighborStability = 0.0f;
-		UOrionStructureComponent* BestNeighbor = nullptr;
-
-		for (const UOrionStructureComponent* Neighbor : Neighbors)
-		{
-			if (Neighbor->CurrentStability > MaxNeighborStability)
-			{
-				MaxNeighborStability = Neighbor->CurrentStability;
-				BestNeighbor = const_cast<UOrionStructureComponent*>(Neighbor);
-			}
-		}
-
-		// [Debug] 可视化支撑关系：画一条线指向支撑我的那个邻居
-		if (BestNeighbor && GetWorld())
-		{
-			DrawDebugLine(GetWorld(), GetOwner()->GetActorLocation(), BestNeighbor->GetOwner()->GetActorLocation(), 
-				FColor::Cyan, false, 0.1f, 0, 5.0f);
-		}
-
-		// 3. 计算：最强邻居 - 衰减
-		NewStability = MaxNeighborStability - StabilityDecay;
-	}
-
-	// 4. 钳制范围
-	if (NewStability < 0.0f) NewStability = 0.0f;
-
-	// 5. 只有数值变化了才处理 (防止无限递归)
-	if (!FMath::IsNearlyEqual(CurrentStability, NewStability, 0.001f))
-	{
-		CurrentStability = NewStability;
-
-		UE_LOG(LogTemp, Log, TEXT("[Stability] %s value updated: %.2f"), *GetOwner()->GetName(), CurrentStability);
-
-		// [Debug] 持久化显示稳定性数值 (事件触发)
-		if (GetWorld())
-		{
-			// 使用 -1.0f (Infinite duration) 持久显示
-			DrawDebugString(GetWorld(), FVector(0, 0, 100), 
-				FString::Printf(TEXT("%.2f"), CurrentStability), 
-				GetOwner(), FColor::Blue, -1.0f, /*bDrawShadow=*/true, /*FontScale=*/1.0f);
-		}
-
-		// 6. 崩塌检测
-		if (CurrentStability <= 0.0f)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("[Stability] %s unstable! Collapsing..."), *GetOwner()->GetName());
-
-			GetOwner()->Destroy();
-		}
-		else
-		{
-			// 7. 传播：通知邻居重新计算
-			for (TArray<UOrionStructureComponent*> Neighbors = BuildingManager->GetConnectedNeighbors(GetOwner()); UOrionStructureComponent* Neighbor : Neighbors)
-			{
-				// 递归调用
-				Neighbor->UpdateStability();
-			}
-		}
+		BuildingManager->QueueCollapse({GetOwner()});
 	}
 }
 
@@ -162,32 +107,16 @@ void UOrionStructureComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	if (EndPlayReason == EEndPlayReason::Destroyed && !BIsPreviewStructure)
 	{
-		// 1. 获取邻居 (必须在 Unregister 之前获取，否则找不到)
-		// 注意：此时我已经不能提供支撑了，但邻居还不知道
-		TArray<UOrionStructureComponent*> Neighbors;
 		if (BuildingManager)
 		{
-			Neighbors = BuildingManager->GetConnectedNeighbors(GetOwner());
-			
-			// 2. 立即从 Grid 移除我的插槽
-			// 这样邻居在下一行重算时，就不会再扫描到我了
+			// 立即从 Grid 移除我的插槽
 			BuildingManager->UnregisterSockets(GetOwner());
+
+			// 从连通图移除：依赖我支撑的结构会在后台重新求解，需要崩塌的会作为一批返回
+			BuildingManager->RemoveStructureNode(this);
 		}
 
-		// [Fix] 关键：在通知邻居前，先将自己的稳定性归零！
-		// 原因：因为使用的是物理重叠检测，邻居在 UpdateStability 时可能仍然能检测到我（物理碰撞体还没销毁）。
-		// 如果我不归零，邻居会读到我旧的高稳定性数值，从而误判为"支撑依旧存在"，导致不进行连锁更新。
 		CurrentStability = 0.0f;
-
-		// 3. 强制邻居重算
-		for (UOrionStructureComponent* Neighbor : Neighbors)
-		{
-			if (Neighbor && Neighbor->IsValidLowLevel())
-			{
-				// 邻居会发现少了一个支撑 (我)，从而算出更低的值
-				Neighbor->UpdateStability();
-			}
-		}
 	}
 
 	Super::EndPlay(EndPlayReason);
@@ -203,43 +132,46 @@ void UOrionStructureComponent::TickComponent(const float DeltaTime, const ELevel
 
 void UOrionStructureComponent::SocketsRegistryHandler() const
 {
-	const FVector StructureLocation = StructureMesh->GetComponentLocation();
-	const FRotator StructureRotation = StructureMesh->GetComponentRotation();
-
-	switch (OrionStructureType)
+	const TArray<FOrionSocketTemplateEntry>& SocketTemplate = GetSocketTemplate(OrionStructureType);
+	if (SocketTemplate.Num() == 0)
 	{
-	case EOrionStructure::BasicSquareFoundation: RegisterSquareFoundationSockets(StructureLocation, StructureRotation);
-		break;
-	case EOrionStructure::BasicRoof: RegisterSquareFoundationSockets(StructureLocation, StructureRotation);
-		break;
-	case EOrionStructure::BasicTriangleFoundation: RegisterTriangleFoundationSockets(
-		StructureLocation, StructureRotation);
-		break;
-	case EOrionStructure::Wall: RegisterWallSockets(StructureLocation, StructureRotation);
-		break;
-	case EOrionStructure::DoubleWall: RegisterDoubleWallSockets(StructureLocation, StructureRotation);
-		break;
-	case EOrionStructure::InclinedRoof: RegisterInclinedRoofSockets(StructureLocation, StructureRotation);
-		break;
-	default:
-		{
-			UE_LOG(LogTemp, Warning, TEXT("OrionStructureComponent::SocketsRegistryHandler: Unsupported structure type for socket registration."));
-			break;
-		}
+		UE_LOG(LogTemp, Warning, TEXT("OrionStructureComponent::SocketsRegistryHandler: Unsupported structure type for socket registration."));
+		return;
 	}
+
+	// Sockets are laid out relative to the structure mesh (location + rotation only)
+	const FTransform StructureTransform(StructureMesh->GetComponentRotation(), StructureMesh->GetComponentLocation());
+	BuildingManager->RegisterSocketTemplate(SocketTemplate, StructureTransform, GetOwner());
+}
+
+const TArray<FOrionSocketTemplateEntry>& UOrionStructureComponent::GetSocketTemplate(const EOrionStructure Type)
+{
+	// Built once per type on first use; every instance of the type only transforms these entries
+	static const TArray<FOrionSocketTemplateEntry> Templates[FOrionSocketRegistry::NumKinds] = {
+		{},
+		BuildSquareFoundationSocketTemplate(),
+		BuildTriangleFoundationSocketTemplate(),
+		BuildWallSocketTemplate(),
+		BuildDoubleWallSocketTemplate(),
+		BuildSquareFoundationSocketTemplate(), // BasicRoof shares the square layout
+		BuildInclinedRoofSocketTemplate(),
+	};
+
+	const int32 Index = static_cast<int32>(Type);
+	static const TArray<FOrionSocketTemplateEntry> Empty;
+	return Index >= 0 && Index < FOrionSocketRegistry::NumKinds ? Templates[Index] : Empty;
 }
 
-void UOrionStructureComponent::RegisterSquareFoundationSockets(const FVector& StructureLocation,
-                                                               const FRotator& StructureRotation) const
+TArray<FOrionSocketTemplateEntry> UOrionStructureComponent::BuildSquareFoundationSocketTemplate()
 {
 	const FVector SquareFoundationBound = GetStructureBounds(EOrionStructure::BasicSquareFoundation);
 	const FVector WallBound = GetStructureBounds(EOrionStructure::Wall);
 
-	BuildingManager->RegisterSocket(StructureLocation, StructureRotation, EOrionStructure::BasicSquareFoundation,
-	                                true, GetWorld(), GetOwner());
+	TArray<FOrionSocketTemplateEntry> Out;
+	Out.Emplace(FVector::ZeroVector, 0.f, EOrionStructure::BasicSquareFoundation, /*bOccupied=*/true);
 
 	/* SquareFoundation -> SquareFoundation */
-	static const FVector SquareFoundation2SquareFoundationLocationOffset[4] = {
+	const FVector SquareFoundation2SquareFoundationLocationOffset[4] = {
 		{SquareFoundationBound.X * 2, 0.f, 0.f},
 		{0.f, -SquareFoundationBound.Y * 2, 0.f},
 		{-SquareFoundationBound.X * 2, 0.f, 0.f},
@@ -247,82 +179,57 @@ void UOrionStructureComponent::RegisterSquareFoundationSockets(const FVector& St
 	};
 	for (const FVector& Offset : SquareFoundation2SquareFoundationLocationOffset)
 	{
-		BuildingManager->RegisterSocket(StructureLocation + StructureRotation.RotateVector(Offset), StructureRotation,
-		                                EOrionStructure::BasicSquareFoundation, false, GetWorld(), GetOwner());
+		Out.Emplace(Offset, 0.f, EOrionStructure::BasicSquareFoundation);
 	}
 
 	/* SquareFoundation -> TriangleFoundation */
+	const FVector SquareFoundation2TriFoundationLocationOffset[4] = {
+		{SquareFoundationBound.X + SquareFoundationBound.X * (1 / FMath::Sqrt(3.f)), 0.f, 0.f},
+		{-SquareFoundationBound.X - SquareFoundationBound.X * (1 / FMath::Sqrt(3.f)), 0.f, 0.f},
+		{0.f, SquareFoundationBound.Y + SquareFoundationBound.Y * (1 / FMath::Sqrt(3.f)), 0.f},
+		{0.f, -SquareFoundationBound.Y - SquareFoundationBound.Y * (1 / FMath::Sqrt(3.f)), 0.f}
+	};
+	constexpr float SquareFoundation2TriFoundationRotationOffset[4] = {180.f, 0.f, 270.f, 90.f};
+	for (int32 i = 0; i < 4; ++i)
 	{
-		static const FVector SquareFoundation2TriFoundationLocationOffset[4] = {
-			{SquareFoundationBound.X + SquareFoundationBound.X * (1 / FMath::Sqrt(3.f)), 0.f, 0.f},
-			{-SquareFoundationBound.X - SquareFoundationBound.X * (1 / FMath::Sqrt(3.f)), 0.f, 0.f},
-			{0.f, SquareFoundationBound.Y + SquareFoundationBound.Y * (1 / FMath::Sqrt(3.f)), 0.f},
-			{0.f, -SquareFoundationBound.Y - SquareFoundationBound.Y * (1 / FMath::Sqrt(3.f)), 0.f}
-		};
-		static constexpr float SquareFoundation2TriFoundationRotationOffset[4] = {180.f, 0.f, 270.f, 90.f};
-
-		for (int32 i = 0; i < 4; ++i)
-		{
-			BuildingManager->RegisterSocket(
-				StructureLocation + StructureRotation.RotateVector(SquareFoundation2TriFoundationLocationOffset[i]),
-				StructureRotation + FRotator(0.f, SquareFoundation2TriFoundationRotationOffset[i], 0.f),
-				EOrionStructure::BasicTriangleFoundation,
-				/*bOccupied=*/false, GetWorld(), GetOwner());
-		}
+		Out.Emplace(SquareFoundation2TriFoundationLocationOffset[i], SquareFoundation2TriFoundationRotationOffset[i],
+		            EOrionStructure::BasicTriangleFoundation);
 	}
 
 	/* SquareFoundation -> Wall */
-	static const FVector SquareFoundation2WallLocationOffset[4] = {
+	const FVector SquareFoundation2WallLocationOffset[4] = {
 		{SquareFoundationBound.X, 0.f, SquareFoundationBound.Z + WallBound.Z},
 		{0.f, SquareFoundationBound.Y, SquareFoundationBound.Z + WallBound.Z},
 		{-SquareFoundationBound.X, 0.f, SquareFoundationBound.Z + WallBound.Z},
 		{0.f, -SquareFoundationBound.Y, SquareFoundationBound.Z + WallBound.Z}
 	};
-	static const FRotator SquareFoundation2WallRotationOffset[4] = {
-		{0, 0, 0},
-		{0, 90, 0},
-		{0, 180, 0},
-		{0, 270, 0}
-	};
-	static const FVector SquareFoundation2WallScaleOffset[4] = {
-		{1.0f, 1.0f, 1.0f},
-		{1.0f, 1.0f, 1.0f},
-		{1.0f, 1.0f, 1.0f},
-		{1.0f, 1.0f, 1.0f},
-
-	};
+	constexpr float SquareFoundation2WallRotationOffset[4] = {0.f, 90.f, 180.f, 270.f};
 	for (int32 i = 0; i < 4; ++i)
 	{
-		BuildingManager->RegisterSocket(
-			StructureLocation + StructureRotation.RotateVector(SquareFoundation2WallLocationOffset[i]),
-			StructureRotation + SquareFoundation2WallRotationOffset[i],
-			EOrionStructure::Wall, false, GetWorld(), GetOwner(), SquareFoundation2WallScaleOffset[i]);
+		Out.Emplace(SquareFoundation2WallLocationOffset[i], SquareFoundation2WallRotationOffset[i], EOrionStructure::Wall);
 	}
+
+	return Out;
 }
 
-void UOrionStructureComponent::RegisterInclinedRoofSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const
+TArray<FOrionSocketTemplateEntry> UOrionStructureComponent::BuildInclinedRoofSocketTemplate()
 {
-	/*const FVector InclinedRoofBound = GetStructureBounds(EOrionStructure::InclinedRoof);
-	const FVector SquareBound = GetStructureBounds(EOrionStructure::BasicSquareFoundation);
-	const FVector WallBound = GetStructureBounds(EOrionStructure::Wall);*/
-
-	BuildingManager->RegisterSocket(StructureLocation, StructureRotation, EOrionStructure::InclinedRoof,
-		true, GetWorld(), GetOwner());
+	TArray<FOrionSocketTemplateEntry> Out;
+	Out.Emplace(FVector::ZeroVector, 0.f, EOrionStructure::InclinedRoof, /*bOccupied=*/true);
 
 	/* InclinedRoof -> Wall */
+
+	return Out;
 }
 
-void UOrionStructureComponent::RegisterTriangleFoundationSockets(const FVector& StructureLocation,
-                                                                 const FRotator& StructureRotation) const
+TArray<FOrionSocketTemplateEntry> UOrionStructureComponent::BuildTriangleFoundationSocketTemplate()
 {
 	const float TriEdgeLength = 2.f * GetStructureBounds(EOrionStructure::BasicTriangleFoundation).Y;
 	const FVector TriFoundationBound = GetStructureBounds(EOrionStructure::BasicTriangleFoundation);
 	const FVector WallBound = GetStructureBounds(EOrionStructure::Wall);
 
-	BuildingManager->RegisterSocket(
-		StructureLocation, StructureRotation,
-		EOrionStructure::BasicTriangleFoundation,
-		/*bOccupied=*/true, GetWorld(), GetOwner());
+	TArray<FOrionSocketTemplateEntry> Out;
+	Out.Emplace(FVector::ZeroVector, 0.f, EOrionStructure::BasicTriangleFoundation, /*bOccupied=*/true);
 
 	/* TriangleFoundation -> TriangleFoundation */
 	const FVector TriFoundation2TriFoundationLocationOffset[3] = {
@@ -330,19 +237,9 @@ void UOrionStructureComponent::RegisterTriangleFoundationSockets(const FVector&
 		{-TriEdgeLength / (2.f * FMath::Sqrt(3.0f)), TriEdgeLength * 0.5f, 0.f},
 		{-TriEdgeLength / (2.f * FMath::Sqrt(3.0f)), -TriEdgeLength * 0.5f, 0.f}
 	};
-
 	for (int32 i = 0; i < 3; ++i)
 	{
-		constexpr float TriFoundation2TriFoundationRotationOffset[3] = {180.f, 180.f, 180.f};
-		const FVector EachTF2TFLocationOffset = StructureLocation + StructureRotation.RotateVector(
-			TriFoundation2TriFoundationLocationOffset[i]);
-
-
-		BuildingManager->RegisterSocket(
-			EachTF2TFLocationOffset,
-			StructureRotation + FRotator(0.f, TriFoundation2TriFoundationRotationOffset[i], 0.f),
-			EOrionStructure::BasicTriangleFoundation,
-			/*bOccupied=*/false, GetWorld(), GetOwner());
+		Out.Emplace(TriFoundation2TriFoundationLocationOffset[i], 180.f, EOrionStructure::BasicTriangleFoundation);
 	}
 
 	/* TriangleFoundation -> SquareFoundation */
@@ -352,164 +249,98 @@ void UOrionStructureComponent::RegisterTriangleFoundationSockets(const FVector&
 			-(0.25f + FMath::Sqrt(3.0f) / 12.f) * TriEdgeLength,
 			-(0.25f + FMath::Sqrt(3.0f) / 4.f) * TriEdgeLength, 0.f
 		},
-
 		{
 			-(0.25f + FMath::Sqrt(3.0f) / 12.f) * TriEdgeLength,
 			(0.25f + FMath::Sqrt(3.0f) / 4.f) * TriEdgeLength, 0.f
 		},
-
 	};
-
+	constexpr float TriFoundation2SquareFoundationRotationOffset[3] = {0.f, 60.f, 120.f};
 	for (int32 i = 0; i < 3; ++i)
 	{
-		const FVector EachTF2SFLocationOffset = StructureLocation + StructureRotation.RotateVector(
-			TriFoundation2SquareFoundationLocationOffset[i]);
-
-		constexpr float TriFoundation2SquareFoundationRotationOffset[3] = {0.f, 60.f, 120.f};
-		BuildingManager->RegisterSocket(
-			EachTF2SFLocationOffset,
-			StructureRotation + FRotator(0.f, TriFoundation2SquareFoundationRotationOffset[i], 0.f),
-			EOrionStructure::BasicSquareFoundation,
-			/*bOccupied=*/false, GetWorld(), GetOwner());
+		Out.Emplace(TriFoundation2SquareFoundationLocationOffset[i], TriFoundation2SquareFoundationRotationOffset[i],
+		            EOrionStructure::BasicSquareFoundation);
 	}
 
+	/* TriangleFoundation -> Wall */
 	const FVector TriangleEdgeMidpoints[3] = {
 		{TriEdgeLength * (1.f / (4.f * (FMath::Sqrt(3.0f) / 2.f))), 0.f, 0.f},
 		{-1.f / (4.f * FMath::Sqrt(3.0f)) * TriEdgeLength, 0.25f * TriEdgeLength, 0.f},
 		{-1.f / (4.f * FMath::Sqrt(3.0f)) * TriEdgeLength, -0.25f * TriEdgeLength, 0.f},
-
 	};
-
-	/* TriangleFoundation -> Wall */
+	constexpr float TriFoundation2WallRotationOffset[3] = {180.f, 300.f, 60.f};
 	for (int32 i = 0; i < 3; ++i)
 	{
-		const FVector TriFoundation2WallLocationOffset =
-			StructureLocation + StructureRotation.RotateVector(
-				TriangleEdgeMidpoints[i] + FVector(0.f, 0.f, TriFoundationBound.Z + WallBound.Z));
-		constexpr float TriFoundation2WallRotationOffset[3] = {180.f, 300.f, 60.f};
-
-		BuildingManager->RegisterSocket(
-			TriFoundation2WallLocationOffset,
-			StructureRotation + FRotator(0.f, TriFoundation2WallRotationOffset[i], 0.f),
-			EOrionStructure::Wall,
-			/*bOccupied=*/false, GetWorld(), GetOwner());
+		Out.Emplace(TriangleEdgeMidpoints[i] + FVector(0.f, 0.f, TriFoundationBound.Z + WallBound.Z),
+		            TriFoundation2WallRotationOffset[i], EOrionStructure::Wall);
 	}
+
+	return Out;
 }
 
-void UOrionStructureComponent::RegisterWallSockets(const FVector& StructureLocation,
-                                                   const FRotator& StructureRotation) const
+TArray<FOrionSocketTemplateEntry> UOrionStructureComponent::BuildWallSocketTemplate()
 {
 	const FVector WallBound = GetStructureBounds(EOrionStructure::Wall);
-	const FVector TriangleFoundationBound = GetStructureBounds(EOrionStructure::BasicTriangleFoundation);
 	const float TriEdgeLength = 2.f * GetStructureBounds(EOrionStructure::BasicTriangleFoundation).Y;
-
 	const FVector InclinedRoofBound = GetStructureBounds(EOrionStructure::InclinedRoof);
 
-	BuildingManager->RegisterSocket(StructureLocation, StructureRotation, EOrionStructure::Wall,
-	                                true, GetWorld(), GetOwner());
+	TArray<FOrionSocketTemplateEntry> Out;
+	Out.Emplace(FVector::ZeroVector, 0.f, EOrionStructure::Wall, /*bOccupied=*/true);
 
 	/* Wall -> Wall */
-	const FVector Wall2WallLocationOffset = StructureLocation + FVector(0.f, 0.f, WallBound.Z * 2.f);
-
-	BuildingManager->RegisterSocket(Wall2WallLocationOffset, StructureRotation, EOrionStructure::Wall,
-	                                false, GetWorld(), GetOwner());
+	Out.Emplace(FVector(0.f, 0.f, WallBound.Z * 2.f), 0.f, EOrionStructure::Wall);
 
 	/* Wall -> Floor (SquareFoundation) */
-	const FTransform ParentTM(StructureRotation, StructureLocation);
-
 	const FVector FrontLocal(-WallBound.Y, 0.f, WallBound.Z);
 	const FVector RearLocal(WallBound.Y, 0.f, WallBound.Z);
-
-	const FVector FrontWorld = ParentTM.TransformPositionNoScale(FrontLocal);
-	const FVector RearWorld = ParentTM.TransformPositionNoScale(RearLocal);
-
-	BuildingManager->RegisterSocket(
-		FrontWorld, StructureRotation,
-		EOrionStructure::BasicSquareFoundation,
-		false, GetWorld(), GetOwner());
-
-	BuildingManager->RegisterSocket(
-		RearWorld, StructureRotation,
-		EOrionStructure::BasicSquareFoundation,
-		false, GetWorld(), GetOwner());
+	Out.Emplace(FrontLocal, 0.f, EOrionStructure::BasicSquareFoundation);
+	Out.Emplace(RearLocal, 0.f, EOrionStructure::BasicSquareFoundation);
 
 	/* Wall -> InclinedRoof */
-	BuildingManager->RegisterSocket(
-		FrontWorld + FVector(0.f, 0.f, 0.5f * InclinedRoofBound.Y), StructureRotation + FRotator(0.f,  -90.f, 0.f),
-		EOrionStructure::InclinedRoof,
-		false, GetWorld(), GetOwner());
-
-	BuildingManager->RegisterSocket(
-		RearWorld + FVector(0.f, 0.f, 0.5f * InclinedRoofBound.Y), StructureRotation + FRotator(0.f, 90.f, 0.f),
-		EOrionStructure::InclinedRoof,
-		false, GetWorld(), GetOwner());
+	const FVector RoofLift(0.f, 0.f, 0.5f * InclinedRoofBound.Y);
+	Out.Emplace(FrontLocal + RoofLift, -90.f, EOrionStructure::InclinedRoof);
+	Out.Emplace(RearLocal + RoofLift, 90.f, EOrionStructure::InclinedRoof);
 
 	/* Wall -> TriangleFloor (TriangleFoundation) */
 	const FVector FrontLocalTri(TriEdgeLength / (2.0 * FMath::Sqrt(3.f)), 0.f, WallBound.Z);
 	const FVector RearLocalTri(-TriEdgeLength / (2.0 * FMath::Sqrt(3.f)), 0.f, WallBound.Z);
+	Out.Emplace(FrontLocalTri, 180.f, EOrionStructure::BasicTriangleFoundation);
+	Out.Emplace(RearLocalTri, 0.f, EOrionStructure::BasicTriangleFoundation);
 
-	const FVector FrontWorldTri = ParentTM.TransformPositionNoScale(FrontLocalTri);
-	const FVector RearWorldTri = ParentTM.TransformPositionNoScale(RearLocalTri);
-
-	BuildingManager->RegisterSocket(
-		FrontWorldTri, StructureRotation + FRotator(0.f, 180.f, 0.f),
-		EOrionStructure::BasicTriangleFoundation,
-		false, GetWorld(), GetOwner());
-
-	BuildingManager->RegisterSocket(
-		RearWorldTri, StructureRotation,
-		EOrionStructure::BasicTriangleFoundation,
-		false, GetWorld(), GetOwner());
+	return Out;
 }
 
-
-void UOrionStructureComponent::RegisterDoubleWallSockets(const FVector& StructureLocation,
-                                                         const FRotator& StructureRotation) const
+TArray<FOrionSocketTemplateEntry> UOrionStructureComponent::BuildDoubleWallSocketTemplate()
 {
-	{
-		const FVector DoubleWallBound = GetStructureBounds(EOrionStructure::DoubleWall);
-		const FVector SquareFoundationBound = GetStructureBounds(EOrionStructure::BasicSquareFoundation);
-
-		/* DoubleWall -> Wall */
-		const FVector DoubleWall2WallLocationOffset[2] = {
-			StructureLocation + FVector(0.f, 0.f, DoubleWallBound.Z * 2.f),
-			StructureLocation + FVector(0.f, DoubleWallBound.Y, DoubleWallBound.Z * 2.f)
-		};
+	const FVector DoubleWallBound = GetStructureBounds(EOrionStructure::DoubleWall);
+	const FVector SquareFoundationBound = GetStructureBounds(EOrionStructure::BasicSquareFoundation);
 
-		for (int32 i = 0; i < 2; ++i)
-		{
-			BuildingManager->RegisterSocket(
-				DoubleWall2WallLocationOffset[i],
-				StructureRotation,
-				EOrionStructure::Wall,
-				false,
-				GetWorld(),
-				GetOwner()
-			);
-		}
+	// DoubleWall offsets have always been applied along world axes (not rotated with the structure)
+	TArray<FOrionSocketTemplateEntry> Out;
 
-		/* DoubleWall -> SquareRoof (SquareFoundation) */
-		const FVector DoubleWall2SquareFoundationOffset[4] = {
-			StructureLocation + FVector(SquareFoundationBound.X, 0.f, DoubleWallBound.Z),
-			StructureLocation + FVector(-SquareFoundationBound.X, 0.f, DoubleWallBound.Z),
-			StructureLocation + FVector(SquareFoundationBound.X, DoubleWallBound.Y, DoubleWallBound.Z),
-			StructureLocation + FVector(-SquareFoundationBound.X, DoubleWallBound.Y, DoubleWallBound.Z),
-		};
+	/* DoubleWall -> Wall */
+	const FVector DoubleWall2WallLocationOffset[2] = {
+		FVector(0.f, 0.f, DoubleWallBound.Z * 2.f),
+		FVector(0.f, DoubleWallBound.Y, DoubleWallBound.Z * 2.f)
+	};
+	for (const FVector& Offset : DoubleWall2WallLocationOffset)
+	{
+		Out.Emplace(Offset, 0.f, EOrionStructure::Wall, false, /*bRotateOffset=*/false);
+	}
 
-		for (int32 i = 0; i < 4; ++i)
-		{
-			BuildingManager->RegisterSocket(
-				DoubleWall2SquareFoundationOffset[i],
-				StructureRotation,
-				EOrionStructure::BasicSquareFoundation,
-				false,
-				GetWorld(),
-				GetOwner()
-			);
-		}
+	/* DoubleWall -> SquareRoof (SquareFoundation) */
+	const FVector DoubleWall2SquareFoundationOffset[4] = {
+		FVector(SquareFoundationBound.X, 0.f, DoubleWallBound.Z),
+		FVector(-SquareFoundationBound.X, 0.f, DoubleWallBound.Z),
+		FVector(SquareFoundationBound.X, DoubleWallBound.Y, DoubleWallBound.Z),
+		FVector(-SquareFoundationBound.X, DoubleWallBound.Y, DoubleWallBound.Z),
+	};
+	for (const FVector& Offset : DoubleWall2SquareFoundationOffset)
+	{
+		Out.Emplace(Offset, 0.f, EOrionStructure::BasicSquareFoundation, false, /*bRotateOffset=*/false);
 	}
-}
 
+	return Out;
+}
 
 
 FVector UOrionStructureComponent::GetStructureBounds(const EOrionStructure Type)
@@ -524,21 +355,25 @@ FVector UOrionStructureComponent::GetStructureBounds(const EOrionStructure Type)
 
 bool UOrionStructureComponent::CheckIsTouchingGround() const
 {
-	AActor* Owner = GetOwner();
+	const AActor* Owner = GetOwner();
 	if (!Owner) return false;
 
-	FVector Start = Owner->GetActorLocation();
+	return IsGroundedAt(GetWorld(), Owner->GetActorLocation(), Owner);
+}
+
+bool UOrionStructureComponent::IsGroundedAt(const UWorld* World, const FVector& Location, const AActor* IgnoredActor)
+{
+	if (!World) return false;
+
+	FVector Start = Location;
 	// 向下探测：长度根据地基厚度调整，通常 100cm 足够穿透到地面
 	FVector End = Start - FVector(0.f, 0.f, 100.f);
 
 	FHitResult Hit;
 	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Owner); // 忽略自己
+	Params.AddIgnoredActor(IgnoredActor); // 忽略自己（放置预览时是预览 Actor）
 	Params.bTraceComplex = false;
 
-	UWorld* World = GetWorld();
-	if (!World) return false;
-
 	// 使用 WorldStatic 通道进行检测（地形通常是 WorldStatic）
 	bool bHit = World->LineTraceSingleByChannel(
 		Hit,
@@ -556,9 +391,20 @@ bool UOrionStructureComponent::CheckIsTouchingGround() const
 			return false;
 		}
 
+		// 实例化的建筑（HISM）同理
+		if (UOrionBuildingRenderManager::IsStructureInstanceComponent(Hit.GetComponent()))
+		{
+			return false;
+		}
+
 		// 撞到了非建筑物体（通常是 Landscape） -> 是锚点
 		return true;
 	}
 
 	return false; // 悬空 -> 不是锚点
 }
+
+float UOrionStructureComponent::GetDefaultStabilityDecay(const EOrionStructure Type)
+{
+	return (Type == EOrionStructure::Wall || Type == EOrionStructure::DoubleWall) ? 0.1f : 0.25f;
+}
@@ -31,11 +31,8 @@ public:
 
 
 
-	void RegisterSquareFoundationSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const;
-	void RegisterTriangleFoundationSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const;
-	void RegisterWallSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const;
-	void RegisterDoubleWallSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const;
-	void RegisterInclinedRoofSockets(const FVector& StructureLocation, const FRotator& StructureRotation) const;
+	/* Per-type socket layout relative to the structure mesh, built once and shared by every instance */
+	static const TArray<FOrionSocketTemplateEntry>& GetSocketTemplate(const EOrionStructure Type);
 
 	/* Orion Structure Rule Type */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config (Non-null)")
@@ -63,12 +60,25 @@ public:
 	UPROPERTY()
 	float StabilityDecay = 0.1f;
 
-	// [Rust System] Core calculation function
+	// [Rust System] (Re)link into the connectivity graph and destroy self if unsupported
+	// Stability itself is solved by UOrionBuildingManager on FOrionStructureGraph
 	void UpdateStability();
 
 	void SocketsRegistryHandler() const;
 
+	// [Rust System] Decay used for a type (also used by the placement preview before anything is spawned)
+	static float GetDefaultStabilityDecay(const EOrionStructure Type);
+
+	// [Rust System] Ground anchor test at an arbitrary location (IgnoredActor: self / preview actor)
+	static bool IsGroundedAt(const UWorld* World, const FVector& Location, const AActor* IgnoredActor);
+
 private:
+	static TArray<FOrionSocketTemplateEntry> BuildSquareFoundationSocketTemplate();
+	static TArray<FOrionSocketTemplateEntry> BuildTriangleFoundationSocketTemplate();
+	static TArray<FOrionSocketTemplateEntry> BuildWallSocketTemplate();
+	static TArray<FOrionSocketTemplateEntry> BuildDoubleWallSocketTemplate();
+	static TArray<FOrionSocketTemplateEntry> BuildInclinedRoofSocketTemplate();
+
 	// Helper: Ground check
 	bool CheckIsTouchingGround() const;
 	
@@ -6,8 +6,8 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "EngineUtils.h"
 #include "Orion/OrionActor/OrionActor.h"
-#include "Serialization/BufferArchive.h"
-#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionSaveGame/OrionSaveNameTable.h"
 #include "OrionActorManager.generated.h"
 
 /**
@@ -19,7 +19,7 @@ class ORION_API UOrionActorManager : public UGameInstanceSubsystem
 	GENERATED_BODY()
 
 public:
-	void CollectActorRecords(TArray<FOrionActorFullRecord>& Out) const
+	void CollectActorRecords(TArray<FOrionActorFullRecord>& Out, FOrionSaveNameTableBuilder& Names) const
 	{
 		Out.Empty();
 		UWorld* World = GetWorld();
@@ -28,27 +28,44 @@ public:
 			return;
 		}
 
+		/* ① 游戏线程：收集对象和普通字段 */
+		TArray<UObject*> Objects;
 		for (TActorIterator<AOrionActor> It(World); It; ++It)
 		{
-			AOrionActor* Act = *It;
+			Out.Add(GatherActorRecord(*It));
+			Objects.Add(*It);
+		}
 
-			/* ① 创建内存 Writer，并声明 SaveGame 语义 */
-			FBufferArchive MemWriter;
-			FObjectAndNameAsStringProxyArchive Ar(MemWriter, /*bLoadIn=*/false);
-			Ar.ArIsSaveGame = true;
+		/* ② SaveGame 属性先在游戏线程快照，名字表索引在工作线程上并行编码，按记录顺序合并 */
+		TArray<TArray<uint8>> Bytes;
+		FOrionNameTableArchive::WriteObjects(Objects, Names, Bytes);
+		for (int32 i = 0; i < Out.Num(); ++i)
+		{
+			Out[i].SerializedBytes = MoveTemp(Bytes[i]);
+			Out[i].bUsesNameTable = true;
+		}
+	}
 
-			/* ② 把整个 Actor 写进字节流 */
-			Act->Serialize(Ar);
+	/* 单个 Actor 的存档记录（增量存档也用） */
+	static FOrionActorFullRecord MakeActorRecord(AOrionActor* Act, FOrionSaveNameTableBuilder& Names)
+	{
+		FOrionActorFullRecord R = GatherActorRecord(Act);
 
-			/* ③ 生成记录条 */
-			FOrionActorFullRecord R;
-			R.ActorGameId = Act->GetSerializable().GameId;
-			R.ActorTransform = Act->GetActorTransform();
-			R.ClassPath = Act->GetClass()->GetPathName();
-			R.SerializedBytes = MemWriter;
+		/* SaveGame 属性写进字节流，名字 / 引用进存档的共享名字表 */
+		FOrionNameTableArchive::WriteObject(*Act, Names, R.SerializedBytes);
+		R.bUsesNameTable = true;
 
-			Out.Add(MoveTemp(R));
-		}
+		return R;
+	}
+
+	/* 记录里除 SerializedBytes 以外的字段 */
+	static FOrionActorFullRecord GatherActorRecord(const AOrionActor* Act)
+	{
+		FOrionActorFullRecord R;
+		R.ActorGameId = Act->GetSerializable().GameId;
+		R.ActorTransform = Act->GetActorTransform();
+		R.ClassPath = Act->GetClass()->GetPathName();
+		return R;
 	}
 
 	/* ② 清空当前世界中的所有 OrionActor */
@@ -60,32 +77,122 @@ public:
 		}
 	}
 
+	/* 差量读档：GameId 对得上的 Actor 原地写回，存档里没有的销毁，只 Spawn 新增的 */
 	void LoadAllActors(UWorld* World,
-	                   const TArray<FOrionActorFullRecord>& Saved)
+	                   const TArray<FOrionActorFullRecord>& Saved,
+	                   const FOrionSaveNameTable& Names,
+	                   const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
 	{
 		if (!World)
 		{
 			return;
 		}
 
-		RemoveAllActors(World);
-		GlobalActorMap.Empty();
+		TMap<FGuid, AOrionActor*> Reusable;
+		TArray<AOrionActor*> Stale;
+		MatchLiveActors(World, Saved, Reusable, Stale);
+
+		for (AOrionActor* A : Stale)
+		{
+			A->Destroy();
+		}
+		// Every reused actor stays resolvable while the records are applied
+		RetainActors(Reusable);
+
+		int32 NumSpawned = 0;
+		for (const FOrionActorFullRecord& Rec : Saved)
+		{
+			if (AOrionActor** Existing = Reusable.Find(Rec.ActorGameId))
+			{
+				ApplyActorRecord(*Existing, Rec, Names, ResolveGameId);
+			}
+			else if (SpawnAndRegisterActor(World, Rec, Names, ResolveGameId))
+			{
+				++NumSpawned;
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("[Load] Actors: %d reused, %d spawned, %d destroyed."),
+		       Reusable.Num(), NumSpawned, Stale.Num());
+	}
 
+	/*
+	 * 差量读档的匹配：GameId 和类都对得上存档记录的 Actor 进 OutReusable，其余的（存档里没有 / 类变了）进 OutStale。
+	 * 关卡里摆放、没注册过的 Actor 也按 GameId 参与匹配
+	 */
+	static void MatchLiveActors(const UWorld* World,
+	                            const TArray<FOrionActorFullRecord>& Saved,
+	                            TMap<FGuid, AOrionActor*>& OutReusable,
+	                            TArray<AOrionActor*>& OutStale)
+	{
+		TMap<FGuid, const FOrionActorFullRecord*> SavedById;
+		SavedById.Reserve(Saved.Num());
 		for (const FOrionActorFullRecord& Rec : Saved)
 		{
-			if (AOrionActor* A = SpawnAndRegisterActor(World, Rec))
+			SavedById.Add(Rec.ActorGameId, &Rec);
+		}
+
+		for (TActorIterator<AOrionActor> It(World); It; ++It)
+		{
+			const FGuid GameId = It->GetSerializable().GameId;
+			const FOrionActorFullRecord* const* Rec = SavedById.Find(GameId);
+			if (Rec && !OutReusable.Contains(GameId) && It->GetClass()->GetPathName() == (*Rec)->ClassPath)
 			{
-				UE_LOG(LogTemp, Log, TEXT("Spawned %s"), *A->GetName());
+				OutReusable.Add(GameId, *It);
 			}
+			else
+			{
+				OutStale.Add(*It);
+			}
+		}
+	}
+
+	/* 存档记录写回已存在的 Actor：不销毁、不重新 Spawn，组件也不会重新向各 Manager 注册 */
+	void ApplyActorRecord(AOrionActor* A,
+	                      const FOrionActorFullRecord& Rec,
+	                      const FOrionSaveNameTable& Names,
+	                      const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
+	{
+		if (!A->GetActorTransform().Equals(Rec.ActorTransform))
+		{
+			A->SetActorTransform(Rec.ActorTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		FOrionNameTableArchive::ResetSaveGameProperties(*A);
+		FOrionNameTableArchive::ReadObject(*A, Rec.SerializedBytes, Rec.bUsesNameTable, Names, ResolveGameId);
+
+		A->ActorSerializable.GameId = Rec.ActorGameId;
+		GlobalActorMap.Add(Rec.ActorGameId, A);
+	}
+
+	/* 读档前清空注册表（Actor 本身由调用方销毁） */
+	void ResetActorMap() { GlobalActorMap.Empty(); }
+
+	/*
+	 * 差量读档：注册表只留下原地复用的 Actor，并且在应用任何记录之前全部登记（关卡里摆放、没注册过的也算），
+	 * 记录里引用后面记录的 Actor 时 ResolveGameId 也能解析
+	 */
+	template <typename TActorPtr>
+	void RetainActors(const TMap<FGuid, TActorPtr>& Reused)
+	{
+		GlobalActorMap.Reset();
+		for (const TPair<FGuid, TActorPtr>& Pair : Reused)
+		{
+			GlobalActorMap.Add(Pair.Key, Pair.Value);
 		}
 	}
 
 	/* ④ 根据记录 Spawn + 注册 */
 	AOrionActor* SpawnAndRegisterActor(
 		UWorld* World,
-		const FOrionActorFullRecord& Rec)
+		const FOrionActorFullRecord& Rec,
+		const FOrionSaveNameTable& Names,
+		const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
 	{
-		UClass* ActorClass = LoadClass<AOrionActor>(nullptr, *Rec.ClassPath);
+		const UOrionAssetPreloadManager* PreloadManager = GetGameInstance()->GetSubsystem<UOrionAssetPreloadManager>();
+		UClass* ActorClass = PreloadManager
+			                     ? PreloadManager->FindOrLoadClass<AOrionActor>(Rec.ClassPath).Get()
+			                     : LoadClass<AOrionActor>(nullptr, *Rec.ClassPath);
 		if (!ActorClass) { return nullptr; }
 
 		FActorSpawnParameters P;
@@ -95,10 +202,7 @@ public:
 		if (!A) { return nullptr; }
 
 		/* 反序列化字节流覆盖默认值 */
-		FMemoryReader MemReader(Rec.SerializedBytes);
-		FObjectAndNameAsStringProxyArchive Ar(MemReader, /*bLoadIn=*/true);
-		Ar.ArIsSaveGame = true;
-		A->Serialize(Ar);
+		FOrionNameTableArchive::ReadObject(*A, Rec.SerializedBytes, Rec.bUsesNameTable, Names, ResolveGameId);
 
 		/* 写回 Guid 并注册 */
 		A->ActorSerializable.GameId = Rec.ActorGameId;
@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionGameInstance/OrionItemManager.h"
+#include "Engine/AssetManager.h"
+
+void UOrionAssetPreloadManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 建筑 / 物品数据要先从 DataTable 读好
+	Collection.InitializeDependency<UOrionBuildingManager>();
+	Collection.InitializeDependency<UOrionItemManager>();
+
+	TArray<FSoftObjectPath> Paths;
+	CollectStartupPaths(Paths);
+
+	const double StartTime = FPlatformTime::Seconds();
+	StartupHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		Paths, FStreamableDelegate::CreateWeakLambda(this, [this, StartTime, NumPaths = Paths.Num()]()
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Preload] %d assets loaded in %.1f ms"), NumPaths,
+			       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+			OnStartupPreloaded();
+		}));
+
+	if (!StartupHandle.IsValid())
+	{
+		// Nothing to load
+		OnStartupPreloaded();
+	}
+
+#if !UE_BUILD_SHIPPING
+	SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(
+		this, &UOrionAssetPreloadManager::OnSyncLoadPackage);
+#endif
+}
+
+void UOrionAssetPreloadManager::Deinitialize()
+{
+#if !UE_BUILD_SHIPPING
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+#endif
+
+	if (StartupHandle.IsValid())
+	{
+		StartupHandle->CancelHandle();
+		StartupHandle.Reset();
+	}
+	for (const TSharedPtr<FStreamableHandle>& Handle : ExtraHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	ExtraHandles.Empty();
+	PendingCallbacks.Empty();
+
+	Super::Deinitialize();
+}
+
+UOrionAssetPreloadManager* UOrionAssetPreloadManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UOrionAssetPreloadManager>() : nullptr;
+}
+
+void UOrionAssetPreloadManager::CollectStartupPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	auto AddPath = [&OutPaths](const FSoftObjectPath& Path)
+	{
+		if (Path.IsValid())
+		{
+			OutPaths.AddUnique(Path);
+		}
+	};
+
+	if (const UOrionBuildingManager* BuildingManager = GetGameInstance()->GetSubsystem<UOrionBuildingManager>())
+	{
+		for (const auto& Each : BuildingManager->GetOrionDataBuildingsMap())
+		{
+			AddPath(FSoftObjectPath(Each.Value.BuildingBlueprintReference));
+			AddPath(FSoftObjectPath(Each.Value.BuildingImageReference));
+		}
+	}
+
+	// 物品图标由 ItemManager 自己异步加载，这里一起持有保证常驻
+	if (const UOrionItemManager* ItemManager = GetGameInstance()->GetSubsystem<UOrionItemManager>())
+	{
+		for (const FOrionDataItem& Item : ItemManager->GetAllItemInfos())
+		{
+			AddPath(Item.Icon.ToSoftObjectPath());
+		}
+	}
+
+	AddPath(FSoftObjectPath(CharacterBlueprintPath));
+	AddPath(FSoftObjectPath(ResourceFloatWidgetPath));
+}
+
+void UOrionAssetPreloadManager::OnStartupPreloaded()
+{
+	bPreloadComplete = true;
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+float UOrionAssetPreloadManager::GetPreloadProgress() const
+{
+	if (bPreloadComplete)
+	{
+		return 1.f;
+	}
+	return StartupHandle.IsValid() ? StartupHandle->GetProgress() : 0.f;
+}
+
+void UOrionAssetPreloadManager::CallWhenPreloaded(FSimpleDelegate Callback)
+{
+	if (bPreloadComplete)
+	{
+		Callback.ExecuteIfBound();
+		return;
+	}
+	PendingCallbacks.Add(MoveTemp(Callback));
+}
+
+void UOrionAssetPreloadManager::RequestPreload(TArray<FSoftObjectPath> Paths, FSimpleDelegate OnLoaded)
+{
+	Paths.RemoveAll([](const FSoftObjectPath& Path) { return !Path.IsValid() || Path.ResolveObject() != nullptr; });
+
+	if (Paths.Num() == 0)
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths), FStreamableDelegate::CreateLambda([OnLoaded]()
+		{
+			OnLoaded.ExecuteIfBound();
+		}));
+
+	if (Handle.IsValid())
+	{
+		ExtraHandles.Add(MoveTemp(Handle));
+	}
+	else
+	{
+		OnLoaded.ExecuteIfBound();
+	}
+}
+
+UObject* UOrionAssetPreloadManager::FindOrLoad(const FSoftObjectPath& Path) const
+{
+	if (!Path.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (UObject* Resident = Path.ResolveObject())
+	{
+		return Resident;
+	}
+
+	// Not preloaded: blocking load (OnSyncLoadPackage reports it during gameplay)
+	return Path.TryLoad();
+}
+
+#if !UE_BUILD_SHIPPING
+void UOrionAssetPreloadManager::OnSyncLoadPackage(const FString& PackageName) const
+{
+	if (!IsInGameThread() || !bPreloadComplete || LoadingPhaseDepth > 0)
+	{
+		return;
+	}
+
+	const UGameInstance* GameInstance = GetGameInstance();
+	const UWorld* World = GameInstance ? GameInstance->GetWorld() : nullptr;
+	if (!World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("[Preload] Synchronous load of %s during gameplay"), *PackageName);
+	ensureMsgf(false, TEXT("Synchronous load of %s on the game thread during gameplay, add it to the preload set"),
+	           *PackageName);
+}
+#endif
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "OrionAssetPreloadManager.generated.h"
+
+/**
+ * Asynchronous asset preloading.
+ * 启动时从 DataTable 收集所有软引用（建筑蓝图 / 建筑图标 / 物品图标 + 固定的角色、UI 类），通过 FStreamableManager
+ * 异步加载并常驻内存；各处原来的 LoadClass / LoadObject 改为查询这里。
+ *
+ * Anything not in the preload set falls back to a synchronous load. In non-shipping builds such a load on the
+ * game thread during gameplay (world has begun play, outside a loading phase) raises an ensure, so the missing
+ * reference can be added to the set.
+ */
+UCLASS()
+class ORION_API UOrionAssetPreloadManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr const TCHAR* CharacterBlueprintPath = TEXT("/Game/_Orion/Blueprints/OrionCharacter.OrionCharacter_C");
+	static constexpr const TCHAR* ResourceFloatWidgetPath =
+		TEXT("/Game/_Orion/UI/UI_ResourceFloat/WB_ResourceFloat.WB_ResourceFloat_C");
+
+	virtual void Initialize(FSubsystemCollectionBase&) override;
+	virtual void Deinitialize() override;
+
+	/** Startup preload state, for a loading screen */
+	bool IsPreloadComplete() const { return bPreloadComplete; }
+	float GetPreloadProgress() const;
+
+	/** Runs Callback once the startup preload is done (right away if it already is) */
+	void CallWhenPreloaded(FSimpleDelegate Callback);
+
+	/** Loads Paths asynchronously and keeps them resident (e.g. classes referenced by a save before loading it) */
+	void RequestPreload(TArray<FSoftObjectPath> Paths, FSimpleDelegate OnLoaded);
+
+	/** Resident object, nullptr if it is not loaded (never loads) */
+	static UObject* FindResident(const FSoftObjectPath& Path) { return Path.ResolveObject(); }
+
+	/** Resident object, synchronous load if it was not preloaded (flagged during gameplay) */
+	UObject* FindOrLoad(const FSoftObjectPath& Path) const;
+
+	template <typename T>
+	TSubclassOf<T> FindOrLoadClass(const FString& Path) const
+	{
+		return Cast<UClass>(FindOrLoad(FSoftObjectPath(Path)));
+	}
+
+	template <typename T>
+	T* FindOrLoadObject(const FString& Path) const
+	{
+		return Cast<T>(FindOrLoad(FSoftObjectPath(Path)));
+	}
+
+	/** Synchronous loads between Begin/End are expected (e.g. loading a save) and not flagged */
+	void BeginLoadingPhase() { ++LoadingPhaseDepth; }
+	void EndLoadingPhase() { LoadingPhaseDepth = FMath::Max(0, LoadingPhaseDepth - 1); }
+
+	/** Convenience accessor from any object living in a game world */
+	static UOrionAssetPreloadManager* Get(const UObject* WorldContextObject);
+
+private:
+	void CollectStartupPaths(TArray<FSoftObjectPath>& OutPaths) const;
+	void OnStartupPreloaded();
+
+	// Handles are never released: everything loaded through them stays resident
+	TSharedPtr<FStreamableHandle> StartupHandle;
+	TArray<TSharedPtr<FStreamableHandle>> ExtraHandles;
+
+	TArray<FSimpleDelegate> PendingCallbacks;
+	bool bPreloadComplete = false;
+	int32 LoadingPhaseDepth = 0;
+
+#if !UE_BUILD_SHIPPING
+	FDelegateHandle SyncLoadHandle;
+	void OnSyncLoadPackage(const FString& PackageName) const;
+#endif
+};
@@ -0,0 +1,590 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
+#include "Orion/OrionGameInstance/OrionGameInstance.h"
+#include "Orion/OrionGameInstance/OrionActorManager.h"
+#include "Orion/OrionGameInstance/OrionCharaManager.h"
+#include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
+#include "Orion/OrionSaveGame/OrionSaveContainer.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	constexpr uint32 DeltaChunkMagic = 0x4453524F; // "ORSD"
+
+	// Removals first: an id removed and re-added within one chunk ends up added
+	template <typename T, typename FKeyFunc>
+	void ApplyRecords(TArray<T>& Base, TArray<T>& Changed, const TSet<FGuid>* Removed, FKeyFunc GetKey)
+	{
+		if (Removed)
+		{
+			Base.RemoveAll([Removed, &GetKey](const T& Record) { return Removed->Contains(GetKey(Record)); });
+		}
+
+		if (Changed.Num() == 0)
+		{
+			return;
+		}
+
+		TMap<FGuid, int32> IndexByKey;
+		IndexByKey.Reserve(Base.Num());
+		for (int32 i = 0; i < Base.Num(); ++i)
+		{
+			IndexByKey.Add(GetKey(Base[i]), i);
+		}
+
+		for (T& Record : Changed)
+		{
+			const FGuid Key = GetKey(Record);
+			if (const int32* Index = IndexByKey.Find(Key))
+			{
+				Base[*Index] = MoveTemp(Record);
+			}
+			else
+			{
+				IndexByKey.Add(Key, Base.Add(MoveTemp(Record)));
+			}
+		}
+	}
+
+	void AddRemoved(UOrionSaveGame& Delta, const EOrionSaveSection Section, const FGuid& Key)
+	{
+		FOrionSaveRemovedRecord& Removed = Delta.RemovedRecords.AddDefaulted_GetRef();
+		Removed.Section = static_cast<uint32>(Section);
+		Removed.Key = Key;
+	}
+
+	void ResetRecords(UOrionSaveGame& SaveObj)
+	{
+		SaveObj.SavedCharacters.Reset();
+		SaveObj.SavedActors.Reset();
+		SaveObj.SavedStructures.Reset();
+		SaveObj.SavedInventories.Reset();
+		SaveObj.RemovedRecords.Reset();
+		SaveObj.NameTable.Reset();
+	}
+}
+
+void UOrionAutosaveManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (AutosaveInterval > 0.f)
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UOrionAutosaveManager::OnAutosaveTick), AutosaveInterval);
+	}
+}
+
+void UOrionAutosaveManager::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Let the last writes land on disk
+	FilePipe.WaitUntilEmpty();
+
+	Super::Deinitialize();
+}
+
+UOrionAutosaveManager* UOrionAutosaveManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UOrionAutosaveManager>() : nullptr;
+}
+
+FString UOrionAutosaveManager::GetBasePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("Autosave.sav");
+}
+
+FString UOrionAutosaveManager::GetDeltaPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("Autosave.delta");
+}
+
+FGuid UOrionAutosaveManager::GetStructureKey(const uint32 StructureId)
+{
+	return FGuid(0, 0, 0, StructureId);
+}
+
+FGuid UOrionAutosaveManager::GetStructureKey(const FOrionStructureRecord& Record)
+{
+	// Records of older saves have no id: a key of their own, never matched by a removal or a newer record
+	return Record.StructureId != 0 ? GetStructureKey(Record.StructureId) : FGuid::NewGuid();
+}
+
+void UOrionAutosaveManager::MarkDirty(AActor* Object)
+{
+	const IOrionInterfaceSerializable* Serializable = Cast<IOrionInterfaceSerializable>(Object);
+	if (!Serializable)
+	{
+		return;
+	}
+
+	const FGuid GameId = Serializable->GetSerializable().GameId;
+	if (GameId.IsValid())
+	{
+		RemovedIds.Remove(GameId);
+		DirtyObjects.Add(GameId, Object);
+	}
+}
+
+void UOrionAutosaveManager::MarkRemoved(const FGuid& GameId)
+{
+	if (GameId.IsValid())
+	{
+		DirtyObjects.Remove(GameId);
+		RemovedIds.Add(GameId);
+	}
+}
+
+void UOrionAutosaveManager::MarkStructureAdded(const int32 NodeId)
+{
+	AddedStructureNodes.Add(NodeId);
+}
+
+void UOrionAutosaveManager::MarkStructureRemoved(const int32 NodeId, const uint32 StructureId)
+{
+	// Added and removed between two autosaves: never saved, nothing to remove
+	if (AddedStructureNodes.Remove(NodeId) == 0 && StructureId != 0)
+	{
+		RemovedStructureIds.Add(StructureId);
+	}
+}
+
+bool UOrionAutosaveManager::OnAutosaveTick(float /*DeltaTime*/)
+{
+	const UWorld* World = GetGameInstance()->GetWorld();
+	if (World && World->HasBegunPlay())
+	{
+		Autosave();
+	}
+	return true;
+}
+
+void UOrionAutosaveManager::Autosave()
+{
+	// A world being loaded is half old, half new
+	if (const UOrionWorldLoadManager* WorldLoadManager = GetGameInstance()->GetSubsystem<UOrionWorldLoadManager>();
+		WorldLoadManager && WorldLoadManager->IsLoading())
+	{
+		return;
+	}
+
+	if (bHasBase)
+	{
+		SaveDelta();
+	}
+	else
+	{
+		SaveBase();
+	}
+}
+
+void UOrionAutosaveManager::SaveBase()
+{
+	const UOrionGameInstance* GameInstance = Cast<UOrionGameInstance>(GetGameInstance());
+	if (!GameInstance)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	UOrionSaveGame* Snapshot = NewObject<UOrionSaveGame>();
+	Names.Reset();
+	GameInstance->CollectAllRecords(Snapshot, Names);
+
+	/* Reference state the following deltas are computed against */
+	DirtyObjects.Reset();
+	RemovedIds.Reset();
+
+	SavedCharaTransforms.Reset();
+	if (const UOrionCharaManager* CharaManager = GameInstance->GetSubsystem<UOrionCharaManager>())
+	{
+		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : CharaManager->GetAllCharas())
+		{
+			if (const AOrionChara* Chara = Pair.Value.Get())
+			{
+				SavedCharaTransforms.Add(Pair.Key, Chara->GetActorTransform());
+			}
+		}
+	}
+
+	AddedStructureNodes.Reset();
+	RemovedStructureIds.Reset();
+
+	bHasBase = true;
+	NumDeltaChunks = 0;
+	DeltaBytes = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("[Autosave] Base snapshot took %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	FilePipe.Launch(TEXT("OrionAutosaveBase"),
+	                [WeakThis = TWeakObjectPtr<UOrionAutosaveManager>(this),
+		                Snapshot = TStrongObjectPtr<UOrionSaveGame>(Snapshot)]() mutable
+	                {
+		                TArray<uint8> RawBytes;
+		                FOrionSaveContainer::Write(*Snapshot, RawBytes);
+
+		                TArray<uint8> FileBytes;
+		                const bool bSuccess = FOrionSaveContainer::Compress(RawBytes, FileBytes) &&
+			                FOrionSaveContainer::WriteFileAtomically(GetBasePath(), FileBytes);
+
+		                // Deltas of the previous base are obsolete
+		                if (bSuccess)
+		                {
+			                IFileManager::Get().Delete(*GetDeltaPath(), false, true, true);
+		                }
+
+		                AsyncTask(ENamedThreads::GameThread,
+		                          [WeakThis, Snapshot = MoveTemp(Snapshot), bSuccess, RawSize = RawBytes.Num()]() mutable
+		                          {
+			                          Snapshot.Reset();
+			                          if (UOrionAutosaveManager* Manager = WeakThis.Get())
+			                          {
+				                          Manager->BaseBytes = RawSize;
+				                          if (!bSuccess)
+				                          {
+					                          UE_LOG(LogTemp, Error, TEXT("[Autosave] Failed to write the base"));
+					                          Manager->bHasBase = false;
+				                          }
+			                          }
+		                          });
+	                });
+}
+
+bool UOrionAutosaveManager::CollectDelta(UOrionSaveGame& Delta)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	/* ① Characters walk around all the time: compare with the transform of the last autosave */
+	if (const UOrionCharaManager* CharaManager = GameInstance->GetSubsystem<UOrionCharaManager>())
+	{
+		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : CharaManager->GetAllCharas())
+		{
+			AOrionChara* Chara = Pair.Value.Get();
+			if (!Chara)
+			{
+				continue;
+			}
+
+			const FTransform* Saved = SavedCharaTransforms.Find(Pair.Key);
+			if (!Saved || !Saved->Equals(Chara->GetActorTransform(), 1.0))
+			{
+				DirtyObjects.Add(Pair.Key, Chara);
+			}
+		}
+	}
+
+	/* ② Dirty objects: their records are rebuilt, destroyed ones become removals */
+	for (const TPair<FGuid, TWeakObjectPtr<AActor>>& Pair : DirtyObjects)
+	{
+		AActor* Object = Pair.Value.Get();
+		if (!IsValid(Object))
+		{
+			RemovedIds.Add(Pair.Key);
+			continue;
+		}
+
+		if (AOrionChara* Chara = Cast<AOrionChara>(Object))
+		{
+			Delta.SavedCharacters.Add(UOrionCharaManager::MakeCharaRecord(Chara, Names));
+			SavedCharaTransforms.Add(Pair.Key, Chara->GetActorTransform());
+		}
+		else if (AOrionActor* Actor = Cast<AOrionActor>(Object))
+		{
+			Delta.SavedActors.Add(UOrionActorManager::MakeActorRecord(Actor, Names));
+		}
+
+		FOrionInventorySerializable InventoryRecord;
+		if (UOrionInventoryManager::MakeInventoryRecord(Object, InventoryRecord))
+		{
+			Delta.SavedInventories.Add(MoveTemp(InventoryRecord));
+		}
+	}
+	DirtyObjects.Reset();
+
+	// Only the names this chunk added, after the ones of the base and the previous chunks
+	Names.TakeNewEntries(Delta.NameTable);
+
+	for (const FGuid& GameId : RemovedIds)
+	{
+		SavedCharaTransforms.Remove(GameId);
+		for (const EOrionSaveSection Section :
+		     {EOrionSaveSection::Characters, EOrionSaveSection::Actors, EOrionSaveSection::Inventories})
+		{
+			AddRemoved(Delta, Section, GameId);
+		}
+	}
+	RemovedIds.Reset();
+
+	/* ③ Structures never change in place: only the pieces placed / destroyed since, keyed by their StructureId */
+	if (const UOrionBuildingManager* BuildingManager = GameInstance->GetSubsystem<UOrionBuildingManager>())
+	{
+		BuildingManager->CollectStructureRecordsOfNodes(AddedStructureNodes.Array(), Delta.SavedStructures);
+	}
+	for (const uint32 StructureId : RemovedStructureIds)
+	{
+		AddRemoved(Delta, EOrionSaveSection::Structures, GetStructureKey(StructureId));
+	}
+	AddedStructureNodes.Reset();
+	RemovedStructureIds.Reset();
+
+	return Delta.SavedCharacters.Num() > 0 || Delta.SavedActors.Num() > 0 || Delta.SavedStructures.Num() > 0 ||
+		Delta.SavedInventories.Num() > 0 || Delta.RemovedRecords.Num() > 0;
+}
+
+void UOrionAutosaveManager::SaveDelta()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	UOrionSaveGame* Delta = NewObject<UOrionSaveGame>();
+	if (!CollectDelta(*Delta))
+	{
+		return;
+	}
+
+	// A delta is small: encoded right here, the worker only compresses and appends
+	TArray<uint8> RawBytes;
+	FOrionSaveContainer::Write(*Delta, RawBytes);
+
+	++NumDeltaChunks;
+	DeltaBytes += RawBytes.Num();
+
+	UE_LOG(LogTemp, Log,
+	       TEXT("[Autosave] Delta %d: %d characters, %d actors, %d structures, %d inventories, %d removed (%d bytes) in %.2f ms"),
+	       NumDeltaChunks, Delta->SavedCharacters.Num(), Delta->SavedActors.Num(), Delta->SavedStructures.Num(),
+	       Delta->SavedInventories.Num(), Delta->RemovedRecords.Num(), RawBytes.Num(),
+	       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	FilePipe.Launch(TEXT("OrionAutosaveDelta"),
+	                [WeakThis = TWeakObjectPtr<UOrionAutosaveManager>(this), RawBytes = MoveTemp(RawBytes)]()
+	{
+		// The following chunks refer to the names of this one: a lost chunk means a new base
+		auto OnFailed = [WeakThis]()
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+			{
+				if (UOrionAutosaveManager* Manager = WeakThis.Get())
+				{
+					Manager->bHasBase = false;
+				}
+			});
+		};
+
+		TArray<uint8> Payload;
+		if (!FOrionSaveContainer::Compress(RawBytes, Payload))
+		{
+			OnFailed();
+			return;
+		}
+
+		const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetDeltaPath(), FILEWRITE_Append));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Autosave] Cannot open %s"), *GetDeltaPath());
+			OnFailed();
+			return;
+		}
+
+		// Chunk frame: a torn write at the end of the file is detected and ignored when replaying
+		uint32 Magic = DeltaChunkMagic;
+		int32 Size = Payload.Num();
+		uint32 Checksum = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+		*Writer << Magic << Size << Checksum;
+		Writer->Serialize(Payload.GetData(), Payload.Num());
+		Writer->Close();
+	});
+
+	if (!bCompacting && (NumDeltaChunks >= MaxDeltaChunks || (BaseBytes > 0 && DeltaBytes > BaseBytes * CompactionRatio)))
+	{
+		StartCompaction();
+	}
+}
+
+void UOrionAutosaveManager::StartCompaction()
+{
+	bCompacting = true;
+
+	// Deltas queued from now on run after the compaction on the pipe, into a fresh delta file
+	NumDeltaChunks = 0;
+	DeltaBytes = 0;
+
+	FilePipe.Launch(TEXT("OrionAutosaveCompact"),
+	                [WeakThis = TWeakObjectPtr<UOrionAutosaveManager>(this),
+		                Base = TStrongObjectPtr<UOrionSaveGame>(NewObject<UOrionSaveGame>()),
+		                Scratch = TStrongObjectPtr<UOrionSaveGame>(NewObject<UOrionSaveGame>())]() mutable
+	                {
+		                const double StartTime = FPlatformTime::Seconds();
+
+		                bool bSuccess = FOrionSaveContainer::ReadFile(GetBasePath(), *Base);
+		                const int32 NumChunks = bSuccess ? ReplayDeltaFile(GetDeltaPath(), *Base, *Scratch) : 0;
+
+		                TArray<uint8> RawBytes;
+		                if (bSuccess)
+		                {
+			                FOrionSaveContainer::Write(*Base, RawBytes);
+
+			                TArray<uint8> FileBytes;
+			                bSuccess = FOrionSaveContainer::Compress(RawBytes, FileBytes) &&
+				                FOrionSaveContainer::WriteFileAtomically(GetBasePath(), FileBytes);
+		                }
+
+		                // Replay is idempotent: dying before this delete only replays the merged chunks once more
+		                if (bSuccess)
+		                {
+			                IFileManager::Get().Delete(*GetDeltaPath(), false, true, true);
+		                }
+
+		                const double WorkerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		                AsyncTask(ENamedThreads::GameThread,
+		                          [WeakThis, Base = MoveTemp(Base), Scratch = MoveTemp(Scratch), bSuccess, NumChunks,
+			                          RawSize = RawBytes.Num(), WorkerMs]() mutable
+		                          {
+			                          Base.Reset();
+			                          Scratch.Reset();
+
+			                          UOrionAutosaveManager* Manager = WeakThis.Get();
+			                          if (!Manager)
+			                          {
+				                          return;
+			                          }
+
+			                          Manager->bCompacting = false;
+			                          if (bSuccess)
+			                          {
+				                          Manager->BaseBytes = RawSize;
+				                          UE_LOG(LogTemp, Log, TEXT("[Autosave] Compacted %d deltas in %.1f ms"),
+				                                 NumChunks, WorkerMs);
+			                          }
+			                          else
+			                          {
+				                          UE_LOG(LogTemp, Error, TEXT("[Autosave] Compaction failed, deltas kept"));
+			                          }
+		                          });
+	                });
+}
+
+bool UOrionAutosaveManager::ApplyDelta(UOrionSaveGame& Base, UOrionSaveGame& Delta)
+{
+	if (!Base.NameTable.Append(Delta.NameTable))
+	{
+		return false;
+	}
+
+	TMap<uint32, TSet<FGuid>> RemovedBySection;
+	for (const FOrionSaveRemovedRecord& Removed : Delta.RemovedRecords)
+	{
+		RemovedBySection.FindOrAdd(Removed.Section).Add(Removed.Key);
+	}
+
+	auto FindRemoved = [&RemovedBySection](const EOrionSaveSection Section)
+	{
+		return RemovedBySection.Find(static_cast<uint32>(Section));
+	};
+
+	ApplyRecords(Base.SavedCharacters, Delta.SavedCharacters, FindRemoved(EOrionSaveSection::Characters),
+	             [](const FOrionCharaSerializable& Record) { return Record.CharaGameId; });
+	ApplyRecords(Base.SavedActors, Delta.SavedActors, FindRemoved(EOrionSaveSection::Actors),
+	             [](const FOrionActorFullRecord& Record) { return Record.ActorGameId; });
+	ApplyRecords(Base.SavedInventories, Delta.SavedInventories, FindRemoved(EOrionSaveSection::Inventories),
+	             [](const FOrionInventorySerializable& Record) { return Record.OwnerGameId; });
+	ApplyRecords(Base.SavedStructures, Delta.SavedStructures, FindRemoved(EOrionSaveSection::Structures),
+	             [](const FOrionStructureRecord& Record) { return GetStructureKey(Record); });
+	return true;
+}
+
+int32 UOrionAutosaveManager::ReplayDeltaFile(const FString& DeltaPath, UOrionSaveGame& Base, UOrionSaveGame& Scratch)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *DeltaPath, FILEREAD_Silent))
+	{
+		return 0;
+	}
+
+	constexpr int64 FrameSize = 2 * sizeof(uint32) + sizeof(int32);
+
+	FMemoryReaderView Reader(FileData);
+	int32 NumChunks = 0;
+
+	while (Reader.Tell() + FrameSize <= Reader.TotalSize())
+	{
+		uint32 Magic = 0;
+		int32 Size = 0;
+		uint32 Checksum = 0;
+		Reader << Magic << Size << Checksum;
+
+		if (Magic != DeltaChunkMagic || Size < 0 || Reader.Tell() + Size > Reader.TotalSize())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Autosave] Delta chunk %d is truncated, replay stops there"), NumChunks);
+			break;
+		}
+
+		const TConstArrayView<uint8> Payload(FileData.GetData() + Reader.Tell(), Size);
+		Reader.Seek(Reader.Tell() + Size);
+
+		TArray<uint8> RawBytes;
+		ResetRecords(Scratch);
+		if (FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Checksum ||
+			!FOrionSaveContainer::Decompress(Payload, RawBytes) ||
+			!FOrionSaveContainer::Read(RawBytes, Scratch))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Autosave] Delta chunk %d is corrupt, replay stops there"), NumChunks);
+			break;
+		}
+
+		if (!ApplyDelta(Base, Scratch))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Autosave] Delta chunk %d does not follow the base, replay stops there"),
+			       NumChunks);
+			break;
+		}
+		++NumChunks;
+	}
+
+	return NumChunks;
+}
+
+UOrionSaveGame* UOrionAutosaveManager::ReadAutosave()
+{
+	// Pending writes / compaction first
+	FilePipe.WaitUntilEmpty();
+
+	UOrionSaveGame* Base = NewObject<UOrionSaveGame>();
+	if (!FOrionSaveContainer::ReadFile(GetBasePath(), *Base))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Autosave] No autosave at %s"), *GetBasePath());
+		return nullptr;
+	}
+
+	UOrionSaveGame* Scratch = NewObject<UOrionSaveGame>();
+	const int32 NumChunks = ReplayDeltaFile(GetDeltaPath(), *Base, *Scratch);
+
+	UE_LOG(LogTemp, Log, TEXT("[Autosave] Read base + %d deltas"), NumChunks);
+	return Base;
+}
+
+bool UOrionAutosaveManager::LoadAutosave()
+{
+	UOrionGameInstance* GameInstance = Cast<UOrionGameInstance>(GetGameInstance());
+	UOrionSaveGame* LoadObj = GameInstance ? ReadAutosave() : nullptr;
+	if (!LoadObj)
+	{
+		return false;
+	}
+
+	GameInstance->RestoreFromSave(LoadObj);
+	return true;
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Pipe.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "OrionAutosaveManager.generated.h"
+
+/**
+ * Incremental autosave: one full snapshot (base) plus append-only delta chunks.
+ *
+ * Serializable objects mark themselves dirty when they are spawned or a saved field changes (inventory, status,
+ * workers, production progress, procedural action queue), and removed when they are destroyed; characters are
+ * compared against their last saved transform. The building manager reports the structures it adds and removes,
+ * keyed by their StructureId. A delta chunk carries the changed / added records and the keys of the removed ones,
+ * so an autosave costs in proportion to what changed, not to the world size.
+ *
+ * Every file operation (base write, delta append, compaction) runs on one background pipe, in order. Once the
+ * deltas grow past CompactionRatio of the base (or MaxDeltaChunks), they are merged into a new base in the
+ * background. Loading replays base + deltas; replay is idempotent, so a crash between writing the compacted base
+ * and dropping the deltas is harmless.
+ */
+UCLASS()
+class ORION_API UOrionAutosaveManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase&) override;
+	virtual void Deinitialize() override;
+
+	static UOrionAutosaveManager* Get(const UObject* WorldContextObject);
+
+	float AutosaveInterval = 60.f; // Seconds, 0 disables the timer
+	int32 MaxDeltaChunks = 32;
+	float CompactionRatio = 0.5f; // Deltas / base size that triggers a compaction
+
+	/* Dirty tracking */
+	void MarkDirty(AActor* Object);
+	void MarkRemoved(const FGuid& GameId);
+	void MarkStructureAdded(int32 NodeId);
+	void MarkStructureRemoved(int32 NodeId, uint32 StructureId);
+
+	/* Base when none was written for the current world yet, delta otherwise */
+	UFUNCTION(BlueprintCallable)
+	void Autosave();
+
+	/* Full snapshot, the deltas are dropped */
+	void SaveBase();
+
+	/* Changed / added / removed records since the last autosave, appended to the delta file */
+	void SaveDelta();
+
+	/* Base replayed with every delta chunk, nullptr if there is no autosave */
+	UOrionSaveGame* ReadAutosave();
+
+	UFUNCTION(BlueprintCallable)
+	bool LoadAutosave();
+
+	/* The world was replaced (save loaded): the next autosave writes a new base */
+	void InvalidateBase() { bHasBase = false; }
+
+	/*
+	 * Applies one delta chunk to Base (any thread, objects must not be used elsewhere meanwhile). False if the name
+	 * table of the chunk does not continue the one of Base
+	 */
+	static bool ApplyDelta(UOrionSaveGame& Base, UOrionSaveGame& Delta);
+
+	static FGuid GetStructureKey(uint32 StructureId);
+	static FGuid GetStructureKey(const FOrionStructureRecord& Record);
+
+private:
+	bool OnAutosaveTick(float DeltaTime);
+
+	/* Returns false if nothing changed */
+	bool CollectDelta(UOrionSaveGame& Delta);
+
+	void StartCompaction();
+
+	static FString GetBasePath();
+	static FString GetDeltaPath();
+
+	/* Decodes the delta chunks of a delta file into Base (any thread) */
+	static int32 ReplayDeltaFile(const FString& DeltaPath, UOrionSaveGame& Base, UOrionSaveGame& Scratch);
+
+	// Objects changed since the last autosave, keyed by GameId
+	TMap<FGuid, TWeakObjectPtr<AActor>> DirtyObjects;
+	TSet<FGuid> RemovedIds;
+
+	// State of the last autosave, to find what changed
+	TMap<FGuid, FTransform> SavedCharaTransforms;
+
+	// Structure graph nodes placed since the last autosave, and StructureIds of the saved ones destroyed since
+	TSet<int32> AddedStructureNodes;
+	TSet<uint32> RemovedStructureIds;
+
+	// Names of the records of the base and every delta after it (one name table per autosave)
+	FOrionSaveNameTableBuilder Names;
+
+	bool bHasBase = false;
+	int64 BaseBytes = 0;
+	int64 DeltaBytes = 0;
+	int32 NumDeltaChunks = 0;
+	bool bCompacting = false;
+
+	UE::Tasks::FPipe FilePipe{TEXT("OrionAutosave")};
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OrionBuildingLayout.generated.h"
+
+/* One structure of a layout, relative to the layout origin */
+USTRUCT(BlueprintType)
+struct FOrionLayoutPiece
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+	TSoftClassPtr<AActor> BuildingClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+	FTransform RelativeTransform;
+};
+
+/**
+ * Multi-structure layout ("blueprint stamp"): captured from placed structures with
+ * UOrionBuildingManager::CaptureLayout and placed as one unit with UOrionBuildingManager::StampLayout.
+ */
+UCLASS(BlueprintType)
+class ORION_API UOrionBuildingLayout : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+	TArray<FOrionLayoutPiece> Pieces;
+};
@@ -4,12 +4,24 @@
 #include "Orion/OrionGameInstance/OrionBuildingManager.h"
 #include "Orion/OrionGameInstance/OrionGameInstance.h"
 #include "Orion/OrionComponents/OrionStructureComponent.h"
+#include "Orion/OrionGameInstance/OrionBuildingLayout.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
 #include "Engine/OverlapResult.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Engine/DataTable.h"
+#include "Async/Async.h"
+#include "NavigationSystem.h"
+#include "TimerManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 // 硬编码数据（作为后备，当 DataTable 未指定时使用）
 const TArray<FOrionDataBuilding>& UOrionBuildingManager::GetHardcodedBuildings() const
@@ -196,21 +208,129 @@ void UOrionBuildingManager::OnWorldInitializedActors(const FActorsInitializedPar
 	}
 
 	BuildingObjectsPool = MakeUnique<FBuildingObjectsPool>(this);
+
+	// 预览物体的类可能还在异步加载
+	if (UOrionAssetPreloadManager* PreloadManager = GetGameInstance()->GetSubsystem<UOrionAssetPreloadManager>())
+	{
+		PreloadManager->CallWhenPreloaded(FSimpleDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (BuildingObjectsPool && GetWorld())
+			{
+				BuildingObjectsPool->InitPreviewStructures(GetWorld());
+			}
+		}));
+	}
+
+	CollectStaticObstacles(GetWorld());
 }
 
-void UOrionBuildingManager::ResetAllSockets(const UWorld* World)
+void UOrionBuildingManager::CollectStaticObstacles(const UWorld* World)
 {
-	SpatialGrid.Empty();
-	SocketsByKind.Empty();
-	UKismetSystemLibrary::FlushPersistentDebugLines(World);
+	OccupancyGrid.Reset();
+
+	// Huge blockers (landscape, ground planes) would mark everything as "maybe";
+	// placement cores are lifted above the ground anyway, so only props are tracked
+	constexpr float MaxObstacleExtent = 2000.f;
+
+	int32 NumObstacles = 0;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		const AActor* Actor = *It;
+		if (!Actor->GetActorEnableCollision() || Actor->FindComponentByClass<UOrionStructureComponent>())
+		{
+			continue;
+		}
+
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [this, &NumObstacles](const UPrimitiveComponent* Prim)
+		{
+			if (!Prim->IsCollisionEnabled() || Prim->GetCollisionObjectType() != ECC_WorldStatic ||
+				UOrionBuildingRenderManager::IsStructureInstanceComponent(Prim))
+			{
+				return;
+			}
+
+			if (const FBox Bounds = Prim->Bounds.GetBox(); Bounds.GetExtent().GetMax() <= MaxObstacleExtent)
+			{
+				OccupancyGrid.AddObstacle(Bounds);
+				++NumObstacles;
+			}
+		});
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BuildingManager] Occupancy grid: %d static obstacles, %d voxels."),
+	       NumObstacles, OccupancyGrid.NumVoxels());
+}
+
+FOrionPlacementQueryStats& UOrionBuildingManager::GetCurrentQueryStats() const
+{
+	if (CurrentQueryStats.Frame != GFrameCounter)
+	{
+		LastQueryStats = CurrentQueryStats;
+		CurrentQueryStats = FOrionPlacementQueryStats();
+		CurrentQueryStats.Frame = GFrameCounter;
+	}
+	return CurrentQueryStats;
+}
+
+const FOrionPlacementQueryStats& UOrionBuildingManager::GetPlacementQueryStats() const
+{
+	GetCurrentQueryStats();
+	return LastQueryStats;
 }
 
-// Get Grid Key (Simple int32 merge to int64)
-int64 UOrionBuildingManager::GetGridKey(const FVector& Location)
+void UOrionBuildingManager::CountPhysicsQuery(const int32 Num) const
 {
-	const int32 X = FMath::FloorToInt(Location.X / GridCellSize);
-	const int32 Y = FMath::FloorToInt(Location.Y / GridCellSize);
-	return (static_cast<int64>(X) << 32) | static_cast<uint32>(Y); // High 32 bits store X, Low 32 bits store Y
+	GetCurrentQueryStats().PhysicsQueries += Num;
+}
+
+EOrionOccupancy UOrionBuildingManager::CountGridAnswer(const EOrionOccupancy Answer) const
+{
+	FOrionPlacementQueryStats& Stats = GetCurrentQueryStats();
+	switch (Answer)
+	{
+	case EOrionOccupancy::Free: ++Stats.GridFree; break;
+	case EOrionOccupancy::Blocked: ++Stats.GridBlocked; break;
+	case EOrionOccupancy::Maybe: ++Stats.GridMaybe; break;
+	}
+	return Answer;
+}
+
+void UOrionBuildingManager::ResetAllSockets(const UWorld* World)
+{
+	SocketRegistry.Reset();
+	PendingSockets.Reset();
+	StructureGraph.Reset();
+	PendingStabilityRegion.Reset();
+	OccupancyGrid.ResetStructures();
+	StructureBoxes.Reset();
+	RoomDetector.Reset();
+	HydratingNode = INDEX_NONE;
+
+	// A layout still being stamped belonged to the previous state
+	if (IsStampingLayout())
+	{
+		if (World)
+		{
+			World->GetTimerManager().ClearTimer(StampTimerHandle);
+		}
+		StampQueue.Reset();
+		StampSpawned.Reset();
+		StampClasses.Reset();
+	}
+
+	// Instances hold socket ids and graph nodes, both are gone now
+	if (UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>())
+	{
+		RenderManager->ResetInstances();
+	}
+
+	// Structure ids of the autosave base are gone with their nodes
+	if (UOrionAutosaveManager* AutosaveManager = GetGameInstance()->GetSubsystem<UOrionAutosaveManager>())
+	{
+		AutosaveManager->InvalidateBase();
+	}
+
+	UKismetSystemLibrary::FlushPersistentDebugLines(World);
 }
 
 
@@ -275,40 +395,17 @@ bool UOrionBuildingManager::ConfirmPlaceStructure(
 		const FVector ExtentFull = Bounds.BoxExtent;
 		const FVector Center = Bounds.Origin;
 
-		/* -- 3-A. Light tolerance: shrink box by 2 cm -- */
-		constexpr float ToleranceCm = 100.f; // <- Tolerance
-		const FVector ExtentLoose = (ExtentFull - FVector(ToleranceCm))
-			.ComponentMax(FVector(1.f)); // Prevent negative value
-
-		/* -- 3-B. Strict check first, then double check with loose box -- */
-		FCollisionShape ShapeStrict = FCollisionShape::MakeBox(ExtentFull);
-		FCollisionShape ShapeLoose = FCollisionShape::MakeBox(ExtentLoose);
-
-		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PlacementTest), /*TraceComplex=*/false);
-		QueryParams.AddIgnoredActor(PreviewPtr);
-
-		const bool bBlockedStrict = World->OverlapBlockingTestByChannel(
-			Center, TargetTransform.GetRotation(), ECC_WorldStatic, ShapeStrict, QueryParams);
-
-		const bool bBlockedLoose = World->OverlapBlockingTestByChannel(
-			Center, TargetTransform.GetRotation(), ECC_WorldStatic, ShapeLoose, QueryParams);
+		/* -- 3-A..3-E. Strict + loose box test (grid, box set, physics only near obstacles) -- */
+		bBlocked = IsPlacementBlocked(Center, TargetTransform.GetRotation(), ExtentFull, PreviewPtr);
 
-		/* -- 3-C. Only consider blocked if both "Strict" and "Loose" are blocked -- */
-		bBlocked = bBlockedStrict && bBlockedLoose;
-
-		/* -- 3-D. Debug Output -- */
-		UE_LOG(LogTemp, Verbose,
-		       TEXT(
-			       "[Building][Debug] Center=(%.1f,%.1f,%.1f)  ExtentFull=(%.1f,%.1f,%.1f)  BlockedStrict=%d  BlockedLoose=%d"
-		       ),
-		       Center.X, Center.Y, Center.Z,
-		       ExtentFull.X, ExtentFull.Y, ExtentFull.Z,
-		       bBlockedStrict, bBlockedLoose);
-
-		DrawDebugBox(World, Center, ExtentFull,
-		             TargetTransform.GetRotation(),
-		             bBlocked ? FColor::Red : FColor::Green,
-		             /*PersistentLines=*/false, /*LifeTime=*/2.f);
+		/* -- 3-F. Debug Output -- */
+		if (BEnableDebugLine)
+		{
+			DrawDebugBox(World, Center, ExtentFull,
+			             TargetTransform.GetRotation(),
+			             bBlocked ? FColor::Red : FColor::Green,
+			             /*PersistentLines=*/false, /*LifeTime=*/2.f);
+		}
 	}
 
 	if (bBlocked)
@@ -318,6 +415,18 @@ bool UOrionBuildingManager::ConfirmPlaceStructure(
 		return false;
 	}
 
+	/* 3-G. Stability: reject pieces that would collapse right after spawning */
+	const UOrionStructureComponent* PreviewComp = PreviewPtr->FindComponentByClass<UOrionStructureComponent>();
+	if (const FOrionStabilityPreview Preview =
+			PreviewPlacementStability(PreviewComp->OrionStructureType, BPClass, TargetTransform, PreviewPtr);
+		!Preview.IsValidPlacement())
+	{
+		UE_LOG(LogTemp, Warning,
+		       TEXT("[Building] Placement unsupported (stability %.2f) - cannot spawn structure here."),
+		       Preview.Stability);
+		return false;
+	}
+
 	// -----------------------------------------------------------------------
 	// 【Core Change】: Removed PreviewPtr->Destroy() and PreviewPtr = nullptr;
 	// Preview actor is now safe, we don't touch it.
@@ -335,6 +444,66 @@ bool UOrionBuildingManager::ConfirmPlaceStructure(
 }
 
 
+bool UOrionBuildingManager::IsPlacementBlocked(const FVector& Center, const FQuat& Rotation, const FVector& ExtentFull,
+                                               const AActor* IgnoredActor) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return false;
+
+	/* -- 3-A. Light tolerance: shrink box by 2 cm -- */
+	constexpr float ToleranceCm = 100.f; // <- Tolerance
+	const FVector ExtentLoose = (ExtentFull - FVector(ToleranceCm))
+		.ComponentMax(FVector(1.f)); // Prevent negative value
+
+	/* -- 3-B. Occupancy grid first: only rejects early (box core inside a structure) -- */
+	const EOrionOccupancy GridAnswer = CountGridAnswer(OccupancyGrid.QueryPlacement(
+		FOrionOrientedBox(Center, Rotation, ExtentFull), Center));
+
+	bool bBlockedStrict = GridAnswer == EOrionOccupancy::Blocked;
+	bool bBlockedLoose = GridAnswer == EOrionOccupancy::Blocked;
+
+	/* -- 3-C. Structures around: tested analytically (SAT on the box set), strict box first -- */
+	if (GridAnswer == EOrionOccupancy::Maybe)
+	{
+		bBlockedStrict = StructureBoxes.AnyOverlapping(FOrionOrientedBox(Center, Rotation, ExtentFull));
+		bBlockedLoose = bBlockedStrict && StructureBoxes.AnyOverlapping(FOrionOrientedBox(Center, Rotation, ExtentLoose));
+	}
+
+	/* -- 3-D. Physics unless structures already blocked: the grid does not know pawns, dynamic bodies, actors
+	 *         spawned after load or big static meshes -- */
+	if (!(bBlockedStrict && bBlockedLoose))
+	{
+		FCollisionShape ShapeStrict = FCollisionShape::MakeBox(ExtentFull);
+		FCollisionShape ShapeLoose = FCollisionShape::MakeBox(ExtentLoose);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PlacementTest), /*TraceComplex=*/false);
+		QueryParams.AddIgnoredActor(IgnoredActor);
+
+		bBlockedStrict = World->OverlapBlockingTestByChannel(
+			Center, Rotation, ECC_WorldStatic, ShapeStrict, QueryParams);
+		CountPhysicsQuery();
+
+		if (bBlockedStrict)
+		{
+			bBlockedLoose = World->OverlapBlockingTestByChannel(
+				Center, Rotation, ECC_WorldStatic, ShapeLoose, QueryParams);
+			CountPhysicsQuery();
+		}
+	}
+
+	/* -- Debug Output -- */
+	UE_LOG(LogTemp, Verbose,
+	       TEXT(
+		       "[Building][Debug] Center=(%.1f,%.1f,%.1f)  ExtentFull=(%.1f,%.1f,%.1f)  Grid=%d  BlockedStrict=%d  BlockedLoose=%d"
+	       ),
+	       Center.X, Center.Y, Center.Z,
+	       ExtentFull.X, ExtentFull.Y, ExtentFull.Z,
+	       static_cast<int32>(GridAnswer), bBlockedStrict, bBlockedLoose);
+
+	/* -- 3-E. Only consider blocked if both "Strict" and "Loose" are blocked -- */
+	return bBlockedStrict && bBlockedLoose;
+}
+
 bool UOrionBuildingManager::DelaySpawnNewStructure(const TSubclassOf<AActor> BPClass, UWorld* World,
                                                    const FTransform& TargetTransform, bool& DelaySpawnNewStructureRes, bool bSnapped, AActor* ParentActor)
 {
@@ -378,6 +547,14 @@ bool UOrionBuildingManager::DelaySpawnNewStructure(const TSubclassOf<AActor> BPC
 			if (IsValid(NewlySpawnedActor) && StructureComp->CurrentStability > 0.0f)
 			{
 				DelaySpawnNewStructureRes = true; // Placement successful and alive
+
+				// Rendered through the per-class HISM from now on, actor comes back only for interaction
+				if (UOrionBuildingRenderManager* RenderManager =
+						GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+					RenderManager && RenderManager->bInstanceStructures)
+				{
+					RenderManager->InstanceStructure(NewlySpawnedActor);
+				}
 			}
 			else
 			{
@@ -397,283 +574,794 @@ bool UOrionBuildingManager::DelaySpawnNewStructure(const TSubclassOf<AActor> BPC
 }
 
 // Core: Query + Filter
+// Occupied / blocked state is precomputed in the registry, so this is a single scan of the kind partition (no allocation)
 bool UOrionBuildingManager::FindNearestSocket(const FVector& QueryPos, const float SearchRadius, const EOrionStructure Type, FOrionGlobalSocket& OutSocket) const
 {
-	float MinDistSqr = SearchRadius * SearchRadius;
-	constexpr float BlockThresholdSqr = 5.0f * 5.0f; // Blocked if Occupied within 5cm
-	const FOrionGlobalSocket* BestCandidate = nullptr;
-	
-	// 1. Determine query range (3x3 Grid)
-	const int64 CenterKey = GetGridKey(QueryPos);
-	const int32 CenterX = CenterKey >> 32;
-	const int32 CenterY = static_cast<int32>(CenterKey);
-	
-	// List 1: Candidates (Type matches, I can snap to)
-	TArray<const FOrionGlobalSocket*> LocalCandidates;
-	// List 2: Potential blockers (All sockets in area, regardless of type)
-	TArray<const FOrionGlobalSocket*> AllNearbySockets; 
-	
-	for (int32 x = -1; x <= 1; ++x)
+	const int32 SocketId = SocketRegistry.FindNearest(QueryPos, SearchRadius, Type);
+	if (SocketId == INDEX_NONE)
 	{
-		for (int32 y = -1; y <= 1; ++y)
-		{
-			const int64 Key = (static_cast<int64>(CenterX + x) << 32) | static_cast<uint32>(CenterY + y);
-			if (const FOrionSocketBucket* Bucket = SpatialGrid.Find(Key))
-			{
-				for (const FOrionGlobalSocket& S : Bucket->Sockets)
-				{
-					// Collect all sockets for blockage detection
-					AllNearbySockets.Add(&S);
+		return false;
+	}
 
-					// Only collect matching types for snapping
-					if (S.Kind == Type) 
-					{
-						LocalCandidates.Add(&S);
-					}
-				}
-			}
-		}
+	OutSocket = SocketRegistry.GetSocket(SocketId);
+	return true;
+}
+
+void UOrionBuildingManager::RegisterSocket(const FVector& Loc, const FRotator& Rot, const EOrionStructure Kind,
+                                           const bool IsOccupied, const UWorld* World, AActor* Owner, const FVector& Scale)
+{
+	if (!World)
+	{
+		return;
 	}
-	
-	// 2. Iterate candidates, find nearest & unblocked
-	for (const FOrionGlobalSocket* S : LocalCandidates)
+
+	// [Grid] Register directly to grid, no deduplication
+	// Special handling: Wall also registers DoubleWall, SquareFoundation also registers BasicRoof
+	const EOrionStructure AliasKind = GetSocketAliasKind(Kind);
+
+	if (bSocketBatchOpen)
 	{
-		// Distance pre-filter
-		const float DistSqr = FVector::DistSquared(S->Location, QueryPos);
-		if (DistSqr > MinDistSqr) continue;
-		
-		// === The Filter Logic ===
-		// Check if any "Occupied" socket exists near this location (S->Location)?
-		// If so, it means although there is a free socket (from foundation), it's blocked by a wall
-		bool bIsBlocked = false;
-		
-		// If socket itself is Occupied, it definitely can't be used
-		if (S->bOccupied) 
+		PendingSockets.Emplace(Loc, Rot, Kind, IsOccupied, Owner, Scale);
+		if (AliasKind != EOrionStructure::None)
 		{
-			bIsBlocked = true;
+			PendingSockets.Emplace(Loc, Rot, AliasKind, IsOccupied, Owner, Scale);
 		}
-		else 
+		return;
+	}
+
+	SocketRegistry.Register(FOrionGlobalSocket(Loc, Rot, Kind, IsOccupied, Owner, Scale));
+	if (AliasKind != EOrionStructure::None)
+	{
+		SocketRegistry.Register(FOrionGlobalSocket(Loc, Rot, AliasKind, IsOccupied, Owner, Scale));
+	}
+}
+
+void UOrionBuildingManager::RegisterSocketTemplate(const TConstArrayView<FOrionSocketTemplateEntry> SocketTemplate,
+                                                   const FTransform& StructureTransform, AActor* Owner)
+{
+	const FVector StructureLocation = StructureTransform.GetLocation();
+	const FRotator StructureRotation = StructureTransform.Rotator();
+
+	auto Instantiate = [&](auto& OutSockets)
+	{
+		for (const FOrionSocketTemplateEntry& Entry : SocketTemplate)
 		{
-			// [Fix] Look for blockers in AllNearbySockets (Full Set), not just in Candidates
-			for (const FOrionGlobalSocket* Blocker : AllNearbySockets)
+			const FVector Location = Entry.bRotateOffset
+				                         ? StructureLocation + StructureRotation.RotateVector(Entry.Offset)
+				                         : StructureLocation + Entry.Offset;
+			const FRotator Rotation = StructureRotation + Entry.RotationOffset;
+
+			OutSockets.Emplace(Location, Rotation, Entry.Kind, Entry.bOccupied, Owner, Entry.Scale);
+
+			if (const EOrionStructure AliasKind = GetSocketAliasKind(Entry.Kind); AliasKind != EOrionStructure::None)
 			{
-				if (Blocker->bOccupied && 
-					FVector::DistSquared(Blocker->Location, S->Location) < BlockThresholdSqr)
-				{
-					bIsBlocked = true; // Blocker found
-					break;
-				}
+				OutSockets.Emplace(Location, Rotation, AliasKind, Entry.bOccupied, Owner, Entry.Scale);
 			}
 		}
-		
-		// 3. If unblocked and closer, select it
-		// [Safe] Also check if Owner is still valid
-		if (!bIsBlocked && S->Owner.IsValid())
-		{
-			MinDistSqr = DistSqr;
-			BestCandidate = const_cast<FOrionGlobalSocket*>(S); // Cast away const
-		}
-	}
-	
-	if (BestCandidate && BestCandidate->Owner.IsValid())
+	};
+
+	if (bSocketBatchOpen)
 	{
-		OutSocket = *BestCandidate;
-		return true;
+		Instantiate(PendingSockets);
+		return;
 	}
-	return false;
+
+	TArray<FOrionGlobalSocket, TInlineAllocator<32>> LocalSockets;
+	Instantiate(LocalSockets);
+	SocketRegistry.RegisterBatch(LocalSockets);
 }
 
-const TArray<FOrionGlobalSocket>& UOrionBuildingManager::GetSnapSocketsByKind(const EOrionStructure Kind) const
+// Unregister: Owner index lists exactly the sockets belonging to this actor, O(k) removal
+void UOrionBuildingManager::UnregisterSockets(AActor* Owner)
 {
-	if (const TArray<FOrionGlobalSocket>* Bucket = SocketsByKind.Find(Kind))
+	if (bSocketBatchOpen && Owner)
 	{
-		return *Bucket;
+		PendingSockets.RemoveAllSwap([Owner](const FOrionGlobalSocket& S) { return S.Owner.Get() == Owner; });
 	}
-	static const TArray<FOrionGlobalSocket> Empty;
-	return Empty;
+
+	SocketRegistry.UnregisterOwner(Owner);
 }
 
-void UOrionBuildingManager::RegisterSocket(const FVector& Loc, const FRotator& Rot, const EOrionStructure Kind,
-                                           const bool IsOccupied, const UWorld* World, AActor* Owner, const FVector& Scale)
+void UOrionBuildingManager::DetachSockets(const AActor* Owner, AActor* NewOwner, TArray<int32>& OutSocketIds)
 {
-	if (!World)
+	checkf(!bSocketBatchOpen, TEXT("UOrionBuildingManager::DetachSockets: Socket batch is still open."));
+	SocketRegistry.DetachOwner(Owner, NewOwner, OutSocketIds);
+}
+
+void UOrionBuildingManager::UnregisterSocketIds(const TConstArrayView<int32> SocketIds)
+{
+	SocketRegistry.UnregisterIds(SocketIds);
+}
+
+void UOrionBuildingManager::BeginSocketBatch()
+{
+	bSocketBatchOpen = true;
+}
+
+void UOrionBuildingManager::EndSocketBatch()
+{
+	if (!bSocketBatchOpen)
 	{
 		return;
 	}
 
-	// [Grid] Register directly to grid, no deduplication
-	const FOrionGlobalSocket NewSocket(Loc, Rot, Kind, IsOccupied, Owner, Scale);
-	const int64 Key = GetGridKey(Loc);
-	SpatialGrid.FindOrAdd(Key).Sockets.Add(NewSocket);
+	bSocketBatchOpen = false;
+	SocketRegistry.RegisterBatch(PendingSockets);
 
-	// Compatible with old system: Update SocketsByKind simultaneously (Used for GetSnapSocketsByKind)
-	SocketsByKind.FindOrAdd(Kind).Add(NewSocket);
+	UE_LOG(LogTemp, Log, TEXT("[BuildingManager] Socket batch registered %d sockets (total %d)."),
+	       PendingSockets.Num(), SocketRegistry.Num());
+	PendingSockets.Empty();
+}
 
-	// Special handling: Wall also registers DoubleWall, SquareFoundation also registers BasicRoof
-	if (Kind == EOrionStructure::Wall)
+void UOrionBuildingManager::BeginBulkLoad()
+{
+	if (bBulkLoadOpen)
 	{
-		const FOrionGlobalSocket DoubleWallSocket(Loc, Rot, EOrionStructure::DoubleWall, IsOccupied, Owner, Scale);
-		SpatialGrid.FindOrAdd(Key).Sockets.Add(DoubleWallSocket);
-		SocketsByKind.FindOrAdd(EOrionStructure::DoubleWall).Add(DoubleWallSocket);
+		return;
 	}
-	else if (Kind == EOrionStructure::BasicSquareFoundation)
+
+	bBulkLoadOpen = true;
+	BeginSocketBatch();
+
+	// Octree updates of every spawned piece wait for EndBulkLoad, instead of a navmesh rebuild per slice
+	if (UWorld* World = GetWorld())
 	{
-		const FOrionGlobalSocket RoofSocket(Loc, Rot, EOrionStructure::BasicRoof, IsOccupied, Owner, Scale);
-		SpatialGrid.FindOrAdd(Key).Sockets.Add(RoofSocket);
-		SocketsByKind.FindOrAdd(EOrionStructure::BasicRoof).Add(RoofSocket);
+		BulkNavLock.Emplace(World, ENavigationLockReason::Unknown);
 	}
 }
 
-// Unregister: Find grid cell where Actor is located, remove sockets belonging to it
-void UOrionBuildingManager::UnregisterSockets(AActor* Owner)
+void UOrionBuildingManager::AddBulkStructure(UOrionStructureComponent* StructureComp)
 {
-	if (!Owner) return;
-	
-	const UWorld* World = Owner->GetWorld();
-	
-	// [Fix] Deprecate Bounds-based cleanup, use full grid scan to prevent residuals due to Bounds calculation errors
-	// This ensures absolute cleanliness, preventing ghost sockets
-	TArray<int64> KeysToRemove;
+	check(bBulkLoadOpen);
+	BulkStructures.Add(StructureComp);
+}
 
-	for (auto& Elem : SpatialGrid)
+void UOrionBuildingManager::EndBulkLoad()
+{
+	if (!bBulkLoadOpen)
 	{
-		FOrionSocketBucket& Bucket = Elem.Value;
-		
-		int32 RemovedNum = Bucket.Sockets.RemoveAll([Owner](const FOrionGlobalSocket& S) {
-			return S.Owner.Get() == Owner;
-		});
+		return;
+	}
 
-		// If bucket is empty, mark Key for removal
-		if (Bucket.Sockets.Num() == 0)
+	bBulkLoadOpen = false;
+	const double StartTime = FPlatformTime::Seconds();
+
+	/* 1. Sockets: one grid insertion */
+	EndSocketBatch();
+
+	/* 2. Nodes and boxes of every piece first, so the neighbour pass sees all of them */
+	TSet<int32> Region;
+	Region.Reserve(BulkStructures.Num());
+	TArray<TPair<int32, FOrionOrientedBox>> NodeBoxes;
+	NodeBoxes.Reserve(BulkStructures.Num());
+	FBox Bounds(ForceInit);
+	UOrionAutosaveManager* AutosaveManager = GetGameInstance()->GetSubsystem<UOrionAutosaveManager>();
+
+	for (const TWeakObjectPtr<UOrionStructureComponent>& WeakComp : BulkStructures)
+	{
+		UOrionStructureComponent* StructureComp = WeakComp.Get();
+		const AActor* Owner = StructureComp ? StructureComp->GetOwner() : nullptr;
+		if (!Owner)
+		{
+			continue;
+		}
+
+		const bool bGrounded = UOrionStructureComponent::IsGroundedAt(GetWorld(), Owner->GetActorLocation(), Owner);
+		const int32 NodeId = StructureGraph.AddNode(StructureComp, StructureComp->StabilityDecay, bGrounded);
+		Region.Add(NodeId);
+		if (AutosaveManager)
+		{
+			AutosaveManager->MarkStructureAdded(NodeId);
+		}
+
+		if (FOrionOrientedBox StructureBox; GetStructureBox(Owner, StructureBox))
 		{
-			KeysToRemove.Add(Elem.Key);
+			StructureBoxes.Add(NodeId, StructureBox);
+			OccupancyGrid.AddStructure(NodeId, StructureBox);
+
+			if (StructureComp->OrionStructureType == EOrionStructure::Wall ||
+				StructureComp->OrionStructureType == EOrionStructure::DoubleWall)
+			{
+				RoomDetector.AddWall(NodeId, StructureBox);
+			}
+			NodeBoxes.Emplace(NodeId, StructureBox);
 		}
+
+		Bounds += Owner->GetComponentsBoundingBox(/*bNonColliding=*/false);
 	}
+	BulkStructures.Empty();
 
-	// Clean up empty buckets
-	for (const int64 Key : KeysToRemove)
+	/* 3. Edges (AddEdge ignores the second direction of a pair) */
+	TArray<int32> Neighbors;
+	for (const TPair<int32, FOrionOrientedBox>& NodeBox : NodeBoxes)
 	{
-		SpatialGrid.Remove(Key);
+		Neighbors.Reset();
+		FindStructureNodesTouchingBox(NodeBox.Value, NodeBox.Key, Neighbors);
+		for (const int32 Neighbor : Neighbors)
+		{
+			StructureGraph.AddEdge(NodeBox.Key, Neighbor);
+		}
 	}
-	
-	// Update SocketsByKind simultaneously (Old system compatibility)
-	TArray<EOrionStructure> KindsToRemove;
-	for (auto& Elem : SocketsByKind)
+
+	/* 4. One solve over the loaded pieces, seeded by the structures around them */
+	FOrionStabilityJob Job;
+	StructureGraph.BuildJob(Region, Job);
+	FOrionStabilityResult Result;
+	FOrionStructureGraph::Solve(Job, Result);
+
+	TArray<int32> Changed;
+	StructureGraph.ApplyResult(Result, Changed);
+
+	// Structures outside the batch may gain support through it
+	for (const int32 NodeId : Region)
 	{
-		Elem.Value.RemoveAll([Owner](const FOrionGlobalSocket& S) {
-			return S.Owner.Get() == Owner;
-		});
-		
-		if (Elem.Value.Num() == 0)
+		for (const int32 Neighbor : StructureGraph.GetNode(NodeId).Edges)
 		{
-			KindsToRemove.Add(Elem.Key);
+			if (!Region.Contains(Neighbor))
+			{
+				StructureGraph.PropagateImprovement(Neighbor, Changed);
+			}
 		}
 	}
-	
-	for (const EOrionStructure Kind : KindsToRemove)
+	SyncStabilityToComponents(Changed);
+
+	/* 5. Navigation: flush the octree updates, one dirty area over the whole batch */
+	BulkNavLock.Reset();
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+		NavSys && Bounds.IsValid)
 	{
-		SocketsByKind.Remove(Kind);
+		NavSys->AddDirtyArea(Bounds, ENavigationDirtyFlag::All);
 	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BuildingManager] Bulk load linked and solved %d structures in %.2f ms."),
+	       Region.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
-// [New] Get surrounding neighbors (Using physical overlap detection, bypassing Pivot offset issues)
-TArray<UOrionStructureComponent*> UOrionBuildingManager::GetConnectedNeighbors(AActor* CenterStructure, bool bDebug) const
+void UOrionBuildingManager::AddStructureNode(UOrionStructureComponent* StructureComp, const bool bGrounded)
 {
-	TArray<UOrionStructureComponent*> Result;
-	if (!CenterStructure) return Result;
+	if (!StructureComp || !StructureComp->GetOwner())
+	{
+		return;
+	}
 
-	UWorld* World = GetWorld();
-	if (!World) return Result;
+	// Hydrated from an instance: the node already has its edges and values, just give it back its component
+	if (HydratingNode != INDEX_NONE)
+	{
+		StructureGraph.RebindNode(HydratingNode, StructureComp);
+		SyncStabilityToComponents({HydratingNode});
+		HydratingNode = INDEX_NONE;
+		return;
+	}
 
-	// -------------------------------------------------------
-	// 1. Get StructureMesh (This is the most accurate geometry source)
-	// -------------------------------------------------------
-	UStaticMeshComponent* MeshComp = nullptr;
-	if (auto* StructComp = CenterStructure->FindComponentByClass<UOrionStructureComponent>())
+	// Already linked (BeginPlay, then UpdateStability from DelaySpawnNewStructure): refresh in place
+	if (const int32 ExistingNode = StructureGraph.FindNode(StructureComp);
+		ExistingNode != INDEX_NONE && RefreshStructureNode(ExistingNode, bGrounded))
 	{
-		MeshComp = StructComp->StructureMesh;
+		return;
 	}
-	// Double insurance: If no cache, try direct lookup
-	if (!MeshComp) MeshComp = CenterStructure->FindComponentByClass<UStaticMeshComponent>();
-	if (!MeshComp) return Result;
 
-	// -------------------------------------------------------
-	// 2. Calculate precise OABB (Oriented Bounding Box)
-	// -------------------------------------------------------
-	FVector LocalMin, LocalMax;
-	MeshComp->GetLocalBounds(LocalMin, LocalMax);
+	const int32 NodeId = StructureGraph.AddNode(StructureComp, StructureComp->StabilityDecay, bGrounded);
+	if (UOrionAutosaveManager* AutosaveManager = GetGameInstance()->GetSubsystem<UOrionAutosaveManager>())
+	{
+		AutosaveManager->MarkStructureAdded(NodeId);
+	}
 
-	// Calculate geometric center in local coordinate system (Auto-correct Pivot offset)
-	FVector LocalCenter = (LocalMin + LocalMax) * 0.5f;
-	FVector LocalExtent = (LocalMax - LocalMin) * 0.5f;
+	// One neighbour query per placement, instead of one per visited node during propagation.
+	// Box set and occupancy follow the node (also through instancing / hydration)
+	if (FOrionOrientedBox StructureBox; GetStructureBox(StructureComp->GetOwner(), StructureBox))
+	{
+		TArray<int32> Neighbors;
+		FindStructureNodesTouchingBox(StructureBox, NodeId, Neighbors);
+		for (const int32 Neighbor : Neighbors)
+		{
+			StructureGraph.AddEdge(NodeId, Neighbor);
+		}
 
-	// Transform center point and rotation to world space
-	FTransform CompTransform = MeshComp->GetComponentTransform();
-	FVector WorldCenter = CompTransform.TransformPosition(LocalCenter);
-	FQuat WorldRotation = CompTransform.GetRotation();
+		StructureBoxes.Add(NodeId, StructureBox);
+		OccupancyGrid.AddStructure(NodeId, StructureBox);
 
-	// Calculate extended half-extent (Apply scale + 0.05m tolerance)
-	// Note: GetLocalBounds returns unscaled size, must multiply by Scale
-	FVector SearchExtent = LocalExtent * CompTransform.GetScale3D();
-	SearchExtent += FVector(5.0f); // Extend 5cm in xyz
+		if (StructureComp->OrionStructureType == EOrionStructure::Wall ||
+			StructureComp->OrionStructureType == EOrionStructure::DoubleWall)
+		{
+			RoomDetector.AddWall(NodeId, StructureBox);
+		}
+	}
 
-	// -------------------------------------------------------
-	// 3. Execute physical overlap detection
-	// -------------------------------------------------------
-	TArray<FOverlapResult> Overlaps;
-	FCollisionShape BoxShape = FCollisionShape::MakeBox(SearchExtent);
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(CenterStructure); // Ignore self
-	Params.bTraceComplex = false;            // Simple collision detection is more efficient
+	TArray<int32> Changed;
+	Changed.Add(NodeId);
+	StructureGraph.PropagateImprovement(NodeId, Changed);
+	SyncStabilityToComponents(Changed);
+}
 
-	// Use WorldStatic channel (Buildings are usually WorldStatic)
-	World->OverlapMultiByChannel(
-		Overlaps,
-		WorldCenter,
-		WorldRotation,
-		ECC_WorldStatic,
-		BoxShape,
-		Params
-	);
+bool UOrionBuildingManager::RefreshStructureNode(const int32 NodeId, const bool bGrounded)
+{
+	const FOrionStructureGraph::FNode& Node = StructureGraph.GetNode(NodeId);
+	const UOrionStructureComponent* StructureComp = Node.Component.Get();
 
-	// -------------------------------------------------------
-	// 4. Debug Visualization
-	// -------------------------------------------------------
-	if (bDebug)
+	FOrionOrientedBox StructureBox;
+	if (!StructureComp || !GetStructureBox(StructureComp->GetOwner(), StructureBox))
 	{
-		// Draw purple "Search Box": Show actual detection range (Lasts 0.1s, fits Tick)
-		DrawDebugBox(World, WorldCenter, SearchExtent, WorldRotation, FColor::Purple, false, 0.1f, 0, 2.0f);
-	
-		// Draw small coordinate axis at geometric center, confirm center calculation correctness
-		DrawDebugCoordinateSystem(World, WorldCenter, WorldRotation.Rotator(), 50.0f, false, 0.1f, 0, 1.0f);
+		RemoveStructureNodeById(NodeId);
+		return false;
 	}
 
-	// -------------------------------------------------------
-	// 5. Filter results and "Highlight" neighbors
-	// -------------------------------------------------------
-	for (const FOverlapResult& Overlap : Overlaps)
+	TArray<int32> Neighbors;
+	FindStructureNodesTouchingBox(StructureBox, NodeId, Neighbors);
+
+	// Lost ground or a neighbour (the piece really moved): values can drop, that is a removal + add
+	if ((Node.bGrounded && !bGrounded) ||
+		Node.Edges.ContainsByPredicate([&Neighbors](const int32 Edge) { return !Neighbors.Contains(Edge); }))
+	{
+		RemoveStructureNodeById(NodeId);
+		return false;
+	}
+
+	// Only gains from here on: same node, same StructureId, no solve request
+	if (bGrounded)
+	{
+		StructureGraph.SetGrounded(NodeId);
+	}
+	for (const int32 Neighbor : Neighbors)
+	{
+		StructureGraph.AddEdge(NodeId, Neighbor);
+	}
+
+	StructureBoxes.Add(NodeId, StructureBox);
+	OccupancyGrid.AddStructure(NodeId, StructureBox);
+	if (StructureComp->OrionStructureType == EOrionStructure::Wall ||
+		StructureComp->OrionStructureType == EOrionStructure::DoubleWall)
+	{
+		RoomDetector.AddWall(NodeId, StructureBox);
+	}
+
+	TArray<int32> Changed;
+	StructureGraph.PropagateImprovement(NodeId, Changed);
+	SyncStabilityToComponents(Changed);
+	return true;
+}
+
+void UOrionBuildingManager::RemoveStructureNode(UOrionStructureComponent* StructureComp)
+{
+	RemoveStructureNodeById(StructureGraph.FindNode(StructureComp));
+}
+
+void UOrionBuildingManager::RemoveStructureNodeById(const int32 NodeId)
+{
+	if (!StructureGraph.IsValidNode(NodeId))
+	{
+		return;
+	}
+
+	// Only structures that drew support through this one can lose stability
+	StructureGraph.CollectSupportDependents({NodeId}, PendingStabilityRegion);
+	DropStructureNode(NodeId);
+	PendingStabilityRegion.Remove(NodeId);
+
+	RequestStabilitySolve();
+}
+
+void UOrionBuildingManager::DropStructureNode(const int32 NodeId)
+{
+	if (!StructureGraph.IsValidNode(NodeId))
+	{
+		return;
+	}
+
+	if (UOrionAutosaveManager* AutosaveManager = GetGameInstance()->GetSubsystem<UOrionAutosaveManager>())
 	{
-		AActor* HitActor = Overlap.GetActor();
-		if (!HitActor || HitActor == CenterStructure) continue;
+		AutosaveManager->MarkStructureRemoved(NodeId, StructureGraph.GetNode(NodeId).StructureId);
+	}
+
+	StructureGraph.RemoveNode(NodeId);
+	StructureBoxes.Remove(NodeId);
+	OccupancyGrid.RemoveStructure(NodeId);
+	RoomDetector.RemoveWall(NodeId);
+}
+
+uint32 UOrionBuildingManager::GetStructureId(const AActor* Actor) const
+{
+	const UOrionStructureComponent* StructureComp = Actor ? Actor->FindComponentByClass<UOrionStructureComponent>() : nullptr;
+	const int32 NodeId = StructureComp ? StructureGraph.FindNode(StructureComp) : INDEX_NONE;
+	return StructureGraph.IsValidNode(NodeId) ? StructureGraph.GetNode(NodeId).StructureId : 0;
+}
+
+void UOrionBuildingManager::CollectStructureRecordsOfNodes(const TConstArrayView<int32> NodeIds,
+                                                           TArray<FOrionStructureRecord>& Out) const
+{
+	const UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
 
-		// Confirm hit is a building with OrionStructureComponent
-		if (UOrionStructureComponent* NeighborComp = HitActor->FindComponentByClass<UOrionStructureComponent>())
+	Out.Reserve(Out.Num() + NodeIds.Num());
+	for (const int32 NodeId : NodeIds)
+	{
+		if (!StructureGraph.IsValidNode(NodeId))
 		{
-			Result.AddUnique(NeighborComp);
+			continue;
+		}
 
-			if (bDebug)
+		const FOrionStructureGraph::FNode& Node = StructureGraph.GetNode(NodeId);
+		if (const UOrionStructureComponent* StructureComp = Node.Component.Get())
+		{
+			const AActor* Owner = StructureComp->GetOwner();
+			if (Owner && !IsCollapsing(Owner))
 			{
-				// [Highlight] Detected neighbor: Draw yellow box enclosing it
-				if (UStaticMeshComponent* NeighborMesh = HitActor->FindComponentByClass<UStaticMeshComponent>())
-				{
-					FVector N_Min, N_Max;
-					NeighborMesh->GetLocalBounds(N_Min, N_Max);
-					FVector N_Center = NeighborMesh->GetComponentTransform().TransformPosition((N_Min + N_Max) * 0.5f);
-					FVector N_Extent = (N_Max - N_Min) * 0.5f * NeighborMesh->GetComponentScale();
-				
-					// Draw yellow box indicating "Connected"
-					DrawDebugBox(World, N_Center, N_Extent, NeighborMesh->GetComponentQuat(), FColor::Yellow, false, 0.1f, 0, 3.0f);
-				}
+				Out.Emplace(Owner->GetClass()->GetPathName(), Owner->GetActorTransform(), Node.StructureId);
+			}
+		}
+		else if (const FOrionStructureInstance* Instance =
+			RenderManager ? RenderManager->GetInstance(RenderManager->FindInstanceByNode(NodeId)) : nullptr)
+		{
+			Out.Emplace(Instance->BuildingClass->GetPathName(), Instance->Transform, Node.StructureId);
+		}
+	}
+}
+
+int32 UOrionBuildingManager::DetachStructureNode(UOrionStructureComponent* StructureComp)
+{
+	const int32 NodeId = StructureGraph.FindNode(StructureComp);
+	StructureGraph.RebindNode(NodeId, nullptr);
+	return NodeId;
+}
+
+void UOrionBuildingManager::BeginStructureHydration(const int32 NodeId)
+{
+	HydratingNode = NodeId;
+}
+
+void UOrionBuildingManager::EndStructureHydration()
+{
+	// The spawned actor never linked itself (no structure component / no auto registration): drop the node
+	if (HydratingNode != INDEX_NONE)
+	{
+		const int32 NodeId = HydratingNode;
+		HydratingNode = INDEX_NONE;
+		RemoveStructureNodeById(NodeId);
+	}
+}
+
+void UOrionBuildingManager::RequestStabilitySolve()
+{
+	if (bStabilitySolveRequested)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		KickStabilitySolver();
+		return;
+	}
+
+	bStabilitySolveRequested = true;
+	World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		bStabilitySolveRequested = false;
+		KickStabilitySolver();
+	}));
+}
+
+void UOrionBuildingManager::KickStabilitySolver()
+{
+	if (bStabilitySolverInFlight || PendingStabilityRegion.Num() == 0)
+	{
+		return;
+	}
+
+	// Nodes attached to the region since it was collected depend on it as well
+	TArray<int32> Roots = PendingStabilityRegion.Array();
+	StructureGraph.CollectSupportDependents(Roots, PendingStabilityRegion);
+
+	FOrionStabilityJob Job;
+	StructureGraph.BuildJob(PendingStabilityRegion, Job);
+	PendingStabilityRegion.Reset();
+
+	if (Job.Num() == 0)
+	{
+		return;
+	}
+
+	bStabilitySolverInFlight = true;
+
+	Async(EAsyncExecution::ThreadPool,
+	      [WeakThis = TWeakObjectPtr<UOrionBuildingManager>(this), Job = MoveTemp(Job)]()
+	      {
+		      FOrionStabilityResult Result;
+		      FOrionStructureGraph::Solve(Job, Result);
+
+		      AsyncTask(ENamedThreads::GameThread, [WeakThis, Result = MoveTemp(Result)]()
+		      {
+			      if (UOrionBuildingManager* Manager = WeakThis.Get())
+			      {
+				      Manager->OnStabilitySolved(Result);
+			      }
+		      });
+	      });
+}
+
+void UOrionBuildingManager::OnStabilitySolved(const FOrionStabilityResult& Result)
+{
+	bStabilitySolverInFlight = false;
+
+	// A node was removed while solving: values may rest on it, solve the region again
+	if (Result.RemovalVersion != StructureGraph.GetRemovalVersion())
+	{
+		for (const int32 NodeId : Result.NodeIds)
+		{
+			if (StructureGraph.IsValidNode(NodeId))
+			{
+				PendingStabilityRegion.Add(NodeId);
+			}
+		}
+		RequestStabilitySolve();
+		return;
+	}
+
+	// Only placements happened while solving: they can only raise values, so the result is applied and they are
+	// pushed again over it (continuous building does not keep discarding results)
+	const bool bGrewWhileSolving = Result.GraphVersion != StructureGraph.GetVersion();
+
+	TArray<int32> Changed;
+	StructureGraph.ApplyResult(Result, Changed);
+	if (bGrewWhileSolving)
+	{
+		for (const int32 NodeId : Result.NodeIds)
+		{
+			StructureGraph.PropagateImprovement(NodeId, Changed);
+		}
+	}
+	SyncStabilityToComponents(Changed);
+
+	TArray<int32> Collapse;
+	for (const int32 NodeId : Result.NodeIds)
+	{
+		if (StructureGraph.IsValidNode(NodeId) && StructureGraph.GetNode(NodeId).Stability <= 0.0f)
+		{
+			Collapse.Add(NodeId);
+		}
+	}
+
+	if (Collapse.Num() > 0)
+	{
+		CollapseStructures(Collapse);
+	}
+
+	RequestStabilitySolve();
+}
+
+void UOrionBuildingManager::SyncStabilityToComponents(const TConstArrayView<int32> NodeIds) const
+{
+	UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+
+	for (const int32 NodeId : NodeIds)
+	{
+		if (!StructureGraph.IsValidNode(NodeId))
+		{
+			continue;
+		}
+
+		const FOrionStructureGraph::FNode& Node = StructureGraph.GetNode(NodeId);
+		UOrionStructureComponent* StructureComp = Node.Component.Get();
+		if (!StructureComp)
+		{
+			// Instanced structure: the value lives in its instance record
+			if (RenderManager)
+			{
+				RenderManager->SetInstanceStability(RenderManager->FindInstanceByNode(NodeId), Node.Stability);
+			}
+			continue;
+		}
+
+		if (FMath::IsNearlyEqual(StructureComp->CurrentStability, Node.Stability, 0.001f))
+		{
+			continue;
+		}
+
+		StructureComp->CurrentStability = Node.Stability;
+
+		UE_LOG(LogTemp, Log, TEXT("[Stability] %s value updated: %.2f"), *StructureComp->GetOwner()->GetName(),
+		       Node.Stability);
+
+		// [Debug] 持久化显示稳定性数值 (事件触发)
+		if (BEnableDebugLine && GetWorld())
+		{
+			DrawDebugString(GetWorld(), FVector(0, 0, 100),
+			                FString::Printf(TEXT("%.2f"), Node.Stability),
+			                StructureComp->GetOwner(), FColor::Blue, -1.0f, /*bDrawShadow=*/true, /*FontScale=*/1.0f);
+		}
+	}
+}
+
+void UOrionBuildingManager::CollapseStructures(const TConstArrayView<int32> NodeIds)
+{
+	TArray<AActor*> Falling;
+	Falling.Reserve(NodeIds.Num());
+
+	UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+
+	for (const int32 NodeId : NodeIds)
+	{
+		if (const UOrionStructureComponent* StructureComp = StructureGraph.GetNode(NodeId).Component.Get())
+		{
+			Falling.Add(StructureComp->GetOwner());
+		}
+		else if (const int32 Handle = RenderManager ? RenderManager->FindInstanceByNode(NodeId) : INDEX_NONE;
+			Handle != INDEX_NONE)
+		{
+			// Instanced structure: no actor to destroy, removing the instance is cheap enough to do right away
+			DropStructureNode(NodeId);
+			RenderManager->RemoveInstance(Handle);
+		}
+	}
+
+	QueueCollapse(Falling);
+}
+
+void UOrionBuildingManager::QueueCollapse(const TConstArrayView<AActor*> Actors)
+{
+	UWorld* World = GetWorld();
+	if (!World || Actors.Num() == 0)
+	{
+		return;
+	}
+
+	FBox CollapsedBounds(ForceInit);
+	int32 NumQueued = 0;
+
+	{
+		// Octree updates from all actors below are flushed together when the lock goes out of scope
+		FNavigationLockContext NavLock(World, ENavigationLockReason::Unknown);
+
+		for (AActor* Actor : Actors)
+		{
+			if (!IsValid(Actor))
+			{
+				continue;
+			}
+
+			/* 1. Gameplay removal happens now: nobody can snap to / stand on it from this frame on */
+			SocketRegistry.UnregisterOwner(Actor);
+			if (UOrionStructureComponent* StructureComp = Actor->FindComponentByClass<UOrionStructureComponent>())
+			{
+				// Whole set falls together: dropping the nodes here keeps their EndPlay from re-solving anything
+				DropStructureNode(StructureGraph.FindNode(StructureComp));
+				StructureComp->CurrentStability = 0.0f;
+			}
+
+			/* 2. Visual / physical removal, navigation bounds merged into one dirty area */
+			CollapsedBounds += Actor->GetComponentsBoundingBox(/*bNonColliding=*/false);
+
+			Actor->SetActorHiddenInGame(true);
+			Actor->SetActorEnableCollision(false);
+			Actor->ForEachComponent<UPrimitiveComponent>(false, [](UPrimitiveComponent* Prim)
+			{
+				Prim->SetCanEverAffectNavigation(false);
+			});
+
+			CollapseQueue.Add(Actor);
+			CollapsingActors.Add(Actor);
+			++NumQueued;
+		}
+	}
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		NavSys && CollapsedBounds.IsValid)
+	{
+		NavSys->AddDirtyArea(CollapsedBounds, ENavigationDirtyFlag::All);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("[Stability] %d structures unstable! Collapsing..."), NumQueued);
+
+	/* 3. The actual Destroy() calls are spread over the next frames */
+	if (!World->GetTimerManager().TimerExists(CollapseTimerHandle))
+	{
+		CollapseTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UOrionBuildingManager::ProcessCollapseQueue));
+	}
+}
+
+void UOrionBuildingManager::ProcessCollapseQueue()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		CollapseQueue.Reset();
+		CollapsingActors.Reset();
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = CollapseBudgetMs / 1000.0;
+
+	int32 NumProcessed = 0;
+	while (NumProcessed < CollapseQueue.Num())
+	{
+		if (AActor* Actor = CollapseQueue[NumProcessed++].Get(); IsValid(Actor))
+		{
+			CollapsingActors.Remove(Actor);
+			Actor->Destroy();
+		}
+
+		if (FPlatformTime::Seconds() - StartTime > BudgetSeconds)
+		{
+			break;
+		}
+	}
+	CollapseQueue.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+
+	if (CollapseQueue.Num() > 0)
+	{
+		CollapseTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UOrionBuildingManager::ProcessCollapseQueue));
+	}
+	else
+	{
+		CollapseTimerHandle.Invalidate();
+		// Keys of actors that went away on their own
+		CollapsingActors.Reset();
+	}
+}
+
+// [New] Get surrounding neighbors (OBB touch test on the structure box set, bypassing Pivot offset issues)
+TArray<UOrionStructureComponent*> UOrionBuildingManager::GetConnectedNeighbors(AActor* CenterStructure, bool bDebug) const
+{
+	TArray<UOrionStructureComponent*> Result;
+	if (!CenterStructure) return Result;
+
+	UWorld* World = GetWorld();
+	if (!World) return Result;
+
+	// -------------------------------------------------------
+	// 1-2. Precise OABB (Oriented Bounding Box) of the StructureMesh
+	// -------------------------------------------------------
+	FOrionOrientedBox StructureBox;
+	if (!GetStructureBox(CenterStructure, StructureBox)) return Result;
+
+	const FVector WorldCenter = StructureBox.Center;
+	const FQuat WorldRotation = StructureBox.Rotation;
+	const FVector SearchExtent = StructureBox.Extent + FVector(FOrionStructureBoxSet::TouchTolerance); // 5cm in xyz
+
+	// -------------------------------------------------------
+	// 3. Touch test against the other structure boxes (no physics scene query)
+	// -------------------------------------------------------
+	TArray<int32> NeighborNodes;
+	FindStructureNodesTouchingBox(StructureBox,
+	                              StructureGraph.FindNode(CenterStructure->FindComponentByClass<UOrionStructureComponent>()),
+	                              NeighborNodes);
+	for (const int32 NeighborNode : NeighborNodes)
+	{
+		// Instanced structures have no component to return
+		if (UOrionStructureComponent* NeighborComp = StructureGraph.GetNode(NeighborNode).Component.Get())
+		{
+			Result.Add(NeighborComp);
+		}
+	}
+
+	// -------------------------------------------------------
+	// 4. Debug Visualization
+	// -------------------------------------------------------
+	if (bDebug)
+	{
+		// Draw purple "Search Box": Show actual detection range (Lasts 0.1s, fits Tick)
+		DrawDebugBox(World, WorldCenter, SearchExtent, WorldRotation, FColor::Purple, false, 0.1f, 0, 2.0f);
+	
+		// Draw small coordinate axis at geometric center, confirm center calculation correctness
+		DrawDebugCoordinateSystem(World, WorldCenter, WorldRotation.Rotator(), 50.0f, false, 0.1f, 0, 1.0f);
+
+		// -------------------------------------------------------
+		// 5. "Highlight" neighbors
+		// -------------------------------------------------------
+		for (const UOrionStructureComponent* NeighborComp : Result)
+		{
+			// [Highlight] Detected neighbor: Draw yellow box enclosing it
+			if (UStaticMeshComponent* NeighborMesh = NeighborComp->GetOwner()->FindComponentByClass<UStaticMeshComponent>())
+			{
+				FVector N_Min, N_Max;
+				NeighborMesh->GetLocalBounds(N_Min, N_Max);
+				FVector N_Center = NeighborMesh->GetComponentTransform().TransformPosition((N_Min + N_Max) * 0.5f);
+				FVector N_Extent = (N_Max - N_Min) * 0.5f * NeighborMesh->GetComponentScale();
+			
+				// Draw yellow box indicating "Connected"
+				DrawDebugBox(World, N_Center, N_Extent, NeighborMesh->GetComponentQuat(), FColor::Yellow, false, 0.1f, 0, 3.0f);
 			}
 		}
 	}
@@ -688,6 +1376,658 @@ TArray<UOrionStructureComponent*> UOrionBuildingManager::GetConnectedNeighbors(A
 	return Result;
 }
 
+bool UOrionBuildingManager::GetStructureBox(const AActor* Structure, FOrionOrientedBox& OutBox, const float Padding)
+{
+	if (!Structure) return false;
+
+	// -------------------------------------------------------
+	// 1. Get StructureMesh (This is the most accurate geometry source)
+	// -------------------------------------------------------
+	UStaticMeshComponent* MeshComp = nullptr;
+	if (const auto* StructComp = Structure->FindComponentByClass<UOrionStructureComponent>())
+	{
+		MeshComp = StructComp->StructureMesh;
+	}
+	// Double insurance: If no cache, try direct lookup
+	if (!MeshComp) MeshComp = Structure->FindComponentByClass<UStaticMeshComponent>();
+	if (!MeshComp) return false;
+
+	// -------------------------------------------------------
+	// 2. Calculate precise OABB (Oriented Bounding Box)
+	// -------------------------------------------------------
+	FVector LocalMin, LocalMax;
+	MeshComp->GetLocalBounds(LocalMin, LocalMax);
+
+	// Calculate geometric center in local coordinate system (Auto-correct Pivot offset)
+	const FVector LocalCenter = (LocalMin + LocalMax) * 0.5f;
+	const FVector LocalExtent = (LocalMax - LocalMin) * 0.5f;
+
+	// Transform center point and rotation to world space
+	const FTransform CompTransform = MeshComp->GetComponentTransform();
+	OutBox.Center = CompTransform.TransformPosition(LocalCenter);
+	OutBox.Rotation = CompTransform.GetRotation();
+
+	// Note: GetLocalBounds returns unscaled size, must multiply by Scale
+	OutBox.Extent = LocalExtent * CompTransform.GetScale3D().GetAbs() + FVector(Padding);
+	return true;
+}
+
+bool UOrionBuildingManager::GetStructureBoxForClass(const UClass* BuildingClass, const FTransform& Transform,
+                                                    FOrionOrientedBox& OutBox) const
+{
+	if (!BuildingClass) return false;
+
+	FOrionClassMeshBounds* Bounds = ClassMeshBounds.Find(BuildingClass);
+	if (!Bounds)
+	{
+		Bounds = &ClassMeshBounds.Add(BuildingClass);
+
+		// StructureMesh is the static mesh tagged "StructureMesh" (see UOrionStructureComponent::BeginPlay),
+		// either native (CDO) or added in the blueprint (construction script templates)
+		const UStaticMeshComponent* MeshTemplate = nullptr;
+		const AActor* CDO = BuildingClass->GetDefaultObject<AActor>();
+		TInlineComponentArray<UStaticMeshComponent*> NativeMeshes;
+		CDO->GetComponents(NativeMeshes);
+		for (const UStaticMeshComponent* Mesh : NativeMeshes)
+		{
+			if (Mesh->ComponentHasTag(FName("StructureMesh")))
+			{
+				MeshTemplate = Mesh;
+				// Up to the root, whose transform is the spawn transform
+				for (const USceneComponent* Each = Mesh; Each && Each != CDO->GetRootComponent();
+				     Each = Each->GetAttachParent())
+				{
+					Bounds->MeshTransform = Bounds->MeshTransform * Each->GetRelativeTransform();
+				}
+				break;
+			}
+		}
+
+		for (const UClass* Class = BuildingClass; !MeshTemplate && Class; Class = Class->GetSuperClass())
+		{
+			const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(Class);
+			USimpleConstructionScript* SCS = BPClass ? BPClass->SimpleConstructionScript.Get() : nullptr;
+			if (!SCS) continue;
+
+			for (USCS_Node* Node : SCS->GetAllNodes())
+			{
+				const UStaticMeshComponent* Mesh = Node ? Cast<UStaticMeshComponent>(Node->ComponentTemplate) : nullptr;
+				if (!Mesh || !Mesh->ComponentHasTag(FName("StructureMesh"))) continue;
+
+				MeshTemplate = Mesh;
+				for (USCS_Node* Each = Node; Each; Each = SCS->FindParentNode(Each))
+				{
+					// A blueprint root node without a native root becomes the root component
+					if (!CDO->GetRootComponent() && !SCS->FindParentNode(Each)) break;
+
+					const USceneComponent* Template = Cast<USceneComponent>(Each->ComponentTemplate);
+					if (Template)
+					{
+						Bounds->MeshTransform = Bounds->MeshTransform * Template->GetRelativeTransform();
+					}
+				}
+				break;
+			}
+		}
+
+		if (MeshTemplate && MeshTemplate->GetStaticMesh())
+		{
+			// What GetLocalBounds returns on a spawned component
+			const FBox LocalBox = MeshTemplate->GetStaticMesh()->GetBounds().GetBox();
+			Bounds->LocalCenter = LocalBox.GetCenter();
+			Bounds->LocalExtent = LocalBox.GetExtent();
+			Bounds->bValid = true;
+		}
+	}
+
+	if (!Bounds->bValid) return false;
+
+	// Same box as GetStructureBox on the spawned piece
+	const FTransform MeshTransform = Bounds->MeshTransform * Transform;
+	OutBox.Center = MeshTransform.TransformPosition(Bounds->LocalCenter);
+	OutBox.Rotation = MeshTransform.GetRotation();
+	OutBox.Extent = Bounds->LocalExtent * MeshTransform.GetScale3D().GetAbs();
+	return true;
+}
+
+void UOrionBuildingManager::FindStructureNodesTouchingBox(const FOrionOrientedBox& Box, const int32 IgnoredNode,
+                                                          TArray<int32>& OutNodes) const
+{
+	// Broadphase: nothing marked around the box, no structure can touch it
+	if (OccupancyGrid.IsRegionEmpty(Box.GetAABB().ExpandBy(FOrionStructureBoxSet::TouchTolerance)))
+	{
+		CountGridAnswer(EOrionOccupancy::Free);
+		return;
+	}
+	CountGridAnswer(EOrionOccupancy::Maybe);
+
+	StructureBoxes.QueryTouching(Box, OutNodes, IgnoredNode);
+}
+
+void UOrionBuildingManager::FindStructureNodesTouchingBoxPhysics(const FOrionOrientedBox& Box, const AActor* IgnoredActor,
+                                                                 TArray<int32>& OutNodes) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+
+	TArray<FOverlapResult> Overlaps;
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(IgnoredActor); // Ignore self
+	Params.bTraceComplex = false;         // Simple collision detection is more efficient
+
+	// Use WorldStatic channel (Buildings are usually WorldStatic)
+	World->OverlapMultiByChannel(Overlaps, Box.Center, Box.Rotation, ECC_WorldStatic,
+	                             FCollisionShape::MakeBox(Box.Extent + FVector(FOrionStructureBoxSet::TouchTolerance)),
+	                             Params);
+	CountPhysicsQuery();
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		int32 NodeId = INDEX_NONE;
+
+		if (RenderManager && UOrionBuildingRenderManager::IsStructureInstanceComponent(Overlap.GetComponent()))
+		{
+			// Instanced structure: ItemIndex is the HISM instance
+			if (const FOrionStructureInstance* Instance =
+				RenderManager->GetInstance(RenderManager->FindInstance(Overlap.GetComponent(), Overlap.ItemIndex)))
+			{
+				NodeId = Instance->GraphNode;
+			}
+		}
+		else if (const AActor* HitActor = Overlap.GetActor(); HitActor && HitActor != IgnoredActor)
+		{
+			NodeId = StructureGraph.FindNode(HitActor->FindComponentByClass<UOrionStructureComponent>());
+		}
+
+		if (NodeId != INDEX_NONE)
+		{
+			OutNodes.AddUnique(NodeId);
+		}
+	}
+}
+
+void UOrionBuildingManager::BenchmarkStructureQueries(const int32 Iterations) const
+{
+	if (!GetWorld() || StructureBoxes.Num() == 0 || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Building] Query benchmark: no structures to query."));
+		return;
+	}
+
+	TArray<TPair<int32, FOrionOrientedBox>> Queries;
+	Queries.Reserve(StructureBoxes.Num());
+	StructureBoxes.ForEach([&Queries](const int32 NodeId, const FOrionOrientedBox& Box)
+	{
+		Queries.Emplace(NodeId, Box);
+	});
+
+	double PhysicsSeconds = 0.0;
+	double BoxSeconds = 0.0;
+	int32 NumMismatches = 0;
+	int32 NumNeighbors = 0;
+
+	TArray<int32> PhysicsNodes;
+	TArray<int32> BoxNodes;
+
+	for (const TPair<int32, FOrionOrientedBox>& Query : Queries)
+	{
+		const int32 NodeId = Query.Key;
+		const UOrionStructureComponent* StructureComp = StructureGraph.GetNode(NodeId).Component.Get();
+		const AActor* IgnoredActor = StructureComp ? StructureComp->GetOwner() : nullptr;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			PhysicsNodes.Reset();
+			FindStructureNodesTouchingBoxPhysics(Query.Value, IgnoredActor, PhysicsNodes);
+		}
+		PhysicsSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			BoxNodes.Reset();
+			StructureBoxes.QueryTouching(Query.Value, BoxNodes, NodeId);
+		}
+		BoxSeconds += FPlatformTime::Seconds() - StartTime;
+
+		// An instanced structure has no actor to ignore and hits its own HISM instance
+		PhysicsNodes.Remove(NodeId);
+		PhysicsNodes.Sort();
+		BoxNodes.Sort();
+		NumNeighbors += BoxNodes.Num();
+
+		if (PhysicsNodes != BoxNodes)
+		{
+			++NumMismatches;
+			UE_LOG(LogTemp, Warning, TEXT("[Building] Query benchmark: node %d physics=%d neighbours, boxes=%d neighbours"),
+			       NodeId, PhysicsNodes.Num(), BoxNodes.Num());
+		}
+	}
+
+	const double NumQueries = static_cast<double>(Queries.Num()) * Iterations;
+	UE_LOG(LogTemp, Log,
+	       TEXT("[Building] Query benchmark: %d structures x %d | physics %.2f us/query, boxes %.2f us/query (x%.1f) | %d neighbours, %d mismatches"),
+	       Queries.Num(), Iterations,
+	       PhysicsSeconds * 1e6 / NumQueries, BoxSeconds * 1e6 / NumQueries,
+	       BoxSeconds > 0.0 ? PhysicsSeconds / BoxSeconds : 0.0,
+	       NumNeighbors, NumMismatches);
+}
+
+void UOrionBuildingManager::UpdateRooms() const
+{
+	if (!RoomDetector.IsDirty())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	RoomDetector.Update();
+
+	UE_LOG(LogTemp, Verbose, TEXT("[Building] Rooms updated in %.3f ms: %d rooms, %d walls"),
+	       (FPlatformTime::Seconds() - StartTime) * 1000.0, RoomDetector.NumRooms(), RoomDetector.NumWalls());
+}
+
+int32 UOrionBuildingManager::FindRoomAt(const FVector& Location) const
+{
+	UpdateRooms();
+	return RoomDetector.FindRoomAt(Location);
+}
+
+const FOrionRoom* UOrionBuildingManager::GetRoom(const int32 RoomId) const
+{
+	UpdateRooms();
+	return RoomDetector.GetRoom(RoomId);
+}
+
+const FOrionRoomDetector& UOrionBuildingManager::GetRoomDetector() const
+{
+	UpdateRooms();
+	return RoomDetector;
+}
+
+bool UOrionBuildingManager::ExportRoomsToCsv(const FString& Filename) const
+{
+	const FString FullPath = FPaths::ProjectSavedDir() / Filename;
+
+	if (!FFileHelper::SaveStringToFile(GetRoomDetector().ToCsv(), *FullPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Building] Failed to write room CSV: %s"), *FullPath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Building] Wrote %d rooms to %s"), RoomDetector.NumRooms(), *FullPath);
+	return true;
+}
+
+void UOrionBuildingManager::CaptureLayout(const TConstArrayView<AActor*> Structures, const FTransform& Origin,
+                                          UOrionBuildingLayout* OutLayout) const
+{
+	if (!OutLayout) return;
+
+	for (const AActor* Structure : Structures)
+	{
+		if (!IsValid(Structure) || !Structure->FindComponentByClass<UOrionStructureComponent>())
+		{
+			continue;
+		}
+
+		FOrionLayoutPiece& Piece = OutLayout->Pieces.AddDefaulted_GetRef();
+		Piece.BuildingClass = Structure->GetClass();
+		Piece.RelativeTransform = Structure->GetActorTransform().GetRelativeTransform(Origin);
+	}
+}
+
+void UOrionBuildingManager::CaptureLayoutInBox(const FBox& Region, const FTransform& Origin,
+                                               UOrionBuildingLayout* OutLayout) const
+{
+	if (!OutLayout || !Region.IsValid) return;
+
+	TArray<int32> Nodes;
+	StructureBoxes.QueryIntersecting(FOrionOrientedBox(Region.GetCenter(), FQuat::Identity, Region.GetExtent()), 0.f, Nodes);
+
+	const UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+
+	TArray<AActor*> Actors;
+	for (const int32 NodeId : Nodes)
+	{
+		if (const UOrionStructureComponent* StructureComp = StructureGraph.GetNode(NodeId).Component.Get())
+		{
+			Actors.Add(StructureComp->GetOwner());
+		}
+		else if (const FOrionStructureInstance* Instance =
+			RenderManager ? RenderManager->GetInstance(RenderManager->FindInstanceByNode(NodeId)) : nullptr)
+		{
+			// Instanced structure: class and actor transform are kept in its record
+			FOrionLayoutPiece& Piece = OutLayout->Pieces.AddDefaulted_GetRef();
+			Piece.BuildingClass = Instance->BuildingClass.Get();
+			Piece.RelativeTransform = Instance->Transform.GetRelativeTransform(Origin);
+		}
+	}
+
+	CaptureLayout(Actors, Origin, OutLayout);
+
+	UE_LOG(LogTemp, Log, TEXT("[Building] Captured %d structures into layout %s"),
+	       OutLayout->Pieces.Num(), *OutLayout->GetName());
+}
+
+bool UOrionBuildingManager::StampLayout(const UOrionBuildingLayout* Layout, const FTransform& Origin)
+{
+	UWorld* World = GetWorld();
+	if (!World || !Layout || Layout->Pieces.Num() == 0) return false;
+
+	if (IsStampingLayout() || IsSocketBatchOpen() || IsBulkLoading())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Building] StampLayout: another batch placement is still running."));
+		return false;
+	}
+
+	const int32 Count = Layout->Pieces.Num();
+
+	/* 1. Resolve classes, world transforms and placing rules */
+	TArray<UClass*> Classes;
+	TArray<FTransform> Transforms;
+	TArray<EOrionStructure> Types;
+	Classes.Reserve(Count);
+	Transforms.Reserve(Count);
+	Types.Reserve(Count);
+
+	const UOrionAssetPreloadManager* PreloadManager = GetGameInstance()->GetSubsystem<UOrionAssetPreloadManager>();
+	for (const FOrionLayoutPiece& Piece : Layout->Pieces)
+	{
+		UClass* BuildingClass = PreloadManager
+			                        ? PreloadManager->FindOrLoadClass<AActor>(Piece.BuildingClass.ToString()).Get()
+			                        : Piece.BuildingClass.LoadSynchronous();
+		if (!BuildingClass)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Building] StampLayout: failed to load class %s"),
+			       *Piece.BuildingClass.ToString());
+			return false;
+		}
+
+		Classes.Add(BuildingClass);
+		Transforms.Add(Piece.RelativeTransform * Origin);
+		Types.Add(GetStructureTypeForClass(BuildingClass));
+	}
+
+	/* 2. Blocking: every piece against what is already built (pieces of one layout only touch each other) */
+	FOrionStructureBoxSet LayoutBoxes;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Types[i] == EOrionStructure::None)
+		{
+			continue; // Props: no structure box, nothing to support
+		}
+
+		// The box the spawned piece will have (mesh bounds, scale), not the type bounds at the pivot
+		FOrionOrientedBox Box;
+		if (!GetStructureBoxForClass(Classes[i], Transforms[i], Box))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Building] StampLayout: piece %d (%s) has no StructureMesh."),
+			       i, *Classes[i]->GetName());
+			return false;
+		}
+		if (IsPlacementBlocked(Box.Center, Box.Rotation, Box.Extent, nullptr))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Building] StampLayout: piece %d (%s) is blocked."), i, *Classes[i]->GetName());
+			return false;
+		}
+
+		LayoutBoxes.Add(i, Box);
+	}
+
+	/* 3. Stability: the whole layout solved as one region, seeded by the existing structures it touches */
+	FOrionStabilityJob Job;
+	Job.GraphVersion = StructureGraph.GetVersion();
+	Job.EdgeOffsets.Reserve(Count + 1);
+
+	TArray<int32> Neighbours;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Job.NodeIds.Add(i);
+		Job.Decays.Add(UOrionStructureComponent::GetDefaultStabilityDecay(Types[i]));
+		Job.SeedStability.Add(0.f);
+		Job.SeedParents.Add(INDEX_NONE);
+		Job.EdgeOffsets.Add(Job.Edges.Num());
+
+		const FOrionOrientedBox* Box = LayoutBoxes.Find(i);
+		if (!Box)
+		{
+			Job.Grounded.Add(1);
+			continue;
+		}
+
+		Job.Grounded.Add(UOrionStructureComponent::IsGroundedAt(World, Box->Center, nullptr) ? 1 : 0);
+		CountPhysicsQuery();
+
+		Neighbours.Reset();
+		FindStructureNodesTouchingBox(*Box, INDEX_NONE, Neighbours);
+		for (const int32 Neighbour : Neighbours)
+		{
+			if (const float Stability = StructureGraph.GetNode(Neighbour).Stability; Stability > Job.SeedStability[i])
+			{
+				Job.SeedStability[i] = Stability;
+				Job.SeedParents[i] = Neighbour;
+			}
+		}
+
+		Neighbours.Reset();
+		LayoutBoxes.QueryTouching(*Box, Neighbours, i);
+		Job.Edges.Append(Neighbours);
+	}
+	Job.EdgeOffsets.Add(Job.Edges.Num());
+
+	FOrionStabilityResult Result;
+	FOrionStructureGraph::Solve(Job, Result);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Result.Stability[i] <= 0.f)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Building] StampLayout: piece %d (%s) would have no support."),
+			       i, *Classes[i]->GetName());
+			return false;
+		}
+	}
+
+	/* 4. Spawn order: supporters first, so every piece finds its support already in the graph on BeginPlay */
+	TArray<int32> Order;
+	Order.Reserve(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Order.Add(i);
+	}
+	Order.StableSort([&Result](const int32 A, const int32 B)
+	{
+		return Result.Stability[A] > Result.Stability[B];
+	});
+
+	StampQueue.Reserve(Count);
+	for (const int32 i : Order)
+	{
+		StampQueue.Add({Classes[i], Transforms[i]});
+	}
+	StampClasses.Append(Classes);
+	StampCursor = 0;
+
+	StampTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+		FTimerDelegate::CreateUObject(this, &UOrionBuildingManager::ProcessStampQueue));
+
+	UE_LOG(LogTemp, Log, TEXT("[Building] StampLayout: %d pieces validated, spawning."), Count);
+	return true;
+}
+
+void UOrionBuildingManager::ProcessStampQueue()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		StampQueue.Reset();
+		StampSpawned.Reset();
+		StampClasses.Reset();
+		return;
+	}
+
+	// A load owns the bulk load meanwhile, the next slice waits for it
+	if (IsBulkLoading())
+	{
+		StampTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UOrionBuildingManager::ProcessStampQueue));
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = StampBudgetMs / 1000.0;
+
+	{
+		// This frame's pieces: one socket insertion, one neighbour pass, one solve (seeded by the pieces of the
+		// previous frames, supporters come first) and one navmesh update. Closed before the frame ends, so player
+		// placement and instancing are never locked out between slices
+		BeginBulkLoad();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		while (StampCursor < StampQueue.Num())
+		{
+			const FOrionStampPiece& Piece = StampQueue[StampCursor++];
+
+			// BeginPlay buffers the sockets and queues the node, like a loaded structure
+			if (AActor* Spawned = World->SpawnActor<AActor>(Piece.BuildingClass, Piece.Transform, SpawnParams))
+			{
+				Spawned->SetActorScale3D(Piece.Transform.GetScale3D());
+				StampSpawned.Add(Spawned);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("[Building] StampLayout: SpawnActor failed (class: %s)."),
+				       *Piece.BuildingClass->GetName());
+			}
+
+			if (FPlatformTime::Seconds() - StartTime > BudgetSeconds)
+			{
+				break;
+			}
+		}
+
+		EndBulkLoad();
+	}
+
+	if (StampCursor < StampQueue.Num())
+	{
+		StampTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UOrionBuildingManager::ProcessStampQueue));
+		return;
+	}
+
+	/* Done: instancing like a loaded base */
+	TArray<AActor*> Spawned;
+	Spawned.Reserve(StampSpawned.Num());
+	for (const TWeakObjectPtr<AActor>& Actor : StampSpawned)
+	{
+		if (Actor.IsValid())
+		{
+			Spawned.Add(Actor.Get());
+		}
+	}
+
+	if (UOrionBuildingRenderManager* RenderManager = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>();
+		RenderManager && RenderManager->bInstanceStructures)
+	{
+		RenderManager->InstanceStructures(Spawned);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Building] StampLayout: %d / %d pieces placed."), Spawned.Num(), StampQueue.Num());
+
+	StampQueue.Reset();
+	StampSpawned.Reset();
+	StampClasses.Reset();
+	StampTimerHandle.Invalidate();
+}
+
+EOrionStructure UOrionBuildingManager::GetStructureTypeForClass(const TSubclassOf<AActor> BPClass) const
+{
+	if (!BPClass) return EOrionStructure::None;
+
+	if (const EOrionStructure* Cached = StructureTypeByClass.Find(BPClass.Get()))
+	{
+		return *Cached;
+	}
+
+	// Building data stores the blueprint class path, same string as the generated class path name
+	EOrionStructure Type = EOrionStructure::None;
+	const FString ClassPath = BPClass->GetPathName();
+	for (const FOrionDataBuilding& Building : GetOrionDataBuildings())
+	{
+		if (Building.BuildingBlueprintReference == ClassPath)
+		{
+			Type = Building.BuildingPlacingRule;
+			break;
+		}
+	}
+
+	StructureTypeByClass.Add(BPClass.Get(), Type);
+	return Type;
+}
+
+FOrionStabilityPreview UOrionBuildingManager::PreviewPlacementStability(const TSubclassOf<AActor> BPClass,
+                                                                        const FTransform& Transform,
+                                                                        const AActor* IgnoredActor) const
+{
+	return PreviewPlacementStability(GetStructureTypeForClass(BPClass), BPClass, Transform, IgnoredActor);
+}
+
+FOrionStabilityPreview UOrionBuildingManager::PreviewPlacementStability(const EOrionStructure Type,
+                                                                        const UClass* BuildingClass,
+                                                                        const FTransform& Transform,
+                                                                        const AActor* IgnoredActor) const
+{
+	FOrionStabilityPreview Preview;
+	if (Type == EOrionStructure::None)
+	{
+		// Not a structure (props etc.), nothing to support
+		Preview.Stability = 1.f;
+		return Preview;
+	}
+
+	const FVector Location = Transform.GetLocation();
+	Preview.bGrounded = UOrionStructureComponent::IsGroundedAt(GetWorld(), Location, IgnoredActor);
+	CountPhysicsQuery();
+
+	/* 1. Would-be neighbours: same touch test and mesh box as the placed piece (AddStructureNode, stamping).
+	 *    Type bounds at the pivot only when the class has no structure mesh. */
+	FOrionOrientedBox Box;
+	if (!GetStructureBoxForClass(BuildingClass, Transform, Box))
+	{
+		Box = FOrionOrientedBox(Location, Transform.GetRotation(), UOrionStructureComponent::GetStructureBounds(Type));
+	}
+
+	TArray<int32> NeighbourNodes;
+	FindStructureNodesTouchingBox(Box, INDEX_NONE, NeighbourNodes);
+
+	/* 2. Read-only evaluation on the graph */
+	int32 SupportNode = INDEX_NONE;
+	TArray<TPair<int32, float>> Improved;
+	Preview.Stability = StructureGraph.EvaluateAddition(NeighbourNodes,
+	                                                    UOrionStructureComponent::GetDefaultStabilityDecay(Type),
+	                                                    Preview.bGrounded, SupportNode, &Improved);
+
+	if (SupportNode != INDEX_NONE)
+	{
+		Preview.Support = StructureGraph.GetNode(SupportNode).Component;
+	}
+
+	Preview.ImprovedSupports.Reserve(Improved.Num());
+	for (const TPair<int32, float>& Pair : Improved)
+	{
+		Preview.ImprovedSupports.Emplace(StructureGraph.GetNode(Pair.Key).Component, Pair.Value);
+	}
+
+	return Preview;
+}
+
 // 从 DataTable 加载建筑数据
 void UOrionBuildingManager::LoadBuildingDataFromDataTable()
 {
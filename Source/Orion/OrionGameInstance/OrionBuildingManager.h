@@ -5,31 +5,28 @@
 #include "CoreMinimal.h"
 #include "EngineUtils.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "AI/NavigationSystemBase.h"
 #include "Orion/OrionSaveGame/OrionSaveGame.h"
 #include "Engine/DataTable.h"
 #include "Engine/Texture2D.h"
 #include "UObject/SoftObjectPath.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+#include "Orion/OrionGameInstance/OrionSocketRegistry.h"
+#include "Orion/OrionGameInstance/OrionStructureGraph.h"
+#include "Orion/OrionGameInstance/OrionBuildingRenderManager.h"
+#include "Orion/OrionGameInstance/OrionOccupancyGrid.h"
+#include "Orion/OrionGameInstance/OrionStructureBoxSet.h"
+#include "Orion/OrionGameInstance/OrionRoomDetector.h"
 
 
 class AOrionStructure;
 class AActor;
 class UOrionStructureComponent;
 class FBuildingObjectsPool;
+class UOrionBuildingLayout;
 
 #include "OrionBuildingManager.generated.h"
 
-UENUM()
-enum class EOrionStructure : uint8
-{
-	None,
-	BasicSquareFoundation,
-	BasicTriangleFoundation,
-	Wall,
-	DoubleWall,
-	BasicRoof,
-	InclinedRoof,
-};
-
 USTRUCT(BlueprintType)
 struct FOrionDataBuilding
 {
@@ -84,55 +81,31 @@ struct FOrionDataBuildingRow : public FTableRowBase
 };
 
 
-USTRUCT()
-struct FOrionGlobalSocket
+// [Occupancy] Placement / neighbour query counters of one frame
+struct FOrionPlacementQueryStats
 {
-	GENERATED_BODY()
-
-	UPROPERTY()
-	FVector Location;
-
-	UPROPERTY()
-	FRotator Rotation;
+	uint64 Frame = 0;
+	int32 GridFree = 0;       // Answered by the grid, no physics
+	int32 GridBlocked = 0;    // Answered by the grid, no physics
+	int32 GridMaybe = 0;      // Fell through to the physics narrowphase
+	int32 PhysicsQueries = 0; // Traces / overlaps actually sent to the physics scene
+};
 
-	UPROPERTY()
-	FVector Scale;
+// [Stability] Result of a placement preview, pure data (nothing is spawned or linked)
+struct FOrionStabilityPreview
+{
+	float Stability = 0.f;
+	bool bGrounded = false;
 
-	UPROPERTY()
-	EOrionStructure Kind;
+	// Neighbour the piece would draw its stability from (null when grounded or unsupported)
+	TWeakObjectPtr<UOrionStructureComponent> Support;
 
-	UPROPERTY()
-	bool bOccupied = false;
+	// Existing structures that would gain stability through the new piece, with their new value
+	TArray<TPair<TWeakObjectPtr<UOrionStructureComponent>, float>> ImprovedSupports;
 
-	UPROPERTY()
-	TWeakObjectPtr<AActor> Owner;
-
-	FOrionGlobalSocket() = default;
-
-	FOrionGlobalSocket(const FVector& InLoc,
-	                   const FRotator& InRot,
-	                   const EOrionStructure InKind,
-	                   const bool bInOccupied,
-	                   AActor* InOwner, const FVector& Scale = FVector(1.0f, 1.0f, 1.0f))
-		: Location(InLoc)
-		  , Rotation(InRot)
-		  , Scale(Scale)
-		  , Kind(InKind)
-		  , bOccupied(bInOccupied)
-		  , Owner(InOwner)
-	{
-	}
+	bool IsValidPlacement() const { return Stability > 0.f; }
 };
 
-	// [UHT Compatible] Struct wrapper: UHT does not support TMap Value directly being TArray
-USTRUCT()
-struct FOrionSocketBucket
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	TArray<FOrionGlobalSocket> Sockets;
-};
 
 /**
  * 
@@ -179,11 +152,32 @@ public:
 		for (TActorIterator<TStructureIterator> It(World); It; ++It)
 		{
 			const AActor* Act = *It;
+			// Collapsed already, only waiting for Destroy()
+			if (IsCollapsing(Act))
+			{
+				continue;
+			}
 			FString Path = Act->GetClass()->GetPathName();
-			Out.Emplace(Path, Act->GetActorTransform());
+			Out.Emplace(Path, Act->GetActorTransform(), GetStructureId(Act));
+		}
+
+		// Instanced structures have no actor
+		if (const UOrionBuildingRenderManager* RenderManager =
+			GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>())
+		{
+			RenderManager->CollectStructureRecords(Out);
 		}
 	}
 
+	/* Records of the given graph nodes only (actor or instance), for autosave deltas */
+	void CollectStructureRecordsOfNodes(TConstArrayView<int32> NodeIds, TArray<FOrionStructureRecord>& Out) const;
+
+	/* StructureId of the actor's graph node, 0 if it has none */
+	uint32 GetStructureId(const AActor* Actor) const;
+
+	/* Hidden by a collapse and queued for Destroy(): no longer part of the world for saves */
+	bool IsCollapsing(const AActor* Actor) const { return CollapsingActors.Contains(Actor); }
+
 	/* ========== ② Completely reset Socket pool (called before loading) ========== */
 	void ResetAllSockets(const UWorld* World);
 	bool DelaySpawnNewStructure(TSubclassOf<AActor> BPClass, UWorld* World, const FTransform& TargetTransform,
@@ -199,8 +193,6 @@ public:
 		AActor* ParentActor = nullptr);
 
 
-	const TArray<FOrionGlobalSocket>& GetSnapSocketsByKind(const EOrionStructure Kind) const;
-
 	// [Core] Register socket (Directly into storage, using new grid system)
 	void RegisterSocket(const FVector& Loc,
 	                    const FRotator& Rot,
@@ -209,9 +201,32 @@ public:
 	                    const UWorld* World,
 	                    AActor* Owner, const FVector& Scale = FVector(1.0f, 1.0f, 1.0f));
 
+	// [Core] Register every socket of a structure: transforms a precomputed per-type template in one batch
+	void RegisterSocketTemplate(TConstArrayView<FOrionSocketTemplateEntry> SocketTemplate,
+	                            const FTransform& StructureTransform, AActor* Owner);
+
 	// [Core] Unregister socket (Remove by Owner)
 	void UnregisterSockets(AActor* Owner);
 
+	// [Instancing] Sockets of an instanced structure stay in the grid under NewOwner and are removed by id
+	void DetachSockets(const AActor* Owner, AActor* NewOwner, TArray<int32>& OutSocketIds);
+	void UnregisterSocketIds(TConstArrayView<int32> SocketIds);
+
+	// [Bulk] While a batch is open, socket registration is buffered and EndSocketBatch inserts
+	// everything in one pass (one grid insertion per cell). Used by bulk loads.
+	void BeginSocketBatch();
+	void EndSocketBatch();
+	bool IsSocketBatchOpen() const { return bSocketBatchOpen; }
+
+	// [Bulk] Loading a saved base: a socket batch, plus the per-spawn graph work is deferred. Structures spawned
+	// while open only queue themselves (AddBulkStructure); EndBulkLoad links them in one neighbour pass, runs one
+	// stability solve over all of them and dirties the navmesh once over their combined bounds (navigation updates
+	// are locked meanwhile). The saved base stood, so nothing collapses.
+	void BeginBulkLoad();
+	void EndBulkLoad();
+	bool IsBulkLoading() const { return bBulkLoadOpen; }
+	void AddBulkStructure(UOrionStructureComponent* StructureComp);
+
 	// [Query] Core query + Filter logic
 	// Returns whether found, and fills OutSocket with the best socket
 	bool FindNearestSocket(const FVector& QueryPos, float SearchRadius, EOrionStructure Type, FOrionGlobalSocket& OutSocket) const;
@@ -219,25 +234,189 @@ public:
 	// [New] Get all physically touching building components around specified actor (No connection established, returns list only)
 	TArray<UOrionStructureComponent*> GetConnectedNeighbors(AActor* CenterStructure, bool bDebug = false) const;
 
-	TMap<EOrionStructure, TArray<FOrionGlobalSocket>> SocketsByKind;
+	const FOrionSocketRegistry& GetSocketRegistry() const { return SocketRegistry; }
+
+	// [Stability] Connectivity graph maintenance, called by UOrionStructureComponent
+	// Adding (or re-adding after a move) links the node to its touching neighbours; gained support propagates immediately
+	void AddStructureNode(UOrionStructureComponent* StructureComp, bool bGrounded);
+	// Removing re-solves the structures that drew support through this one off the game thread
+	void RemoveStructureNode(UOrionStructureComponent* StructureComp);
+
+	const FOrionStructureGraph& GetStructureGraph() const { return StructureGraph; }
+
+	// [Instancing] Unbinds the component's node (edges and values kept) and returns it, see UOrionBuildingRenderManager
+	int32 DetachStructureNode(UOrionStructureComponent* StructureComp);
+	// [Instancing] While open, the next AddStructureNode rebinds NodeId instead of creating a new node
+	void BeginStructureHydration(int32 NodeId);
+	void EndStructureHydration();
+
+	// [Stability] Would-be stability of a piece at Transform, evaluated on the graph without spawning anything.
+	// Cheap enough to run every frame while placing (one box set query + a read-only propagation).
+	// BuildingClass: class of the piece, its mesh box finds the neighbours (same box as the placed piece).
+	// IgnoredActor: the preview actor, so it never counts as its own neighbour / ground.
+	FOrionStabilityPreview PreviewPlacementStability(EOrionStructure Type, const UClass* BuildingClass,
+	                                                 const FTransform& Transform,
+	                                                 const AActor* IgnoredActor = nullptr) const;
+	FOrionStabilityPreview PreviewPlacementStability(TSubclassOf<AActor> BPClass, const FTransform& Transform,
+	                                                 const AActor* IgnoredActor = nullptr) const;
+
+	// Placing rule of a building blueprint (from the building data), None if it is not a building
+	EOrionStructure GetStructureTypeForClass(TSubclassOf<AActor> BPClass) const;
+
+	// [Collapse] Structures falling in the same frame are unregistered (sockets, graph) and hidden at once,
+	// with a single merged navmesh dirty area; Destroy() is then spread over the next frames within CollapseBudgetMs
+	void QueueCollapse(TConstArrayView<AActor*> Actors);
+
+	static constexpr double CollapseBudgetMs = 1.0;
+
+	// [Occupancy] Voxel broadphase in front of the physics placement / neighbour queries
+	const FOrionOccupancyGrid& GetOccupancyGrid() const { return OccupancyGrid; }
+
+	// Counters of the last complete frame (the current one is still being filled)
+	const FOrionPlacementQueryStats& GetPlacementQueryStats() const;
+	void CountPhysicsQuery(int32 Num = 1) const;
+
+	// [Boxes] Oriented boxes of all structures keyed by graph node id: neighbour / blocker queries without the physics scene
+	const FOrionStructureBoxSet& GetStructureBoxes() const { return StructureBoxes; }
+
+	// Runs the physics and the box set neighbour query for every structure, checks both return the same nodes
+	// and logs the timings (dev key 8)
+	void BenchmarkStructureQueries(int32 Iterations = 10) const;
+
+	// [Rooms] Areas enclosed by walls per floor level, traced lazily around the walls changed since the last query
+	int32 FindRoomAt(const FVector& Location) const;
+	const FOrionRoom* GetRoom(int32 RoomId) const;
+	const FOrionRoomDetector& GetRoomDetector() const;
+
+	// Debugging output next to structure_records.json (Saved/<Filename>)
+	bool ExportRoomsToCsv(const FString& Filename = TEXT("room_summary.csv")) const;
+
+	// [Layout] Captures structures relative to Origin into OutLayout (pieces are appended)
+	void CaptureLayout(TConstArrayView<AActor*> Structures, const FTransform& Origin, UOrionBuildingLayout* OutLayout) const;
+	// Every structure (actor or instance) whose box overlaps Region
+	void CaptureLayoutInBox(const FBox& Region, const FTransform& Origin, UOrionBuildingLayout* OutLayout) const;
+
+	// [Layout] Validates the whole layout at Origin at once (one blocking pass, one stability solve over all pieces),
+	// then spawns it over the next frames within StampBudgetMs, each frame's pieces as one bulk load (the batch never
+	// stays open between frames). Nothing is spawned if any piece is blocked or would not stand.
+	bool StampLayout(const UOrionBuildingLayout* Layout, const FTransform& Origin);
+	bool IsStampingLayout() const { return StampQueue.Num() > 0; }
+
+	static constexpr double StampBudgetMs = 2.0;
 
 	bool BEnableDebugLine = true;
 
 	TUniquePtr<FBuildingObjectsPool> BuildingObjectsPool;
 
 private:
-	// [Grid] Grid size (e.g. 500cm)
-	static constexpr float GridCellSize = 500.f;
-	
-	// [Grid] Core storage: Spatial Hash
-	// Key: Compressed Coordinate Hash
-	// Value: All sockets in this cell (No deduplication, no overwriting)
-	// [UHT Compatible] Use FOrionSocketBucket wrapper for TArray, as UHT doesn't support nested containers
-	UPROPERTY()
-	TMap<int64, FOrionSocketBucket> SpatialGrid;
+	// [Grid] Core storage: Spatial hash partitioned by kind, with owner index (see FOrionSocketRegistry)
+	// Sockets only hold weak owner pointers, so no UPROPERTY is needed
+	FOrionSocketRegistry SocketRegistry;
+
+	bool bSocketBatchOpen = false;
+	TArray<FOrionGlobalSocket> PendingSockets;
 
-	// [Grid] Calculate Key
-	static int64 GetGridKey(const FVector& Location);
+	bool bBulkLoadOpen = false;
+	TArray<TWeakObjectPtr<UOrionStructureComponent>> BulkStructures;
+	TOptional<FNavigationLockContext> BulkNavLock;
+
+	// Wall sockets also accept DoubleWall, SquareFoundation sockets also accept BasicRoof
+	static EOrionStructure GetSocketAliasKind(const EOrionStructure Kind)
+	{
+		switch (Kind)
+		{
+		case EOrionStructure::Wall: return EOrionStructure::DoubleWall;
+		case EOrionStructure::BasicSquareFoundation: return EOrionStructure::BasicRoof;
+		default: return EOrionStructure::None;
+		}
+	}
+
+	// [Stability] Graph + off-thread solver state
+	FOrionStructureGraph StructureGraph;
+	TSet<int32> PendingStabilityRegion;
+	bool bStabilitySolverInFlight = false;
+	bool bStabilitySolveRequested = false;
+
+	int32 HydratingNode = INDEX_NONE;
+
+	void RemoveStructureNodeById(int32 NodeId);
+	// Second AddStructureNode of a linked piece: new box / edges / grounding without a removal. False if the piece
+	// could lose support that way; its node is removed then and has to be added again
+	bool RefreshStructureNode(int32 NodeId, bool bGrounded);
+	// Node, box, occupancy and room wall of a structure leaving the world; reported to the autosave
+	void DropStructureNode(int32 NodeId);
+	// Solve requests of one frame are merged into one solve, started on the next tick
+	void RequestStabilitySolve();
+	void KickStabilitySolver();
+	void OnStabilitySolved(const FOrionStabilityResult& Result);
+	void SyncStabilityToComponents(TConstArrayView<int32> NodeIds) const;
+	void CollapseStructures(TConstArrayView<int32> NodeIds);
+
+	// Graph nodes whose structure box touches Box (FOrionStructureBoxSet::TouchTolerance), instanced structures included.
+	// Used by neighbour lookup, AddStructureNode and preview
+	void FindStructureNodesTouchingBox(const FOrionOrientedBox& Box, int32 IgnoredNode, TArray<int32>& OutNodes) const;
+	// Physics scene version of the same query (WorldStatic overlap, HISM hits mapped to instances), benchmark reference
+	void FindStructureNodesTouchingBoxPhysics(const FOrionOrientedBox& Box, const AActor* IgnoredActor,
+	                                          TArray<int32>& OutNodes) const;
+	// Oriented box around the structure mesh (+ Padding on every side), stored in the box set and occupancy grid
+	static bool GetStructureBox(const AActor* Structure, FOrionOrientedBox& OutBox, float Padding = 0.f);
+	// Same box for a piece of BuildingClass spawned at Transform, from the class' StructureMesh template
+	bool GetStructureBoxForClass(const UClass* BuildingClass, const FTransform& Transform, FOrionOrientedBox& OutBox) const;
+
+	// StructureMesh bounds relative to the actor, per class (invalid: the class has no StructureMesh)
+	struct FOrionClassMeshBounds
+	{
+		FTransform MeshTransform;
+		FVector LocalCenter = FVector::ZeroVector;
+		FVector LocalExtent = FVector::ZeroVector;
+		bool bValid = false;
+	};
+	mutable TMap<TObjectKey<UClass>, FOrionClassMeshBounds> ClassMeshBounds;
+
+	mutable TMap<TObjectKey<UClass>, EOrionStructure> StructureTypeByClass;
+
+	// [Occupancy] Structures keyed by graph node id, plus static obstacles collected on world init
+	FOrionOccupancyGrid OccupancyGrid;
+	void CollectStaticObstacles(const UWorld* World);
+
+	// [Boxes] Same keys as the grid, exact boxes for the structure narrowphase
+	FOrionStructureBoxSet StructureBoxes;
+
+	// [Rooms] Walls keyed by graph node id; mutable: queries flush the pending re-trace
+	mutable FOrionRoomDetector RoomDetector;
+	void UpdateRooms() const;
+
+	mutable FOrionPlacementQueryStats CurrentQueryStats;
+	mutable FOrionPlacementQueryStats LastQueryStats;
+	FOrionPlacementQueryStats& GetCurrentQueryStats() const;
+	EOrionOccupancy CountGridAnswer(EOrionOccupancy Answer) const;
+
+	// [Collapse] Hidden actors waiting for Destroy()
+	TArray<TWeakObjectPtr<AActor>> CollapseQueue;
+	TSet<TObjectKey<AActor>> CollapsingActors;
+	FTimerHandle CollapseTimerHandle;
+	void ProcessCollapseQueue();
+
+	// [Placement] Strict + loose box test shared by ConfirmPlaceStructure and StampLayout
+	bool IsPlacementBlocked(const FVector& Center, const FQuat& Rotation, const FVector& ExtentFull,
+	                        const AActor* IgnoredActor) const;
+
+	// [Layout] Validated pieces waiting to be spawned, supporters first
+	struct FOrionStampPiece
+	{
+		TSubclassOf<AActor> BuildingClass;
+		FTransform Transform;
+	};
+
+	TArray<FOrionStampPiece> StampQueue;
+	int32 StampCursor = 0;
+	TArray<TWeakObjectPtr<AActor>> StampSpawned;
+	FTimerHandle StampTimerHandle;
+	void ProcessStampQueue();
+
+	// Keeps the resolved layout classes loaded until the stamp is done
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> StampClasses;
 
 	void OnWorldInitializedActors(const FActorsInitializedParams& ActorsInitializedParams);
 	virtual void Initialize(FSubsystemCollectionBase&) override;
@@ -293,13 +472,14 @@ public:
 
 			if (Pool.Contains(BuildingId)) continue;
 
-			// 最好在数据资产里直接存 TSubclassOf<AActor>，而不是存字符串路径来 LoadClass
-			// LoadClass 是阻塞加载，如果资产多会卡顿
-			UClass* StructureBPSubclass = LoadClass<AActor>(nullptr, *Each.Value.BuildingBlueprintReference);
+			// 类由 UOrionAssetPreloadManager 异步预加载，这里只取常驻的，不阻塞加载
+			// 预加载完成后会再调用一次本函数补齐
+			UClass* StructureBPSubclass =
+				Cast<UClass>(FSoftObjectPath(Each.Value.BuildingBlueprintReference).ResolveObject());
 
 			if (!StructureBPSubclass)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("FBuildingObjectsPool::InitPreviewStructures: Failed to load class for ID: %d"), BuildingId);
+				UE_LOG(LogTemp, Verbose, TEXT("FBuildingObjectsPool::InitPreviewStructures: Class for ID %d not resident yet"), BuildingId);
 				continue;
 			}
 
@@ -0,0 +1,342 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionBuildingRenderManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionComponents/OrionStructureComponent.h"
+#include "Orion/OrionComponents/OrionAttributeComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+
+const FName UOrionBuildingRenderManager::InstanceComponentTag = TEXT("OrionStructureInstances");
+
+bool UOrionBuildingRenderManager::IsStructureInstanceComponent(const UPrimitiveComponent* Component)
+{
+	return Component && Component->ComponentHasTag(InstanceComponentTag);
+}
+
+UOrionBuildingManager* UOrionBuildingRenderManager::GetBuildingManager() const
+{
+	return GetGameInstance()->GetSubsystem<UOrionBuildingManager>();
+}
+
+AActor* UOrionBuildingRenderManager::GetOrCreateRenderHost()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (AActor* Host = RenderHost.Get(); Host && Host->GetWorld() == World)
+	{
+		return Host;
+	}
+
+	// New world (or the host was destroyed with the old one): every batch / instance went with it
+	ResetInstances();
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	if (!Host)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UOrionBuildingRenderManager::GetOrCreateRenderHost: Failed to spawn render host."));
+		return nullptr;
+	}
+
+	USceneComponent* Root = NewObject<USceneComponent>(Host, TEXT("Root"));
+	Host->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	RenderHost = Host;
+	return Host;
+}
+
+int32 UOrionBuildingRenderManager::FindOrAddBatch(const TSubclassOf<AActor> BuildingClass,
+                                                  const UStaticMeshComponent* SourceMesh)
+{
+	// Host first: a stale host (world change) drops every batch
+	AActor* Host = GetOrCreateRenderHost();
+	if (!Host)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* BatchIndex = BatchByClass.Find(BuildingClass.Get()))
+	{
+		return *BatchIndex;
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* HISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(
+		Host, *FString::Printf(TEXT("HISM_%s"), *BuildingClass->GetName()));
+
+	HISM->SetStaticMesh(SourceMesh->GetStaticMesh());
+	for (int32 i = 0; i < SourceMesh->GetNumMaterials(); ++i)
+	{
+		HISM->SetMaterial(i, SourceMesh->GetMaterial(i));
+	}
+
+	// Same collision as the actor mesh: placement tests, neighbour overlaps and cursor traces keep working
+	HISM->SetCollisionProfileName(SourceMesh->GetCollisionProfileName());
+	HISM->bSupportRemoveAtSwap = true; // Removal moves the last instance into the hole, see RemoveFromBatch
+	HISM->ComponentTags.Add(InstanceComponentTag);
+
+	HISM->SetupAttachment(Host->GetRootComponent());
+	HISM->RegisterComponent();
+	Host->AddInstanceComponent(HISM);
+
+	FOrionStructureBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.BuildingClass = BuildingClass;
+	Batch.Component = HISM;
+
+	const int32 BatchIndex = Batches.Num() - 1;
+	BatchByClass.Add(BuildingClass.Get(), BatchIndex);
+	return BatchIndex;
+}
+
+int32 UOrionBuildingRenderManager::InstanceStructure(AActor* StructureActor)
+{
+	if (!IsValid(StructureActor))
+	{
+		return INDEX_NONE;
+	}
+
+	UOrionStructureComponent* StructureComp = StructureActor->FindComponentByClass<UOrionStructureComponent>();
+	if (!StructureComp || StructureComp->BIsPreviewStructure || !StructureComp->StructureMesh ||
+		!StructureComp->StructureMesh->GetStaticMesh())
+	{
+		return INDEX_NONE;
+	}
+
+	UOrionBuildingManager* BuildingManager = GetBuildingManager();
+	if (!BuildingManager || BuildingManager->IsSocketBatchOpen())
+	{
+		// Buffered sockets are not in the grid yet, instance after EndSocketBatch
+		UE_LOG(LogTemp, Warning, TEXT("UOrionBuildingRenderManager::InstanceStructure: Socket batch open, %s kept as actor."),
+		       *StructureActor->GetName());
+		return INDEX_NONE;
+	}
+
+	const int32 BatchIndex = FindOrAddBatch(StructureActor->GetClass(), StructureComp->StructureMesh);
+	if (BatchIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	/* 1. Gameplay data */
+	FOrionStructureInstance Instance;
+	Instance.BuildingClass = StructureActor->GetClass();
+	Instance.StructureType = StructureComp->OrionStructureType;
+	Instance.Transform = StructureActor->GetActorTransform();
+	Instance.BatchIndex = BatchIndex;
+	Instance.Stability = StructureComp->CurrentStability;
+
+	if (const UOrionAttributeComponent* Attr = UOrionAttributeComponent::FindOnActor(StructureActor))
+	{
+		Instance.Health = Attr->Health;
+		Instance.MaxHealth = Attr->MaxHealth;
+		Instance.Faction = Attr->ActorFaction;
+	}
+
+	// Node and sockets are handed over untouched: no re-solve, neighbours can still snap to it
+	Instance.GraphNode = BuildingManager->DetachStructureNode(StructureComp);
+	BuildingManager->DetachSockets(StructureActor, RenderHost.Get(), Instance.SocketIds);
+
+	/* 2. Render instance */
+	FOrionStructureBatch& Batch = Batches[BatchIndex];
+	Instance.InstanceIndex = Batch.Component->AddInstance(StructureComp->StructureMesh->GetComponentTransform(),
+	                                                      /*bWorldSpace=*/true);
+
+	const int32 Handle = Instances.Add(MoveTemp(Instance));
+	Batch.InstanceHandles.Add(Handle);
+	check(Batch.InstanceHandles.Num() == Batch.Component->GetInstanceCount());
+
+	if (Instances[Handle].GraphNode != INDEX_NONE)
+	{
+		InstanceByNode.Add(Instances[Handle].GraphNode, Handle);
+	}
+
+	/* 3. The actor itself is no longer needed (its EndPlay finds neither sockets nor node) */
+	StructureActor->Destroy();
+
+	return Handle;
+}
+
+void UOrionBuildingRenderManager::InstanceStructures(const TConstArrayView<AActor*> StructureActors)
+{
+	int32 NumInstanced = 0;
+	for (AActor* StructureActor : StructureActors)
+	{
+		NumInstanced += InstanceStructure(StructureActor) != INDEX_NONE ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BuildingRender] Instanced %d / %d structures (%d batches, %d instances total)."),
+	       NumInstanced, StructureActors.Num(), Batches.Num(), Instances.Num());
+}
+
+void UOrionBuildingRenderManager::RemoveFromBatch(FOrionStructureInstance& Instance)
+{
+	if (!Batches.IsValidIndex(Instance.BatchIndex))
+	{
+		return;
+	}
+
+	FOrionStructureBatch& Batch = Batches[Instance.BatchIndex];
+	const int32 InstanceIndex = Instance.InstanceIndex;
+
+	if (Batch.Component)
+	{
+		Batch.Component->RemoveInstance(InstanceIndex);
+	}
+
+	// Same swap-remove as the HISM: the last instance now lives at InstanceIndex
+	Batch.InstanceHandles.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+	if (Batch.InstanceHandles.IsValidIndex(InstanceIndex))
+	{
+		Instances[Batch.InstanceHandles[InstanceIndex]].InstanceIndex = InstanceIndex;
+	}
+
+	Instance.InstanceIndex = INDEX_NONE;
+}
+
+void UOrionBuildingRenderManager::RemoveInstance(const int32 Handle)
+{
+	if (!Instances.IsValidIndex(Handle))
+	{
+		return;
+	}
+
+	FOrionStructureInstance& Instance = Instances[Handle];
+
+	if (UOrionBuildingManager* BuildingManager = GetBuildingManager())
+	{
+		BuildingManager->UnregisterSocketIds(Instance.SocketIds);
+	}
+
+	RemoveFromBatch(Instance);
+	InstanceByNode.Remove(Instance.GraphNode);
+	Instances.RemoveAt(Handle);
+}
+
+AActor* UOrionBuildingRenderManager::HydrateInstance(const int32 Handle)
+{
+	UWorld* World = GetWorld();
+	UOrionBuildingManager* BuildingManager = GetBuildingManager();
+	if (!World || !BuildingManager || !Instances.IsValidIndex(Handle))
+	{
+		return nullptr;
+	}
+
+	const FOrionStructureInstance Instance = Instances[Handle];
+
+	/* 1. Drop the instance; the actor registers its own sockets in BeginPlay */
+	BuildingManager->UnregisterSocketIds(Instance.SocketIds);
+	RemoveFromBatch(Instances[Handle]);
+	InstanceByNode.Remove(Instance.GraphNode);
+	Instances.RemoveAt(Handle);
+
+	/* 2. Spawn, the actor's AddStructureNode takes the existing node back (edges and values kept) */
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	BuildingManager->BeginStructureHydration(Instance.GraphNode);
+	AActor* Actor = World->SpawnActor<AActor>(Instance.BuildingClass, Instance.Transform, Params);
+	BuildingManager->EndStructureHydration();
+
+	if (!Actor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UOrionBuildingRenderManager::HydrateInstance: SpawnActor failed (class: %s)."),
+		       *GetNameSafe(Instance.BuildingClass));
+		return nullptr;
+	}
+
+	Actor->SetActorScale3D(Instance.Transform.GetScale3D());
+
+	// Same fix-up as DelaySpawnNewStructure: sockets from BeginPlay may predate the final transform
+	if (const UOrionStructureComponent* StructureComp = Actor->FindComponentByClass<UOrionStructureComponent>())
+	{
+		BuildingManager->UnregisterSockets(Actor);
+		StructureComp->SocketsRegistryHandler();
+	}
+
+	if (UOrionAttributeComponent* Attr = UOrionAttributeComponent::FindOnActor(Actor))
+	{
+		Attr->SetActorFaction(Instance.Faction);
+		Attr->SetHealth(Instance.Health);
+	}
+
+	return Actor;
+}
+
+AActor* UOrionBuildingRenderManager::HydrateFromHit(const FHitResult& Hit)
+{
+	if (!IsStructureInstanceComponent(Hit.GetComponent()))
+	{
+		return nullptr;
+	}
+
+	return HydrateInstance(FindInstance(Hit.GetComponent(), Hit.Item));
+}
+
+int32 UOrionBuildingRenderManager::FindInstance(const UPrimitiveComponent* Component, const int32 InstanceIndex) const
+{
+	// One batch per building class, a linear scan is fine
+	for (const FOrionStructureBatch& Batch : Batches)
+	{
+		if (Batch.Component == Component)
+		{
+			return Batch.InstanceHandles.IsValidIndex(InstanceIndex) ? Batch.InstanceHandles[InstanceIndex] : INDEX_NONE;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void UOrionBuildingRenderManager::SetInstanceStability(const int32 Handle, const float Stability)
+{
+	if (Instances.IsValidIndex(Handle))
+	{
+		Instances[Handle].Stability = Stability;
+	}
+}
+
+void UOrionBuildingRenderManager::CollectStructureRecords(TArray<FOrionStructureRecord>& Out) const
+{
+	const FOrionStructureGraph& Graph = GetBuildingManager()->GetStructureGraph();
+
+	Out.Reserve(Out.Num() + Instances.Num());
+	for (const FOrionStructureInstance& Instance : Instances)
+	{
+		const uint32 StructureId = Graph.IsValidNode(Instance.GraphNode) ? Graph.GetNode(Instance.GraphNode).StructureId : 0;
+		Out.Emplace(Instance.BuildingClass->GetPathName(), Instance.Transform, StructureId);
+	}
+}
+
+void UOrionBuildingRenderManager::ResetInstances()
+{
+	for (const FOrionStructureBatch& Batch : Batches)
+	{
+		if (IsValid(Batch.Component))
+		{
+			Batch.Component->ClearInstances();
+		}
+	}
+
+	for (FOrionStructureBatch& Batch : Batches)
+	{
+		Batch.InstanceHandles.Reset();
+	}
+
+	Instances.Empty();
+	InstanceByNode.Empty();
+
+	// Batches (HISM components) are kept for reuse unless the host went away with its world
+	if (!RenderHost.IsValid() || RenderHost->GetWorld() != GetWorld())
+	{
+		Batches.Reset();
+		BatchByClass.Reset();
+		RenderHost.Reset();
+	}
+}
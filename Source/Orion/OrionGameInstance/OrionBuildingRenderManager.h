@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "Orion/OrionGameInstance/OrionFactionManager.h"
+#include "OrionBuildingRenderManager.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UOrionBuildingManager;
+
+// 已实例化（无 Actor）的建筑：只保留玩法数据，渲染由所在批次的 HISM 负责
+struct FOrionStructureInstance
+{
+	TSubclassOf<AActor> BuildingClass;
+	EOrionStructure StructureType = EOrionStructure::None;
+	FTransform Transform; // Actor transform, used for hydration and saving
+
+	int32 BatchIndex = INDEX_NONE;
+	int32 InstanceIndex = INDEX_NONE; // Index inside the batch HISM, patched on swap-remove
+
+	// Gameplay data taken over from the actor
+	int32 GraphNode = INDEX_NONE;     // Node in UOrionBuildingManager's structure graph (unbound, no component)
+	TArray<int32> SocketIds;          // Sockets detached from the actor, still snappable
+	float Stability = 0.f;
+	float Health = 0.f;
+	float MaxHealth = 0.f;
+	EFaction Faction = EFaction::PlayerFaction;
+};
+
+// One HISM per building class
+USTRUCT()
+struct FOrionStructureBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AActor> BuildingClass;
+
+	UPROPERTY()
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Component = nullptr;
+
+	// Instance handle per HISM instance index
+	TArray<int32> InstanceHandles;
+};
+
+/**
+ * Instanced rendering for placed structures.
+ *
+ * Placed / loaded structures are "dehydrated": their mesh becomes an instance of a per-class HISM on a single
+ * render host actor, gameplay data moves into an FOrionStructureInstance record, and the actor is destroyed.
+ * Graph node and sockets are handed over as-is, so stability and snapping do not notice the difference.
+ * A full actor is spawned back ("hydrated") only for interaction or destruction.
+ * Draw calls and actor count scale with the number of building classes instead of the number of pieces.
+ */
+UCLASS()
+class ORION_API UOrionBuildingRenderManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Tag on every instance HISM, so traces can tell instanced structures from terrain
+	static const FName InstanceComponentTag;
+
+	static bool IsStructureInstanceComponent(const UPrimitiveComponent* Component);
+
+	// Placed and loaded structures are instanced automatically while enabled
+	bool bInstanceStructures = true;
+
+	/* Actor -> instance. Returns the instance handle, INDEX_NONE if the actor can't be instanced (actor is kept) */
+	int32 InstanceStructure(AActor* StructureActor);
+	void InstanceStructures(TConstArrayView<AActor*> StructureActors);
+
+	/* Instance -> actor, for interaction or destruction. Returns the spawned actor */
+	AActor* HydrateInstance(int32 Handle);
+	AActor* HydrateFromHit(const FHitResult& Hit);
+
+	/* Removes an instance without an actor (collapse). The graph node is removed by the caller */
+	void RemoveInstance(int32 Handle);
+
+	int32 FindInstance(const UPrimitiveComponent* Component, int32 InstanceIndex) const;
+
+	int32 FindInstanceByNode(const int32 NodeId) const
+	{
+		const int32* Handle = InstanceByNode.Find(NodeId);
+		return Handle ? *Handle : INDEX_NONE;
+	}
+
+	const FOrionStructureInstance* GetInstance(const int32 Handle) const
+	{
+		return Instances.IsValidIndex(Handle) ? &Instances[Handle] : nullptr;
+	}
+
+	void SetInstanceStability(int32 Handle, float Stability);
+
+	/* Instanced structures are part of the save just like actors */
+	void CollectStructureRecords(TArray<FOrionStructureRecord>& Out) const;
+
+	/* Drops every instance (called with UOrionBuildingManager::ResetAllSockets before loading) */
+	void ResetInstances();
+
+	int32 GetNumInstances() const { return Instances.Num(); }
+	int32 GetNumBatches() const { return Batches.Num(); }
+
+private:
+	UOrionBuildingManager* GetBuildingManager() const;
+
+	AActor* GetOrCreateRenderHost();
+	int32 FindOrAddBatch(TSubclassOf<AActor> BuildingClass, const UStaticMeshComponent* SourceMesh);
+	void RemoveFromBatch(FOrionStructureInstance& Instance);
+
+	TWeakObjectPtr<AActor> RenderHost;
+
+	UPROPERTY()
+	TArray<FOrionStructureBatch> Batches;
+
+	TMap<TObjectKey<UClass>, int32> BatchByClass;
+
+	TSparseArray<FOrionStructureInstance> Instances;
+	TMap<int32, int32> InstanceByNode;
+};
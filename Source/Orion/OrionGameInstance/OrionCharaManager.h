@@ -9,8 +9,11 @@
 #include "Orion/OrionChara/OrionChara.h"
 #include "Orion/OrionComponents/OrionActionComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Serialization/BufferArchive.h"
 #include "Orion/OrionComponents/OrionCombatComponent.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionSaveGame/OrionSaveNameTable.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "OrionCharaManager.generated.h"
 
@@ -68,40 +71,64 @@ public:
 
 	static TArray<FOrionCharaSerializable> TestCharactersSet;
 
-	void CollectCharacterRecords(TArray<FOrionCharaSerializable>& OutRecords)
+	void CollectCharacterRecords(TArray<FOrionCharaSerializable>& OutRecords, FOrionSaveNameTableBuilder& Names)
 	{
 		OutRecords.Empty();
 
+		/* ① 游戏线程：收集角色和普通字段（位置、动作参数） */
+		TArray<UObject*> Objects;
 		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : GlobalCharaMap)
 		{
 			if (AOrionChara* Chara = Pair.Value.Get())
 			{
-				FBufferArchive MemWriter;
-				FObjectAndNameAsStringProxyArchive Ar(MemWriter, /*bLoadIn=*/false);
-				Ar.ArIsSaveGame = true;
+				OutRecords.Add(GatherCharaRecord(Chara));
+				Objects.Add(Chara);
+			}
+		}
 
-				Chara->Serialize(Ar);
+		/* ② SaveGame 属性先在游戏线程快照，名字表索引在工作线程上并行编码，按记录顺序合并 */
+		TArray<TArray<uint8>> Bytes;
+		FOrionNameTableArchive::WriteObjects(Objects, Names, Bytes);
+		for (int32 i = 0; i < OutRecords.Num(); ++i)
+		{
+			OutRecords[i].SerializedBytes = MoveTemp(Bytes[i]);
+			OutRecords[i].bUsesNameTable = true;
+		}
+	}
 
-				FOrionCharaSerializable S;
+	/* 单个角色的存档记录（增量存档也用） */
+	static FOrionCharaSerializable MakeCharaRecord(AOrionChara* Chara, FOrionSaveNameTableBuilder& Names)
+	{
+		FOrionCharaSerializable S = GatherCharaRecord(Chara);
 
-				S.CharaGameId = Chara->GameSerializable.GameId;
-				S.CharaLocation = Chara->GetActorLocation();
-				S.CharaRotation = Chara->GetActorRotation();
-				S.SerializedBytes = MemWriter;
+		FOrionNameTableArchive::WriteObject(*Chara, Names, S.SerializedBytes);
+		S.bUsesNameTable = true;
 
-				if (Chara->ActionComp)
-				{
-					for (const FOrionAction& Act : Chara->ActionComp->ProceduralActionQueue.Actions)
-					{
-						S.SerializedProcActions.Add(Act.Params);
-					}
-				}
+		return S;
+	}
 
-				OutRecords.Add(MoveTemp(S));
+	/* 记录里除 SerializedBytes 以外的字段 */
+	static FOrionCharaSerializable GatherCharaRecord(const AOrionChara* Chara)
+	{
+		FOrionCharaSerializable S;
+
+		S.CharaGameId = Chara->GameSerializable.GameId;
+		S.CharaLocation = Chara->GetActorLocation();
+		S.CharaRotation = Chara->GetActorRotation();
+
+		if (Chara->ActionComp)
+		{
+			for (const FOrionAction& Act : Chara->ActionComp->ProceduralActionQueue.Actions)
+			{
+				S.SerializedProcActions.Add(Act.Params);
 			}
 		}
+
+		return S;
 	}
 
+	const TMap<FGuid, TWeakObjectPtr<AOrionChara>>& GetAllCharas() const { return GlobalCharaMap; }
+
 	void RemoveAllCharacters(UWorld* World)
 	{
 		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : GlobalCharaMap)
@@ -114,36 +141,37 @@ public:
 		GlobalCharaMap.Empty();
 	}
 
+	/* 差量读档：GameId 对得上的角色原地写回，存档里没有的销毁，只 Spawn 新增的 */
 	void LoadAllCharacters(UWorld* World,
-	                       const TArray<FOrionCharaSerializable>& Saved)
+	                       const TArray<FOrionCharaSerializable>& Saved,
+	                       const FOrionSaveNameTable& Names,
+	                       const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
 	{
 		if (!World)
 		{
 			return;
 		}
 
-		GlobalCharaMap.Empty();
+		TMap<FGuid, AOrionChara*> Reusable;
+		TArray<AOrionChara*> Stale;
+		MatchLiveCharacters(Saved, Reusable, Stale);
+
+		for (AOrionChara* Chara : Stale)
+		{
+			Chara->Destroy();
+		}
+		// Every reused character stays resolvable while the records are applied
+		RetainCharas(Reusable);
 
 		/* ----------① Spawn & Register（暂不恢复动作）---------- */
 		TMap<FGuid, AOrionChara*> SpawnedMap;
 
 		for (const FOrionCharaSerializable& S : Saved)
 		{
-			if (AOrionChara* Chara = SpawnOrionChara(S.CharaLocation, S.CharaRotation))
+			AOrionChara* const* Existing = Reusable.Find(S.CharaGameId);
+			if (AOrionChara* Chara = Existing ? ApplyCharaRecord(*Existing, S, Names, ResolveGameId)
+			                                  : LoadCharacter(S, Names, ResolveGameId))
 			{
-				/* ① 基本标识 */
-				Chara->GameSerializable.GameId = S.CharaGameId;
-
-				/* ★② 反序列化 SaveGame 字节数组 —— 把存档属性写回对象 ★ */
-				{
-					FMemoryReader MemReader(S.SerializedBytes);
-					FObjectAndNameAsStringProxyArchive Ar(MemReader, /*bLoadIn=*/true);
-					Ar.ArIsSaveGame = true; // 只恢复带 SaveGame 标记的属性
-					Chara->Serialize(Ar); // ← 这里会把 IsCharaProceduralInInit 等还原
-				}
-
-				/* ③ 注册到全局表 */
-				RegisterChara(Chara);
 				SpawnedMap.Add(S.CharaGameId, Chara);
 			}
 		}
@@ -156,21 +184,121 @@ public:
 				RecoverProcActions(*CharaPtr, S);
 			}
 		}
+
+		UE_LOG(LogTemp, Log, TEXT("[Load] Characters: %d reused, %d spawned, %d destroyed."),
+		       Reusable.Num(), SpawnedMap.Num() - Reusable.Num(), Stale.Num());
+	}
+
+	/* 差量读档：注册表只留下原地复用的角色（存档里没有的条目去掉），应用记录期间它们一直可以按 GameId 解析 */
+	template <typename TCharaPtr>
+	void RetainCharas(const TMap<FGuid, TCharaPtr>& Reused)
+	{
+		GlobalCharaMap.Reset();
+		for (const TPair<FGuid, TCharaPtr>& Pair : Reused)
+		{
+			GlobalCharaMap.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	/* 差量读档的匹配：已注册且存档里有记录的角色进 OutReusable，其余已注册的进 OutStale */
+	void MatchLiveCharacters(const TArray<FOrionCharaSerializable>& Saved,
+	                         TMap<FGuid, AOrionChara*>& OutReusable,
+	                         TArray<AOrionChara*>& OutStale) const
+	{
+		TSet<FGuid> SavedIds;
+		SavedIds.Reserve(Saved.Num());
+		for (const FOrionCharaSerializable& S : Saved)
+		{
+			SavedIds.Add(S.CharaGameId);
+		}
+
+		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : GlobalCharaMap)
+		{
+			if (AOrionChara* Chara = Pair.Value.Get())
+			{
+				if (SavedIds.Contains(Pair.Key))
+				{
+					OutReusable.Add(Pair.Key, Chara);
+				}
+				else
+				{
+					OutStale.Add(Chara);
+				}
+			}
+		}
+	}
+
+	/* 存档记录写回已存在的角色：不销毁、不重新 Spawn，动作队列清空（之后由 RecoverProcActions 恢复） */
+	AOrionChara* ApplyCharaRecord(AOrionChara* Chara,
+	                              const FOrionCharaSerializable& S,
+	                              const FOrionSaveNameTable& Names,
+	                              const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
+	{
+		if (Chara->ActionComp)
+		{
+			Chara->ActionComp->RemoveAllActions();
+		}
+		if (UCharacterMovementComponent* Movement = Chara->GetCharacterMovement())
+		{
+			Movement->StopMovementImmediately();
+		}
+		Chara->SetActorLocationAndRotation(S.CharaLocation, S.CharaRotation, false, nullptr,
+		                                   ETeleportType::TeleportPhysics);
+
+		FOrionNameTableArchive::ResetSaveGameProperties(*Chara);
+		FOrionNameTableArchive::ReadObject(*Chara, S.SerializedBytes, S.bUsesNameTable, Names, ResolveGameId);
+
+		Chara->GameSerializable.GameId = S.CharaGameId;
+		RegisterChara(Chara);
+		return Chara;
+	}
+
+	/* 单个角色：Spawn + 存档属性 + 注册（动作另由 RecoverProcActions 恢复，分帧读档也用） */
+	AOrionChara* LoadCharacter(const FOrionCharaSerializable& S,
+	                           const FOrionSaveNameTable& Names,
+	                           const FOrionNameTableArchive::FResolveGameId& ResolveGameId)
+	{
+		AOrionChara* Chara = SpawnOrionChara(S.CharaLocation, S.CharaRotation);
+		if (!Chara)
+		{
+			return nullptr;
+		}
+
+		/* ① 基本标识 */
+		Chara->GameSerializable.GameId = S.CharaGameId;
+
+		/* ★② 反序列化 SaveGame 字节数组 —— 把存档属性写回对象 ★ */
+		// 只恢复带 SaveGame 标记的属性，这里会把 IsCharaProceduralInInit 等还原
+		FOrionNameTableArchive::ReadObject(*Chara, S.SerializedBytes, S.bUsesNameTable, Names, ResolveGameId);
+
+		/* ③ 注册到全局表 */
+		RegisterChara(Chara);
+		return Chara;
 	}
 
+	/* 动作目标要在所有角色 / Actor 生成后才能解析 */
+	void RecoverProcActions(AOrionChara* Chara,
+	                        const FOrionCharaSerializable& S);
+
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override
 	{
 		Super::Initialize(Collection);
 
-		CharacterBPClass = LoadObject<UClass>(
-			nullptr,
-			TEXT("/Game/_Orion/Blueprints/OrionCharacter.OrionCharacter_C"));
+		// 角色蓝图由 UOrionAssetPreloadManager 异步加载，完成后再取
+		UOrionAssetPreloadManager* PreloadManager = Collection.InitializeDependency<UOrionAssetPreloadManager>();
+		check(PreloadManager);
 
-		if (!CharacterBPClass)
+		PreloadManager->CallWhenPreloaded(FSimpleDelegate::CreateWeakLambda(this, [this, PreloadManager]()
 		{
-			UE_LOG(LogTemp, Error,
-			       TEXT("[OrionCharaManager] Failed to load CharacterBPClass!"));
-		}
+			CharacterBPClass = PreloadManager->FindOrLoadClass<AOrionChara>(
+				UOrionAssetPreloadManager::CharacterBlueprintPath);
+
+			if (!CharacterBPClass)
+			{
+				UE_LOG(LogTemp, Error,
+				       TEXT("[OrionCharaManager] Failed to load CharacterBPClass!"));
+			}
+		}));
 	}
 
 	FORCEINLINE AOrionChara* FindCharaById(const FGuid& Id) const
@@ -379,9 +507,6 @@ private:
 		}
 	}
 
-	void RecoverProcActions(AOrionChara* Chara,
-	                        const FOrionCharaSerializable& S);
-
 	/** 内部统一的添加动作出口 */
 	bool Internal_AddAction(AOrionChara* Chara, const FOrionAction& Action,
 	                        EActionExecution ExecutionType, int32 Index);
@@ -25,6 +25,8 @@ void UOrionFactionManager::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	InitFactionRelations();
+
 	FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UOrionFactionManager::OnWorldInitializedActors);
 }
 
@@ -165,10 +167,75 @@ bool UOrionFactionManager::DeduceFactionResources(const EFaction Faction, const
 
 
 
-bool UOrionFactionManager::IsHostile(const EFaction FactionA, const EFaction FactionB) const
+void UOrionFactionManager::InitFactionRelations()
 {
-	// Currently simple logic: different factions are hostile
-	return FactionA != FactionB;
+	static_assert(static_cast<int32>(EFaction::Vagrants) < MaxFactions, "EFaction does not fit into the relation bitmask.");
+
+	FMemory::Memzero(HostileMasks);
+	FMemory::Memzero(AlliedMasks);
+
+	// Default: a faction is allied with itself and hostile to every other faction
+	const UEnum* FactionEnum = StaticEnum<EFaction>();
+	const int32 NumFactions = FactionEnum->NumEnums() - 1; // Skip generated _MAX
+
+	for (int32 A = 0; A < NumFactions; ++A)
+	{
+		for (int32 B = 0; B < NumFactions; ++B)
+		{
+			const EFaction FactionA = static_cast<EFaction>(FactionEnum->GetValueByIndex(A));
+			const EFaction FactionB = static_cast<EFaction>(FactionEnum->GetValueByIndex(B));
+			SetFactionRelation(FactionA, FactionB, FactionA == FactionB ? EFactionRelation::Allied : EFactionRelation::Hostile);
+		}
+	}
+}
+
+EFactionRelation UOrionFactionManager::GetFactionRelation(const EFaction FactionA, const EFaction FactionB) const
+{
+	if (IsHostile(FactionA, FactionB))
+	{
+		return EFactionRelation::Hostile;
+	}
+	if (IsAllied(FactionA, FactionB))
+	{
+		return EFactionRelation::Allied;
+	}
+	return EFactionRelation::Neutral;
+}
+
+void UOrionFactionManager::SetFactionRelation(const EFaction FactionA, const EFaction FactionB, const EFactionRelation Relation)
+{
+	const uint8 A = static_cast<uint8>(FactionA);
+	const uint8 B = static_cast<uint8>(FactionB);
+	const uint32 BitA = GetFactionBit(FactionA);
+	const uint32 BitB = GetFactionBit(FactionB);
+
+	HostileMasks[A] &= ~BitB;
+	HostileMasks[B] &= ~BitA;
+	AlliedMasks[A] &= ~BitB;
+	AlliedMasks[B] &= ~BitA;
+
+	if (Relation == EFactionRelation::Hostile)
+	{
+		HostileMasks[A] |= BitB;
+		HostileMasks[B] |= BitA;
+	}
+	else if (Relation == EFactionRelation::Allied)
+	{
+		AlliedMasks[A] |= BitB;
+		AlliedMasks[B] |= BitA;
+	}
+}
+
+uint32 UOrionFactionManager::GetHostileMaskForSet(uint32 FactionSetMask) const
+{
+	uint32 Result = 0;
+	while (FactionSetMask)
+	{
+		const uint32 Index = FMath::CountTrailingZeros(FactionSetMask);
+		Result |= HostileMasks[Index];
+		FactionSetMask &= FactionSetMask - 1;
+	}
+	return Result;
 }
 
 void UOrionFactionManager::InitFactions()
@@ -17,6 +17,14 @@ enum class EFaction : uint8
 	Vagrants UMETA(DisplayName = "Vagrants"),
 };
 
+UENUM(BlueprintType)
+enum class EFactionRelation : uint8
+{
+	Neutral UMETA(DisplayName = "Neutral"),
+	Allied UMETA(DisplayName = "Allied"),
+	Hostile UMETA(DisplayName = "Hostile"),
+};
+
 struct FFaction
 {
 	const EFaction Faction;
@@ -47,8 +55,40 @@ public:
 	static const TMap<int32, TArray<TPair<int32, int32>>> BuildingCostMap;
 	bool AffordBuildingCost(int32 BuildingId);
 
+	/* Relation Matrix: one bitmask row per faction, bit N set = relation holds towards faction N */
+
+	static constexpr int32 MaxFactions = 32;
+
+	static uint32 GetFactionBit(const EFaction Faction)
+	{
+		return 1u << static_cast<uint32>(Faction);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "OrionFactionManager")
+	bool IsHostile(const EFaction FactionA, const EFaction FactionB) const
+	{
+		return (HostileMasks[static_cast<uint8>(FactionA)] & GetFactionBit(FactionB)) != 0;
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "OrionFactionManager")
-	bool IsHostile(const EFaction FactionA, const EFaction FactionB) const;
+	bool IsAllied(const EFaction FactionA, const EFaction FactionB) const
+	{
+		return (AlliedMasks[static_cast<uint8>(FactionA)] & GetFactionBit(FactionB)) != 0;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "OrionFactionManager")
+	EFactionRelation GetFactionRelation(const EFaction FactionA, const EFaction FactionB) const;
+
+	/* Symmetric, can be changed at runtime (alliances, betrayals ...) */
+	UFUNCTION(BlueprintCallable, Category = "OrionFactionManager")
+	void SetFactionRelation(const EFaction FactionA, const EFaction FactionB, const EFactionRelation Relation);
+
+	/* "Hostile to me" test against a cached faction bit: (GetHostileMask(Mine) & Other->FactionBit) != 0 */
+	uint32 GetHostileMask(const EFaction Faction) const { return HostileMasks[static_cast<uint8>(Faction)]; }
+	uint32 GetAlliedMask(const EFaction Faction) const { return AlliedMasks[static_cast<uint8>(Faction)]; }
+
+	/* Batched query: every faction hostile to at least one faction of the set, for spatial filtering */
+	uint32 GetHostileMaskForSet(uint32 FactionSetMask) const;
 
 private:
 
@@ -62,5 +102,10 @@ private:
 
 	UPROPERTY() UOrionInventoryManager* InventoryManager;
 
+	void InitFactionRelations();
+
+	uint32 HostileMasks[MaxFactions] = {};
+	uint32 AlliedMasks[MaxFactions] = {};
+
 
 };
@@ -14,9 +14,19 @@
 #include "IDesktopPlatform.h"
 #include "OrionActorManager.h"
 #include "OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Orion/OrionSaveGame/OrionSaveContainer.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
 #include "Serialization/BufferArchive.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/MemoryWriter.h"
+#include "Orion/OrionSaveGame/OrionStructureRecordCodec.h"
+#include "Orion/OrionSaveGame/OrionStructureJson.h"
 
 class FSaveGameArchive : public FObjectAndNameAsStringProxyArchive
 {
@@ -58,39 +68,22 @@ void UOrionGameInstance::SaveGameWithDialog()
 	}
 	FString SavePath = OutFiles[0];
 
-	/* ② 组装 SaveGame 对象 */
+	/* ② 组装 SaveGame 对象（游戏线程上只做记录快照） */
 	UOrionSaveGame* SaveObj = Cast<UOrionSaveGame>(
 		UGameplayStatics::CreateSaveGameObject(UOrionSaveGame::StaticClass()));
 
+	const double SnapshotStart = FPlatformTime::Seconds();
+
 	// 把你现有的收集函数搬过来
-	SaveAllCharacters(SaveObj);
+	FOrionSaveNameTableBuilder Names;
+	SaveAllCharacters(SaveObj, Names);
 	SaveAllBuildings(SaveObj);
+	Names.TakeNewEntries(SaveObj->NameTable);
 
-	/* ③ 序列化到内存 */
-	FBufferArchive MemWriter;
-	FSaveGameArchive ProxyAr(MemWriter, /*bIsSave=*/true);
-
-	SaveObj->Serialize(ProxyAr); // <- 核心一步
-
-	if (MemWriter.Num() == 0)
-	{
-		UE_LOG(LogTemp, Error, TEXT("[Save] Serialize produced 0 bytes!"));
-		return;
-	}
-
-	/* ④ 写文件 */
-	if (FFileHelper::SaveArrayToFile(MemWriter, *SavePath))
-	{
-		UE_LOG(LogTemp, Log, TEXT("[Save] OK  ->  %s  (%d bytes)"),
-		       *SavePath, MemWriter.Num());
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("[Save] FAILED to write %s"), *SavePath);
-	}
+	UE_LOG(LogTemp, Log, TEXT("[Save] Snapshot took %.2f ms"), (FPlatformTime::Seconds() - SnapshotStart) * 1000.0);
 
-	MemWriter.FlushCache();
-	MemWriter.Empty();
+	/* ③ 序列化 + 压缩 + 写文件在后台线程 */
+	WriteSaveAsync(SaveObj, SavePath);
 }
 
 /* ====================================================
@@ -124,102 +117,43 @@ void UOrionGameInstance::LoadGameWithDialog()
 	}
 	FString LoadPath = OutFiles[0];
 
-	/* ① 读文件到内存 */
-	TArray<uint8> FileData;
-	if (!FFileHelper::LoadFileToArray(FileData, *LoadPath))
-	{
-		UE_LOG(LogTemp, Error, TEXT("[Load] Cannot read file %s"), *LoadPath);
-		return;
-	}
-
-	/* ② 反序列化 */
-	FMemoryReader MemReader(FileData);
-	FSaveGameArchive ProxyAr(MemReader, /*bIsSave=*/false);
-
-	UOrionSaveGame* LoadObj = NewObject<UOrionSaveGame>();
-	LoadObj->Serialize(ProxyAr);
-
-	MemReader.FlushCache();
-	MemReader.Close();
-
+	/* ①② 读文件 + 反序列化 */
+	UOrionSaveGame* LoadObj = ReadSaveFile(LoadPath);
 	if (!LoadObj)
-	{
-		UE_LOG(LogTemp, Error, TEXT("[Load] Deserialize failed!"));
-		return;
-	}
-
-	/* ③ 用自己原先的逻辑恢复世界 */
-	UWorld* World = GetWorld();
-	if (!World)
 	{
 		return;
 	}
 
-	LoadAllCharacters(LoadObj, World);
-	LoadAllBuildings(LoadObj, World);
+	/* ③ 与快速读档同一路径：异步预加载类，再分帧恢复世界 */
+	RestoreFromSave(LoadObj);
 
-	UE_LOG(LogTemp, Log, TEXT("[Load] OK  <-  %s"), *LoadPath);
+	UE_LOG(LogTemp, Log, TEXT("[Load] Restoring  <-  %s"), *LoadPath);
 }
 
 bool SaveStructureRecordsToJsonFile_Manual(
 	const TArray<FOrionStructureRecord>& Records,
 	const FString& Filename)
 {
-	// 1) Write array marker at the beginning
-	FString JsonOut = TEXT("[\n");
-
-	for (int32 i = 0; i < Records.Num(); ++i)
-	{
-		const FOrionStructureRecord& R = Records[i];
-
-		// Decompose Transform
-		const FVector Loc = R.Transform.GetLocation();
-		const FRotator Rot = R.Transform.GetRotation().Rotator();
-		const FVector Scale = R.Transform.GetScale3D();
-
-		// Assemble an object
-		JsonOut += TEXT("  {\n");
-		JsonOut += FString::Printf(
-			TEXT("    \"ClassPath\": \"%s\",\n"),
-			*R.ClassPath
-		);
-		JsonOut += TEXT("    \"Translation\": {\n");
-		JsonOut += FString::Printf(
-			TEXT("      \"X\": %.6f, \"Y\": %.6f, \"Z\": %.6f\n"),
-			Loc.X, Loc.Y, Loc.Z
-		);
-		JsonOut += TEXT("    },\n");
-
-		JsonOut += TEXT("    \"Rotation\": {\n");
-		JsonOut += FString::Printf(
-			TEXT("      \"Pitch\": %.6f, \"Yaw\": %.6f, \"Roll\": %.6f\n"),
-			Rot.Pitch, Rot.Yaw, Rot.Roll
-		);
-		JsonOut += TEXT("    },\n");
-
-		JsonOut += TEXT("    \"Scale\": {\n");
-		JsonOut += FString::Printf(
-			TEXT("      \"X\": %.6f, \"Y\": %.6f, \"Z\": %.6f\n"),
-			Scale.X, Scale.Y, Scale.Z
-		);
-		JsonOut += TEXT("    }\n");
-
-		JsonOut += TEXT("  }");
-		// If not the last one, add comma
-		if (i < Records.Num() - 1)
+	const FString SaveDir = FPaths::ProjectSavedDir(); // e.g. ".../Saved/"
+	const FString FullPath = SaveDir / Filename; // e.g. ".../Saved/structure_records.json"
+
+	// Streamed record by record through a fixed buffer, no document in memory
+	const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FullPath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveJSON] Failed to write JSON file: %s"), *FullPath);
+		return false;
+	}
+
+	{
+		FOrionStructureJsonWriter Writer(*FileWriter);
+		for (const FOrionStructureRecord& R : Records)
 		{
-			JsonOut += TEXT(",");
+			Writer.Write(R);
 		}
-		JsonOut += TEXT("\n");
 	}
 
-	JsonOut += TEXT("]\n");
-
-	// 2) Write to disk
-	const FString SaveDir = FPaths::ProjectSavedDir(); // e.g. ".../Saved/"
-	const FString FullPath = SaveDir / Filename; // e.g. ".../Saved/structure_records.json"
-
-	if (!FFileHelper::SaveStringToFile(JsonOut, *FullPath))
+	if (!FileWriter->Close())
 	{
 		UE_LOG(LogTemp, Error, TEXT("[SaveJSON] Failed to write JSON file: %s"), *FullPath);
 		return false;
@@ -234,12 +168,15 @@ void UOrionGameInstance::SaveGame(const FString& InSlotName)
 	auto* SaveObj = Cast<UOrionSaveGame>(
 		UGameplayStatics::CreateSaveGameObject(UOrionSaveGame::StaticClass()));
 
+	const double SnapshotStart = FPlatformTime::Seconds();
+
 	// SaveAllBuildings(SaveObj);
-	SaveAllCharacters(SaveObj);
+	FOrionSaveNameTableBuilder Names;
+	SaveAllCharacters(SaveObj, Names);
 	if (auto* AMgr = GetSubsystem<UOrionActorManager>())
 	{
 		TArray<FOrionActorFullRecord> Recs;
-		AMgr->CollectActorRecords(Recs);
+		AMgr->CollectActorRecords(Recs, Names);
 		SaveObj->SavedActors = MoveTemp(Recs);
 	}
 	if (auto* IMgr = GetSubsystem<UOrionInventoryManager>())
@@ -248,17 +185,20 @@ void UOrionGameInstance::SaveGame(const FString& InSlotName)
 		IMgr->CollectInventoryRecords(Recs);
 		SaveObj->SavedInventories = MoveTemp(Recs);
 	}
+	Names.TakeNewEntries(SaveObj->NameTable);
 
+	UE_LOG(LogTemp, Log, TEXT("[Save] Snapshot took %.2f ms"), (FPlatformTime::Seconds() - SnapshotStart) * 1000.0);
 
-	UGameplayStatics::SaveGameToSlot(SaveObj, SlotName, 0);
+	WriteSaveAsync(SaveObj, GetSlotFilePath());
 	DumpSaveGame(SaveObj);
 	//UE_LOG(LogTemp, Log, TEXT("[Save] Game saved to slot %s"), *SlotName);
 }
 
 void UOrionGameInstance::LoadGame(const FString& InSlotName)
 {
-	auto* LoadObj = Cast<UOrionSaveGame>(
-		UGameplayStatics::LoadGameFromSlot(SlotName, 0));
+	UOrionSaveGame* LoadObj = IFileManager::Get().FileExists(*GetSlotFilePath())
+		                          ? ReadSaveFile(GetSlotFilePath())
+		                          : nullptr;
 
 	if (!LoadObj)
 	{
@@ -266,29 +206,369 @@ void UOrionGameInstance::LoadGame(const FString& InSlotName)
 		return;
 	}
 
-	UWorld* World = GetWorld();
-	check(World);
+	RestoreFromSave(LoadObj);
+}
+
+void UOrionGameInstance::RestoreFromSave(UOrionSaveGame* LoadObj)
+{
+	check(LoadObj);
+
+	// 存档里引用的类先异步加载，全部常驻后再恢复世界（不在游戏线程上逐个阻塞加载）
+	TArray<FSoftObjectPath> ClassPaths;
+	for (const FOrionActorFullRecord& Rec : LoadObj->SavedActors)
+	{
+		ClassPaths.AddUnique(FSoftObjectPath(Rec.ClassPath));
+	}
+	for (const FOrionStructureRecord& Rec : LoadObj->SavedStructures)
+	{
+		ClassPaths.AddUnique(FSoftObjectPath(Rec.ClassPath));
+	}
+
+	UOrionAssetPreloadManager* PreloadManager = GetSubsystem<UOrionAssetPreloadManager>();
+	check(PreloadManager);
 
-	// LoadAllBuildings(LoadObj, World);
+	// Records are applied over the next frames with the game paused, see UOrionWorldLoadManager
+	auto RestoreWorld = [this, SaveObj = TStrongObjectPtr<UOrionSaveGame>(LoadObj)]()
+	{
+		UOrionWorldLoadManager* WorldLoadManager = GetSubsystem<UOrionWorldLoadManager>();
+		check(WorldLoadManager);
+		WorldLoadManager->StartLoad(SaveObj.Get());
+	};
 
-	if (auto* AMgr = GetSubsystem<UOrionActorManager>())
+	PreloadManager->RequestPreload(MoveTemp(ClassPaths), FSimpleDelegate::CreateWeakLambda(this, MoveTemp(RestoreWorld)));
+}
+
+void UOrionGameInstance::CollectAllRecords(UOrionSaveGame* SaveObj, FOrionSaveNameTableBuilder& Names) const
+{
+	SaveAllCharacters(SaveObj, Names);
+	if (const auto* AMgr = GetSubsystem<UOrionActorManager>())
 	{
-		AMgr->LoadAllActors(World, LoadObj->SavedActors); // ★现在类型匹配
+		AMgr->CollectActorRecords(SaveObj->SavedActors, Names);
 	}
-	LoadAllCharacters(LoadObj, World);
-	if (auto* IMgr = GetSubsystem<UOrionInventoryManager>())
+	if (const auto* IMgr = GetSubsystem<UOrionInventoryManager>())
+	{
+		IMgr->CollectInventoryRecords(SaveObj->SavedInventories);
+	}
+	if (const auto* BuildingManager = GetSubsystem<UOrionBuildingManager>())
 	{
-		IMgr->ApplyInventoryRecords(LoadObj->SavedInventories);
+		SaveObj->SavedStructures.Reset();
+		BuildingManager->CollectStructureRecords(SaveObj->SavedStructures);
 	}
+	Names.TakeNewEntries(SaveObj->NameTable);
 }
 
+UObject* UOrionGameInstance::FindSerializableById(const FGuid& GameId) const
+{
+	if (const auto* CharaManager = GetSubsystem<UOrionCharaManager>())
+	{
+		if (AOrionChara* Chara = CharaManager->FindCharaById(GameId))
+		{
+			return Chara;
+		}
+	}
+	if (const auto* AMgr = GetSubsystem<UOrionActorManager>())
+	{
+		return AMgr->FindActorById(GameId);
+	}
+	return nullptr;
+}
 
-void UOrionGameInstance::SaveAllCharacters(UOrionSaveGame* SaveObj) const
+void UOrionGameInstance::BenchmarkRecordArchives(const int32 Iterations) const
+{
+	TArray<UObject*> Objects;
+	if (const auto* CharaManager = GetSubsystem<UOrionCharaManager>())
+	{
+		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : CharaManager->GetAllCharas())
+		{
+			if (AOrionChara* Chara = Pair.Value.Get())
+			{
+				Objects.Add(Chara);
+			}
+		}
+	}
+	if (const UWorld* World = GetWorld())
+	{
+		for (TActorIterator<AOrionActor> It(World); It; ++It)
+		{
+			Objects.Add(*It);
+		}
+	}
+
+	FOrionNameTableArchive::Benchmark(Objects, [this](const FGuid& GameId) { return FindSerializableById(GameId); },
+	                                  Iterations);
+}
+
+void UOrionGameInstance::BenchmarkStructureRecords(const int32 Iterations) const
+{
+	TArray<FOrionStructureRecord> Records;
+	if (const auto* BuildingManager = GetSubsystem<UOrionBuildingManager>())
+	{
+		BuildingManager->CollectStructureRecords(Records);
+	}
+	if (Records.Num() == 0 || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Save] Structure record benchmark: no structures."));
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Save] Structure record benchmark, %d records x %d iterations:"), Records.Num(),
+	       Iterations);
+
+	auto Measure = [&Records, Iterations](const TCHAR* Name, TFunctionRef<void(TArray<uint8>&)> Encode,
+	                                      TFunctionRef<void(const TArray<uint8>&, TArray<FOrionStructureRecord>&)> Decode)
+	{
+		TArray<uint8> Bytes;
+		TArray<FOrionStructureRecord> Decoded;
+
+		double EncodeSeconds = 0.0;
+		double DecodeSeconds = 0.0;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Bytes.Reset();
+			double StartTime = FPlatformTime::Seconds();
+			Encode(Bytes);
+			EncodeSeconds += FPlatformTime::Seconds() - StartTime;
+
+			Decoded.Reset();
+			StartTime = FPlatformTime::Seconds();
+			Decode(Bytes, Decoded);
+			DecodeSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		// Save files are compressed as a whole
+		TArray<uint8> Compressed;
+		FOrionSaveContainer::Compress(Bytes, Compressed);
+
+		UE_LOG(LogTemp, Log, TEXT("[Save]   %-12s %9d bytes (%8d compressed), encode %.3f ms, decode %.3f ms%s"),
+		       Name, Bytes.Num(), Compressed.Num(), EncodeSeconds * 1000.0 / Iterations,
+		       DecodeSeconds * 1000.0 / Iterations, Decoded.Num() == Records.Num() ? TEXT("") : TEXT(", MISMATCH"));
+	};
+
+	/* ① JSON dump (SaveStructureRecordsToJsonFile_Manual), streamed */
+	Measure(TEXT("JSON"), [&Records](TArray<uint8>& Bytes)
+	        {
+		        FMemoryWriter MemWriter(Bytes);
+		        FOrionStructureJsonWriter Writer(MemWriter);
+		        for (const FOrionStructureRecord& Record : Records)
+		        {
+			        Writer.Write(Record);
+		        }
+	        },
+	        [](const TArray<uint8>& Bytes, TArray<FOrionStructureRecord>& Out)
+	        {
+		        FMemoryReader MemReader(Bytes);
+		        FOrionStructureJsonReader Reader(MemReader);
+		        FOrionStructureRecord Record;
+		        while (Reader.Next(Record))
+		        {
+			        Out.Add(Record);
+		        }
+	        });
+
+	/* ② Tagged binary (Structures section version 1) */
+	Measure(TEXT("Tagged"), [&Records](TArray<uint8>& Bytes)
+	        {
+		        FMemoryWriter Writer(Bytes);
+		        FObjectAndNameAsStringProxyArchive Ar(Writer, /*bLoadIn=*/false);
+		        Ar.ArIsSaveGame = true;
+
+		        int32 Num = Records.Num();
+		        Ar << Num;
+		        for (FOrionStructureRecord& Record : Records)
+		        {
+			        FOrionStructureRecord::StaticStruct()->SerializeItem(Ar, &Record, nullptr);
+		        }
+	        },
+	        [](const TArray<uint8>& Bytes, TArray<FOrionStructureRecord>& Out)
+	        {
+		        FMemoryReader Reader(Bytes);
+		        FObjectAndNameAsStringProxyArchive Ar(Reader, /*bLoadIn=*/true);
+		        Ar.ArIsSaveGame = true;
+
+		        int32 Num = 0;
+		        Ar << Num;
+		        Out.SetNum(Num);
+		        for (FOrionStructureRecord& Record : Out)
+		        {
+			        FOrionStructureRecord::StaticStruct()->SerializeItem(Ar, &Record, nullptr);
+		        }
+	        });
+
+	/* ③ Compact codec (Structures section version 3) */
+	Measure(TEXT("Compact"), [&Records](TArray<uint8>& Bytes)
+	        {
+		        FMemoryWriter Writer(Bytes);
+		        FOrionStructureRecordCodec::Serialize(Writer, Records);
+	        },
+	        [](const TArray<uint8>& Bytes, TArray<FOrionStructureRecord>& Out)
+	        {
+		        FMemoryReader Reader(Bytes);
+		        FOrionStructureRecordCodec::Serialize(Reader, Out);
+	        });
+
+	// Anything below 100% here is written at full precision
+	double MaxError = 0.0;
+	int32 NumQuantized = 0;
+	for (const FOrionStructureRecord& Record : Records)
+	{
+		if (!FOrionStructureRecordCodec::IsQuantizable(Record.Transform))
+		{
+			continue;
+		}
+		++NumQuantized;
+
+		const FTransform Snapped = FOrionStructureRecordCodec::Snap(Record.Transform);
+		MaxError = FMath::Max(MaxError, (Snapped.GetLocation() - Record.Transform.GetLocation()).GetAbsMax());
+	}
+	UE_LOG(LogTemp, Log, TEXT("[Save]   Compact quantized %d / %d records (%.1f%%), max position error %.4f cm"),
+	       NumQuantized, Records.Num(), Records.Num() > 0 ? 100.0 * NumQuantized / Records.Num() : 0.0, MaxError);
+}
+
+FString UOrionGameInstance::GetSlotFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / FString(SlotName) + TEXT(".sav");
+}
+
+bool UOrionGameInstance::WriteSaveAsync(UOrionSaveGame* Snapshot, const FString& SavePath)
+{
+	if (!Snapshot)
+	{
+		return false;
+	}
+
+	if (bSaveInProgress)
+	{
+		// Written after the current one; only the latest snapshot of a path is worth writing
+		if (FPendingSave* Queued = PendingSaves.FindByPredicate(
+			[&SavePath](const FPendingSave& Pending) { return Pending.SavePath == SavePath; }))
+		{
+			Queued->Snapshot.Reset(Snapshot);
+		}
+		else
+		{
+			PendingSaves.Add({TStrongObjectPtr<UOrionSaveGame>(Snapshot), SavePath});
+		}
+		UE_LOG(LogTemp, Log, TEXT("[Save] A save is still being written, %s queued"), *SavePath);
+		return true;
+	}
+
+	StartSaveWrite(TStrongObjectPtr<UOrionSaveGame>(Snapshot), SavePath);
+	return true;
+}
+
+void UOrionGameInstance::StartSaveWrite(TStrongObjectPtr<UOrionSaveGame> Snapshot, const FString& SavePath)
+{
+	bSaveInProgress = true;
+
+	// The snapshot is only read by the worker and released back on the game thread
+	Async(EAsyncExecution::ThreadPool,
+	      [WeakThis = TWeakObjectPtr<UOrionGameInstance>(this), Snapshot = MoveTemp(Snapshot), SavePath]() mutable
+	      {
+		      const double StartTime = FPlatformTime::Seconds();
+
+		      TArray<uint8> RawBytes;
+		      FOrionSaveContainer::Write(*Snapshot, RawBytes);
+
+		      TArray<uint8> FileBytes;
+		      const bool bSuccess = FOrionSaveContainer::Compress(RawBytes, FileBytes) &&
+			      FOrionSaveContainer::WriteFileAtomically(SavePath, FileBytes);
+
+		      const double WorkerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		      AsyncTask(ENamedThreads::GameThread,
+		                [WeakThis, Snapshot = MoveTemp(Snapshot), SavePath, bSuccess, RawSize = RawBytes.Num(),
+			                FileSize = FileBytes.Num(), WorkerMs]() mutable
+		                {
+			                Snapshot.Reset();
+			                if (UOrionGameInstance* GameInstance = WeakThis.Get())
+			                {
+				                GameInstance->OnAsyncSaveFinished(SavePath, bSuccess, RawSize, FileSize, WorkerMs);
+			                }
+		                });
+	      });
+}
+
+void UOrionGameInstance::OnAsyncSaveFinished(const FString& SavePath, const bool bSuccess, const int64 RawSize,
+                                             const int64 FileSize, const double WorkerMs)
+{
+	bSaveInProgress = false;
+
+	if (bSuccess)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[Save] OK  ->  %s  (%lld bytes, %lld raw, %.1f ms in background)"),
+		       *SavePath, FileSize, RawSize, WorkerMs);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Save] FAILED to write %s"), *SavePath);
+	}
+
+	// Next queued save before the broadcast, so saves requested by listeners stay behind it
+	if (PendingSaves.Num() > 0)
+	{
+		FPendingSave Next = MoveTemp(PendingSaves[0]);
+		PendingSaves.RemoveAt(0);
+		StartSaveWrite(MoveTemp(Next.Snapshot), Next.SavePath);
+	}
+
+	OnSaveFinished.Broadcast(SavePath, bSuccess);
+}
+
+UOrionSaveGame* UOrionGameInstance::ReadSaveFile(const FString& LoadPath) const
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *LoadPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Load] Cannot read file %s"), *LoadPath);
+		return nullptr;
+	}
+
+	TArray<uint8> RawBytes;
+	if (!FOrionSaveContainer::Decompress(FileData, RawBytes))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Load] Decompress failed!"));
+		return nullptr;
+	}
+
+	// 分段存档各段并行解码
+	if (FOrionSaveContainer::IsContainer(RawBytes))
+	{
+		UOrionSaveGame* LoadObj = NewObject<UOrionSaveGame>();
+		if (!FOrionSaveContainer::Read(RawBytes, *LoadObj))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Load] Deserialize failed!"));
+			return nullptr;
+		}
+		return LoadObj;
+	}
+
+	// Slots written by UGameplayStatics::SaveGameToSlot
+	constexpr uint32 SlotFileTag = 0x53415647; // "GVAS"
+	if (RawBytes.Num() >= static_cast<int32>(sizeof(uint32)) &&
+		FMemory::Memcmp(RawBytes.GetData(), &SlotFileTag, sizeof(uint32)) == 0)
+	{
+		return Cast<UOrionSaveGame>(UGameplayStatics::LoadGameFromMemory(RawBytes));
+	}
+
+	// Single blob written by the old SaveGameWithDialog
+	FMemoryReader MemReader(RawBytes);
+	FSaveGameArchive ProxyAr(MemReader, /*bIsSave=*/false);
+
+	UOrionSaveGame* LoadObj = NewObject<UOrionSaveGame>();
+	LoadObj->Serialize(ProxyAr);
+
+	MemReader.FlushCache();
+	MemReader.Close();
+
+	return LoadObj;
+}
+
+void UOrionGameInstance::SaveAllCharacters(UOrionSaveGame* SaveObj, FOrionSaveNameTableBuilder& Names) const
 {
 	if (auto* CharaManager = GetSubsystem<UOrionCharaManager>())
 	{
 		TArray<FOrionCharaSerializable> Records;
-		CharaManager->CollectCharacterRecords(Records);
+		CharaManager->CollectCharacterRecords(Records, Names);
 
 		SaveObj->SavedCharacters = MoveTemp(Records);
 	}
@@ -298,8 +578,9 @@ void UOrionGameInstance::LoadAllCharacters(UOrionSaveGame* LoadObj, UWorld* Worl
 {
 	if (auto* CharaManager = GetSubsystem<UOrionCharaManager>())
 	{
-		CharaManager->RemoveAllCharacters(World);
-		CharaManager->LoadAllCharacters(World, LoadObj->SavedCharacters);
+		// Characters still in the save are updated in place, see UOrionCharaManager::LoadAllCharacters
+		CharaManager->LoadAllCharacters(World, LoadObj->SavedCharacters, LoadObj->NameTable,
+		                                [this](const FGuid& GameId) { return FindSerializableById(GameId); });
 	}
 }
 
@@ -313,8 +594,13 @@ void UOrionGameInstance::SaveAllBuildings(UOrionSaveGame* SaveObj) const
 		TArray<FOrionStructureRecord> Records;
 		BuildingManager->CollectStructureRecords(Records);
 
-		// Manually write JSON to save a copy to Saved directory
-		SaveStructureRecordsToJsonFile_Manual(Records, TEXT("structure_records.json"));
+		// JSON copy for Scripts/BuildingAnalysis.py and the rooms found at runtime (debugging only, both are
+		// written synchronously on the game thread)
+		if (BuildingManager->BEnableDebugLine)
+		{
+			SaveStructureRecordsToJsonFile_Manual(Records, TEXT("structure_records.json"));
+			BuildingManager->ExportRoomsToCsv(TEXT("room_summary.csv"));
+		}
 
 		// Then store Records in SaveGame object
 		SaveObj->SavedStructures = MoveTemp(Records);
@@ -328,26 +614,55 @@ void UOrionGameInstance::LoadAllBuildings(UOrionSaveGame* LoadObj, UWorld* World
 	{
 		It->Destroy();
 	}
-	if (auto* BuildingManager = GetSubsystem<UOrionBuildingManager>())
+	UOrionBuildingManager* BuildingManager = GetSubsystem<UOrionBuildingManager>();
+	if (BuildingManager)
 	{
 		BuildingManager->ResetAllSockets(World);
+
+		// Sockets, graph links, stability and navigation of the spawned pieces are done in one pass below
+		BuildingManager->BeginBulkLoad();
 	}
 
 	/* ② — Regenerate buildings (BeginPlay will automatically RegisterSocket) — */
+	TArray<AActor*> SpawnedStructures;
+	SpawnedStructures.Reserve(LoadObj->SavedStructures.Num());
+
 	for (const FOrionStructureRecord& Rec : LoadObj->SavedStructures)
 	{
-		UClass* StructClass =
-			LoadClass<AOrionStructure>(nullptr, *Rec.ClassPath);
-		if (!StructClass)
+		if (AOrionStructure* Structure = SpawnStructure(Rec, World))
 		{
-			UE_LOG(LogTemp, Error,
-			       TEXT("[Load] Failed to load class %s"), *Rec.ClassPath);
-			continue;
+			SpawnedStructures.Add(Structure);
 		}
-		World->SpawnActor<AOrionStructure>(StructClass, Rec.Transform);
+	}
+
+	if (BuildingManager)
+	{
+		BuildingManager->EndBulkLoad();
+	}
+
+	/* ③ — Large bases are rendered through per-class HISM, actors are only kept for interaction — */
+	if (UOrionBuildingRenderManager* RenderManager = GetSubsystem<UOrionBuildingRenderManager>();
+		RenderManager && RenderManager->bInstanceStructures)
+	{
+		RenderManager->InstanceStructures(SpawnedStructures);
 	}
 
 	/* ……Additional restoration of other system data can be added here…… */
 
 	//UE_LOG(LogTemp, Log, TEXT("[Load] Game loaded from slot %s"), SlotName);
 }
+
+AOrionStructure* UOrionGameInstance::SpawnStructure(const FOrionStructureRecord& Rec, UWorld* World) const
+{
+	const UOrionAssetPreloadManager* PreloadManager = GetSubsystem<UOrionAssetPreloadManager>();
+	UClass* StructClass = PreloadManager
+		                      ? PreloadManager->FindOrLoadClass<AOrionStructure>(Rec.ClassPath).Get()
+		                      : LoadClass<AOrionStructure>(nullptr, *Rec.ClassPath);
+	if (!StructClass)
+	{
+		UE_LOG(LogTemp, Error,
+		       TEXT("[Load] Failed to load class %s"), *Rec.ClassPath);
+		return nullptr;
+	}
+	return World->SpawnActor<AOrionStructure>(StructClass, Rec.Transform);
+}
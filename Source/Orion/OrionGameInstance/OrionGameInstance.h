@@ -7,8 +7,13 @@
 #include "Engine/DataTable.h"
 #include "Orion/OrionChara/OrionChara.h"
 #include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "UObject/StrongObjectPtr.h"
 #include "OrionGameInstance.generated.h"
 
+class AOrionStructure;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnOrionSaveFinished, const FString& /*SavePath*/, bool /*bSuccess*/);
+
 /**
  * 
  */
@@ -18,13 +23,16 @@ class ORION_API UOrionGameInstance : public UGameInstance
 	GENERATED_BODY()
 
 public:
-	void SaveAllCharacters(UOrionSaveGame* SaveObj) const;
+	void SaveAllCharacters(UOrionSaveGame* SaveObj, FOrionSaveNameTableBuilder& Names) const;
 	void LoadAllCharacters(UOrionSaveGame* LoadObj, UWorld* World) const;
 
 
 	void SaveAllBuildings(UOrionSaveGame* SaveObj) const;
 	void LoadAllBuildings(UOrionSaveGame* LoadObj, UWorld* World) const;
 
+	/* One saved structure (BeginPlay registers its sockets), nullptr if its class cannot be loaded */
+	AOrionStructure* SpawnStructure(const FOrionStructureRecord& Rec, UWorld* World) const;
+
 	UFUNCTION(BlueprintCallable)
 	void SaveGame(const FString& InSlotName);
 
@@ -37,13 +45,68 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void LoadGameWithDialog();
 
+	/**
+	 * Second stage of a save: Snapshot holds the records collected on the game thread, container serialization,
+	 * compression and the write (temp file + rename) run on a worker thread. OnSaveFinished is broadcast on the
+	 * game thread. If another save is still being written, the snapshot is queued and written right after it
+	 * (a newer snapshot for the same path replaces the queued one). Returns false only without a snapshot.
+	 */
+	bool WriteSaveAsync(UOrionSaveGame* Snapshot, const FString& SavePath);
+
+	bool IsSaveInProgress() const { return bSaveInProgress; }
+
+	FOnOrionSaveFinished OnSaveFinished;
+
+	/** Reads a save of any format (compressed / chunked / single blob / slot), nullptr on failure */
+	UOrionSaveGame* ReadSaveFile(const FString& LoadPath) const;
+
+	/**
+	 * Every record of the world: characters, actors, inventories and structures. The names they reference are
+	 * added to Names, its new entries go into SaveObj->NameTable.
+	 */
+	void CollectAllRecords(UOrionSaveGame* SaveObj, FOrionSaveNameTableBuilder& Names) const;
+
+	/** Character or actor with the GameId, resolves the object references of loaded records */
+	UObject* FindSerializableById(const FGuid& GameId) const;
+
+	/** Dev: size and save / load time of the character and actor records, name table vs name as string */
+	void BenchmarkRecordArchives(int32 Iterations = 10) const;
+
+	/** Dev: size and encode / decode time of the structure records, JSON vs tagged binary vs compact codec */
+	void BenchmarkStructureRecords(int32 Iterations = 10) const;
+
+	/** Preloads the classes the save references, then rebuilds the world from it over several frames */
+	void RestoreFromSave(UOrionSaveGame* LoadObj);
+
 	// 建筑数据表配置（可在编辑器中指定）
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Building Data", meta = (AllowedClasses = "DataTable"))
 	TObjectPtr<UDataTable> BuildingDataTable = nullptr;
 
+	// 物品数据表配置（行类型 FOrionDataItemRow，未指定时使用硬编码数据）
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Data", meta = (AllowedClasses = "DataTable"))
+	TObjectPtr<UDataTable> ItemDataTable = nullptr;
+
 private:
 	static constexpr const TCHAR* SlotName = TEXT("OrionSlot");
 
+	// Same location UGameplayStatics uses for slots on desktop
+	static FString GetSlotFilePath();
+
+	void StartSaveWrite(TStrongObjectPtr<UOrionSaveGame> Snapshot, const FString& SavePath);
+
+	void OnAsyncSaveFinished(const FString& SavePath, bool bSuccess, int64 RawSize, int64 FileSize, double WorkerMs);
+
+	bool bSaveInProgress = false;
+
+	// Saves requested while another one was being written, in request order
+	struct FPendingSave
+	{
+		TStrongObjectPtr<UOrionSaveGame> Snapshot;
+		FString SavePath;
+	};
+
+	TArray<FPendingSave> PendingSaves;
+
 	static const TCHAR* OrionActionToString(EOrionAction Type)
 	{
 		switch (Type)
@@ -64,21 +64,29 @@ void UOrionInventoryManager::CollectInventoryRecords(TArray<FOrionInventorySeria
 
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
-		AActor* Act = *It;
-		if (const auto* FoundInventoryComp = Act->FindComponentByClass<UOrionInventoryComponent>())
+		FOrionInventorySerializable InventoryRecord;
+		if (MakeInventoryRecord(*It, InventoryRecord))
 		{
-			if (const auto* Serial = Cast<IOrionInterfaceSerializable>(Act))
-			{
-				FOrionInventorySerializable InventoryRecord;
-				InventoryRecord.OwnerGameId = Serial->GetSerializable().GameId;
-				InventoryRecord.SerializedInventoryMap = FoundInventoryComp->GetInventoryMap();
-				InventoryRecord.SerializedAvailableInventoryMap = FoundInventoryComp->GetAvailableInventoryMap();
-				SavingInventoryRecord.Add(MoveTemp(InventoryRecord));
-			}
+			SavingInventoryRecord.Add(MoveTemp(InventoryRecord));
 		}
 	}
 }
 
+bool UOrionInventoryManager::MakeInventoryRecord(const AActor* Owner, FOrionInventorySerializable& OutRecord)
+{
+	const auto* FoundInventoryComp = Owner ? Owner->FindComponentByClass<UOrionInventoryComponent>() : nullptr;
+	const auto* Serial = Cast<IOrionInterfaceSerializable>(Owner);
+	if (!FoundInventoryComp || !Serial)
+	{
+		return false;
+	}
+
+	OutRecord.OwnerGameId = Serial->GetSerializable().GameId;
+	OutRecord.SerializedInventoryMap = FoundInventoryComp->GetInventoryMap();
+	OutRecord.SerializedAvailableInventoryMap = FoundInventoryComp->GetAvailableInventoryMap();
+	return true;
+}
+
 void UOrionInventoryManager::ApplyInventoryRecords(const TArray<FOrionInventorySerializable>& Saved) const
 {
 	const UWorld* World = GetWorld();
@@ -89,22 +97,26 @@ void UOrionInventoryManager::ApplyInventoryRecords(const TArray<FOrionInventoryS
 
 	for (const FOrionInventorySerializable& InventorySerializable : Saved)
 	{
-		const AActor* Target = FindOwnerById(World, InventorySerializable.OwnerGameId);
-		if (!Target)
-		{
-			continue;
-		}
+		ApplyInventoryRecord(FindOwnerById(World, InventorySerializable.OwnerGameId), InventorySerializable);
+	}
+}
+
+void UOrionInventoryManager::ApplyInventoryRecord(const AActor* Target, const FOrionInventorySerializable& InventorySerializable)
+{
+	if (!Target)
+	{
+		return;
+	}
 
-		if (auto* Inv = Target->FindComponentByClass<UOrionInventoryComponent>())
+	if (auto* Inv = Target->FindComponentByClass<UOrionInventoryComponent>())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ApplyInventoryRecords] Found Inventory for %s"), *Target->GetName());
+		Inv->ClearInventory();
+		for (auto& Pair : InventorySerializable.SerializedInventoryMap)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[ApplyInventoryRecords] Found Inventory for %s"), *Target->GetName());
-			Inv->ClearInventory();
-			for (auto& Pair : InventorySerializable.SerializedInventoryMap)
-			{
-				Inv->ModifyItemQuantity(Pair.Key, Pair.Value);
-				Inv->SetCapacityMap(InventorySerializable.SerializedAvailableInventoryMap);
-				Inv->ForceSetInventory(InventorySerializable.SerializedInventoryMap);
-			}
+			Inv->ModifyItemQuantity(Pair.Key, Pair.Value);
+			Inv->SetCapacityMap(InventorySerializable.SerializedAvailableInventoryMap);
+			Inv->ForceSetInventory(InventorySerializable.SerializedInventoryMap);
 		}
 	}
 }
@@ -28,8 +28,14 @@ public:
 
 	void CollectInventoryRecords(TArray<FOrionInventorySerializable>& SavingInventoryRecord) const;
 
+	/* Record of Owner's inventory, false if it has none (delta autosave) */
+	static bool MakeInventoryRecord(const AActor* Owner, FOrionInventorySerializable& OutRecord);
+
 	void ApplyInventoryRecords(const TArray<FOrionInventorySerializable>& Saved) const;
 
+	/* One record onto Target (already resolved by the caller), nothing if Target is null or has no inventory */
+	static void ApplyInventoryRecord(const AActor* Target, const FOrionInventorySerializable& InventorySerializable);
+
 
 
 private:
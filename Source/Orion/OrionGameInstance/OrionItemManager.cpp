@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionItemManager.h"
+#include "Orion/OrionGameInstance/OrionGameInstance.h"
+#include "Engine/AssetManager.h"
+
+// 硬编码数据（作为后备，当 DataTable 未指定时使用）
+const TArray<FOrionDataItem>& UOrionItemManager::GetHardcodedItems()
+{
+	static const TArray<FOrionDataItem> HardcodedItems = {
+		{
+			1, FName("Log"), FText::FromString("Log"), FText::FromString(TEXT("原木")), 1.f, 30.f,
+			TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTLogIcon.GPTLogIcon")))
+		},
+		{
+			2, FName("StoneOre"), FText::FromString("Stone Ore"), FText::FromString(TEXT("石矿")), 2.f, 30.f,
+			TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTStoneOreIcon.GPTStoneOreIcon")))
+		},
+		{
+			3, FName("Bullet"), FText::FromString("Bullet"), FText::FromString(TEXT("子弹")), 2.f, 30.f,
+			TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTBullet.GPTBullet")))
+		},
+	};
+	return HardcodedItems;
+}
+
+void UOrionItemManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (const UOrionGameInstance* GameInstance = Cast<UOrionGameInstance>(GetGameInstance()))
+	{
+		ItemDataTable = GameInstance->ItemDataTable;
+	}
+
+	LoadItemDataFromDataTable();
+	RequestIconsAsync();
+}
+
+void UOrionItemManager::Deinitialize()
+{
+	if (IconsHandle.IsValid())
+	{
+		IconsHandle->CancelHandle();
+		IconsHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+UOrionItemManager* UOrionItemManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UOrionItemManager>() : nullptr;
+}
+
+void UOrionItemManager::LoadItemDataFromDataTable()
+{
+	Items.Empty();
+	ItemIdToDenseIndex.Empty();
+	NameToItemId.Empty();
+
+	if (ItemDataTable)
+	{
+		TArray<FOrionDataItemRow*> Rows;
+		ItemDataTable->GetAllRows<FOrionDataItemRow>(TEXT("LoadItemDataFromDataTable"), Rows);
+
+		if (Rows.Num() > 0)
+		{
+			Items.Reserve(Rows.Num());
+			for (const FOrionDataItemRow* Row : Rows)
+			{
+				if (Row)
+				{
+					RegisterItem(Row->ToDataItem());
+				}
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("[ItemManager] Loaded %d items from DataTable: %s"),
+			       Items.Num(), *ItemDataTable->GetName());
+			return;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("[ItemManager] DataTable %s is empty, falling back to hardcoded data."),
+		       *ItemDataTable->GetName());
+	}
+
+	for (const FOrionDataItem& Item : GetHardcodedItems())
+	{
+		RegisterItem(Item);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ItemManager] Using hardcoded item data (%d items)."), Items.Num());
+}
+
+void UOrionItemManager::RegisterItem(const FOrionDataItem& Item)
+{
+	if (ItemIdToDenseIndex.Contains(Item.ItemId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ItemManager] Duplicate ItemId %d (%s) ignored."),
+		       Item.ItemId, *Item.Name.ToString());
+		return;
+	}
+
+	const int32 DenseIndex = Items.Add(Item);
+	ItemIdToDenseIndex.Add(Item.ItemId, DenseIndex);
+	NameToItemId.Add(Item.Name, Item.ItemId);
+}
+
+void UOrionItemManager::RequestIconsAsync()
+{
+	ItemIcons.SetNum(Items.Num());
+
+	TArray<FSoftObjectPath> IconPaths;
+	for (const FOrionDataItem& Item : Items)
+	{
+		if (!Item.Icon.IsNull())
+		{
+			IconPaths.AddUnique(Item.Icon.ToSoftObjectPath());
+		}
+	}
+
+	if (IconPaths.Num() == 0)
+	{
+		return;
+	}
+
+	FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+	IconsHandle = Streamable.RequestAsyncLoad(IconPaths, FStreamableDelegate::CreateUObject(this, &UOrionItemManager::OnIconsLoaded));
+}
+
+void UOrionItemManager::OnIconsLoaded()
+{
+	for (int32 i = 0; i < Items.Num(); ++i)
+	{
+		ItemIcons[i] = Items[i].Icon.Get();
+	}
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
+#include "Orion/OrionGlobals/OrionDataItem.h"
+#include "OrionItemManager.generated.h"
+
+/**
+ * Item definition registry.
+ * 物品定义注册表：优先从 GameInstance 上配置的 DataTable 加载，未配置时使用硬编码数据。
+ * Items are stored densely (0..Num-1) and indexed by ItemId, so lookups are O(1) and return references.
+ */
+UCLASS()
+class ORION_API UOrionItemManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase&) override;
+	virtual void Deinitialize() override;
+
+	/** Returns nullptr if ItemId is not registered */
+	const FOrionDataItem* FindItemInfo(const int32 ItemId) const
+	{
+		const int32* DenseIndex = ItemIdToDenseIndex.Find(ItemId);
+		return DenseIndex ? &Items[*DenseIndex] : nullptr;
+	}
+
+	/** Returns an empty definition (ItemId == 0) if ItemId is not registered */
+	const FOrionDataItem& GetItemInfo(const int32 ItemId) const
+	{
+		static const FOrionDataItem Invalid;
+		const FOrionDataItem* Info = FindItemInfo(ItemId);
+		return Info ? *Info : Invalid;
+	}
+
+	/** Dense index for array-based inventories, INDEX_NONE if ItemId is not registered */
+	int32 GetDenseIndex(const int32 ItemId) const
+	{
+		const int32* DenseIndex = ItemIdToDenseIndex.Find(ItemId);
+		return DenseIndex ? *DenseIndex : INDEX_NONE;
+	}
+
+	int32 GetItemIdByName(const FName Name) const
+	{
+		const int32* ItemId = NameToItemId.Find(Name);
+		return ItemId ? *ItemId : INDEX_NONE;
+	}
+
+	int32 GetNumItems() const { return Items.Num(); }
+
+	/** All definitions, ordered by dense index */
+	const TArray<FOrionDataItem>& GetAllItemInfos() const { return Items; }
+
+	/** Resident icon, nullptr while the async load is still in flight */
+	UTexture2D* GetItemIcon(const int32 ItemId) const
+	{
+		const int32 DenseIndex = GetDenseIndex(ItemId);
+		return ItemIcons.IsValidIndex(DenseIndex) ? ItemIcons[DenseIndex].Get() : nullptr;
+	}
+
+	/** Convenience accessor from any object living in a game world */
+	static UOrionItemManager* Get(const UObject* WorldContextObject);
+
+private:
+	void LoadItemDataFromDataTable();
+	void RegisterItem(const FOrionDataItem& Item);
+	void RequestIconsAsync();
+	void OnIconsLoaded();
+
+	static const TArray<FOrionDataItem>& GetHardcodedItems();
+
+	UPROPERTY()
+	TObjectPtr<UDataTable> ItemDataTable = nullptr;
+
+	TArray<FOrionDataItem> Items;
+	TMap<int32, int32> ItemIdToDenseIndex;
+	TMap<FName, int32> NameToItemId;
+
+	/* Indexed by dense index; UPROPERTY keeps loaded icons resident */
+	UPROPERTY()
+	TArray<TObjectPtr<UTexture2D>> ItemIcons;
+
+	TSharedPtr<FStreamableHandle> IconsHandle;
+};
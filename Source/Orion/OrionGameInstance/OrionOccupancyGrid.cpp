@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionOccupancyGrid.h"
+
+FIntVector FOrionOccupancyGrid::ToVoxel(const FVector& Location)
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / VoxelSize),
+		FMath::FloorToInt(Location.Y / VoxelSize),
+		FMath::FloorToInt(Location.Z / VoxelSize));
+}
+
+template <typename FuncType>
+void FOrionOccupancyGrid::ForEachVoxel(const FOrionOrientedBox& Box, FuncType&& Func)
+{
+	const FBox Bounds = Box.GetAABB();
+	const FIntVector Min = ToVoxel(Bounds.Min);
+	const FIntVector Max = ToVoxel(Bounds.Max);
+
+	for (int32 x = Min.X; x <= Max.X; ++x)
+	{
+		for (int32 y = Min.Y; y <= Max.Y; ++y)
+		{
+			for (int32 z = Min.Z; z <= Max.Z; ++z)
+			{
+				// Box is convex: the voxel is inside if its 8 corners are
+				const FVector VoxelMin = FVector(x, y, z) * VoxelSize;
+				bool bSolid = true;
+				for (int32 Corner = 0; Corner < 8 && bSolid; ++Corner)
+				{
+					const FVector CornerPos = VoxelMin + FVector(Corner & 1, (Corner >> 1) & 1, (Corner >> 2) & 1) * VoxelSize;
+					bSolid = Box.ContainsPoint(CornerPos);
+				}
+
+				Func(FIntVector(x, y, z), bSolid);
+			}
+		}
+	}
+}
+
+void FOrionOccupancyGrid::AddStructure(const int32 Key, const FOrionOrientedBox& Box)
+{
+	RemoveStructure(Key);
+	Structures.Add(Key, Box);
+
+	ForEachVoxel(Box, [this](const FIntVector& Coord, const bool bSolid)
+	{
+		FVoxel& Voxel = Voxels.FindOrAdd(Coord);
+		++Voxel.Touching;
+		Voxel.Solid += bSolid ? 1 : 0;
+	});
+}
+
+void FOrionOccupancyGrid::RemoveStructure(const int32 Key)
+{
+	FOrionOrientedBox Box;
+	if (!Structures.RemoveAndCopyValue(Key, Box))
+	{
+		return;
+	}
+
+	// Same box, same voxels, same solid flags as when it was added
+	ForEachVoxel(Box, [this](const FIntVector& Coord, const bool bSolid)
+	{
+		FVoxel* Voxel = Voxels.Find(Coord);
+		if (!Voxel)
+		{
+			return;
+		}
+
+		--Voxel->Touching;
+		Voxel->Solid -= bSolid ? 1 : 0;
+		if (Voxel->IsEmpty())
+		{
+			Voxels.Remove(Coord);
+		}
+	});
+}
+
+void FOrionOccupancyGrid::AddObstacle(const FBox& Bounds)
+{
+	const FIntVector Min = ToVoxel(Bounds.Min);
+	const FIntVector Max = ToVoxel(Bounds.Max);
+
+	for (int32 x = Min.X; x <= Max.X; ++x)
+	{
+		for (int32 y = Min.Y; y <= Max.Y; ++y)
+		{
+			for (int32 z = Min.Z; z <= Max.Z; ++z)
+			{
+				++Voxels.FindOrAdd(FIntVector(x, y, z)).Obstacles;
+			}
+		}
+	}
+}
+
+void FOrionOccupancyGrid::ResetStructures()
+{
+	Structures.Empty();
+	for (auto It = Voxels.CreateIterator(); It; ++It)
+	{
+		It.Value().Touching = 0;
+		It.Value().Solid = 0;
+		if (It.Value().IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FOrionOccupancyGrid::Reset()
+{
+	Structures.Empty();
+	Voxels.Empty();
+}
+
+bool FOrionOccupancyGrid::IsRegionEmpty(const FBox& Bounds) const
+{
+	if (Voxels.Num() == 0)
+	{
+		return true;
+	}
+
+	const FIntVector Min = ToVoxel(Bounds.Min);
+	const FIntVector Max = ToVoxel(Bounds.Max);
+
+	for (int32 x = Min.X; x <= Max.X; ++x)
+	{
+		for (int32 y = Min.Y; y <= Max.Y; ++y)
+		{
+			for (int32 z = Min.Z; z <= Max.Z; ++z)
+			{
+				if (const FVoxel* Voxel = Voxels.Find(FIntVector(x, y, z)); Voxel && !Voxel->IsEmpty())
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+EOrionOccupancy FOrionOccupancyGrid::QueryPlacement(const FOrionOrientedBox& Box, const FVector& CoreCenter) const
+{
+	if (IsRegionEmpty(Box.GetAABB()))
+	{
+		return EOrionOccupancy::Free;
+	}
+
+	// The core lies inside a voxel some structure fills completely: both the box and the core overlap it
+	if (const FVoxel* CoreVoxel = Voxels.Find(ToVoxel(CoreCenter)); CoreVoxel && CoreVoxel->Solid > 0)
+	{
+		return EOrionOccupancy::Blocked;
+	}
+
+	return EOrionOccupancy::Maybe;
+}
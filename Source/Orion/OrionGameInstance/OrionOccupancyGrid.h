@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+
+/* Answer of the occupancy grid for a placement box */
+enum class EOrionOccupancy : uint8
+{
+	Free,    // No structure / obstacle voxel under the box, no structure can overlap it
+	Blocked, // The box core sits in a voxel completely filled by a structure
+	Maybe,   // Partially covered voxels only, the structure box set decides
+};
+
+/**
+ * Sparse 3D voxel occupancy of placed structures at building-module resolution, used by UOrionBuildingManager
+ * as a broadphase in front of the placement / neighbour queries.
+ *
+ * Every voxel counts the structures whose box touches it (conservative, from the box AABB) and the structures
+ * that fill it completely. Structures are keyed by their graph node id (stable through instancing), and their
+ * box is kept so removal visits exactly the voxels that were marked.
+ * Static non-structure obstacles (rocks, ores...) are marked as touching only. The grid only knows what it was
+ * given, so a "Free" answer never replaces the physics test against non-structure geometry.
+ * Marking / querying visits a number of voxels bounded by the piece size, i.e. constant time.
+ */
+class ORION_API FOrionOccupancyGrid
+{
+public:
+	static constexpr float VoxelSize = 62.5f; // Half a square foundation edge (STRUCTURE_LENGTH_BASE)
+
+	void AddStructure(int32 Key, const FOrionOrientedBox& Box);
+	void RemoveStructure(int32 Key);
+
+	void AddObstacle(const FBox& Bounds);
+
+	/* Drops structures, keeps obstacles (world geometry does not change on load) */
+	void ResetStructures();
+	void Reset();
+
+	/**
+	 * Placement answer for a box and its tolerance core (see UOrionBuildingManager::ConfirmPlaceStructure:
+	 * blocked only if both the full box and the shrunk core are blocked).
+	 */
+	EOrionOccupancy QueryPlacement(const FOrionOrientedBox& Box, const FVector& CoreCenter) const;
+
+	/* True if no structure / obstacle touches any voxel under Bounds */
+	bool IsRegionEmpty(const FBox& Bounds) const;
+
+	int32 NumVoxels() const { return Voxels.Num(); }
+	int32 NumStructures() const { return Structures.Num(); }
+
+private:
+	struct FVoxel
+	{
+		uint16 Touching = 0;  // Structures whose box touches the voxel
+		uint16 Solid = 0;     // Structures whose box contains the whole voxel
+		uint16 Obstacles = 0; // Non-structure static geometry touching the voxel
+
+		bool IsEmpty() const { return Touching == 0 && Obstacles == 0; }
+	};
+
+	static FIntVector ToVoxel(const FVector& Location);
+
+	/* Calls Func(VoxelCoord, bSolid) for every voxel under the box AABB */
+	template <typename FuncType>
+	static void ForEachVoxel(const FOrionOrientedBox& Box, FuncType&& Func);
+
+	TMap<FIntVector, FVoxel> Voxels;
+	TMap<int32, FOrionOrientedBox> Structures;
+};
@@ -0,0 +1,439 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionRoomDetector.h"
+
+void FOrionRoomDetector::AddWall(const int32 Key, const FOrionOrientedBox& WallBox)
+{
+	// Walls stand upright: the segment runs along whichever horizontal box axis is longer
+	const bool bAlongX = WallBox.Extent.X >= WallBox.Extent.Y;
+	const FVector Axis = (bAlongX ? WallBox.Rotation.GetAxisX() : WallBox.Rotation.GetAxisY()).GetSafeNormal2D();
+	const FVector HalfSegment = Axis * (bAlongX ? WallBox.Extent.X : WallBox.Extent.Y);
+
+	AddWall(Key, WallBox.Center - HalfSegment, WallBox.Center + HalfSegment);
+}
+
+void FOrionRoomDetector::AddWall(const int32 Key, const FVector& Start, const FVector& End)
+{
+	RemoveWall(Key);
+
+	const int32 Level = GetLevel((Start.Z + End.Z) * 0.5f);
+	const int32 CornerA = FindOrAddCorner(FVector2D(Start), Level);
+	const int32 CornerB = FindOrAddCorner(FVector2D(End), Level);
+
+	if (CornerA == CornerB)
+	{
+		// Degenerate (shorter than the weld distance): nothing to enclose with
+		if (Corners[CornerA].Walls.Num() == 0)
+		{
+			CornerByKey.Remove(Corners[CornerA].Key);
+			Corners.RemoveAt(CornerA);
+		}
+		return;
+	}
+
+	FWall Wall;
+	Wall.Corners[0] = CornerA;
+	Wall.Corners[1] = CornerB;
+	Wall.Length = FVector2D::Distance(Corners[CornerA].Position, Corners[CornerB].Position);
+	Walls.Add(Key, Wall);
+
+	Corners[CornerA].Walls.Add(Key);
+	Corners[CornerB].Walls.Add(Key);
+
+	DirtyCorners.Add(CornerA);
+	DirtyCorners.Add(CornerB);
+}
+
+void FOrionRoomDetector::RemoveWall(const int32 Key)
+{
+	FWall* Wall = Walls.Find(Key);
+	if (!Wall)
+	{
+		return;
+	}
+
+	// Rooms closed by this wall are open now
+	RemoveRoom(Wall->Rooms[0]);
+	RemoveRoom(Wall->Rooms[1]);
+
+	const int32 WallCorners[2] = {Wall->Corners[0], Wall->Corners[1]};
+	Walls.Remove(Key);
+
+	for (const int32 CornerId : WallCorners)
+	{
+		FCorner& Corner = Corners[CornerId];
+		Corner.Walls.RemoveSingleSwap(Key, EAllowShrinking::No);
+
+		if (Corner.Walls.Num() == 0)
+		{
+			CornerByKey.Remove(Corner.Key);
+			Corners.RemoveAt(CornerId);
+			DirtyCorners.Remove(CornerId);
+		}
+		else
+		{
+			DirtyCorners.Add(CornerId);
+		}
+	}
+}
+
+void FOrionRoomDetector::Reset()
+{
+	Corners.Empty();
+	CornerByKey.Empty();
+	Walls.Empty();
+	Rooms.Empty();
+	RoomCells.Empty();
+	DirtyCorners.Empty();
+}
+
+int32 FOrionRoomDetector::FindOrAddCorner(const FVector2D& Position, const int32 Level)
+{
+	const FIntVector Key(FMath::RoundToInt(Position.X / CornerWeld), FMath::RoundToInt(Position.Y / CornerWeld), Level);
+
+	// Two ends a few mm apart can round to neighbouring keys: look around before adding a new corner
+	for (int32 dx = -1; dx <= 1; ++dx)
+	{
+		for (int32 dy = -1; dy <= 1; ++dy)
+		{
+			if (const int32* Existing = CornerByKey.Find(Key + FIntVector(dx, dy, 0));
+				Existing && FVector2D::DistSquared(Corners[*Existing].Position, Position) <= FMath::Square(CornerWeld))
+			{
+				return *Existing;
+			}
+		}
+	}
+
+	FCorner Corner;
+	Corner.Position = Position;
+	Corner.Key = Key;
+
+	const int32 CornerId = Corners.Add(MoveTemp(Corner));
+	CornerByKey.Add(Key, CornerId);
+	return CornerId;
+}
+
+FIntPoint FOrionRoomDetector::NextHalfEdge(const FIntPoint& HalfEdge) const
+{
+	const FWall& Wall = Walls.FindChecked(HalfEdge.X);
+	const FVector2D From = Corners[Wall.Corners[HalfEdge.Y]].Position;
+	const int32 ToId = Wall.Corners[1 - HalfEdge.Y];
+	const FCorner& To = Corners[ToId];
+
+	// Face on the left: leave the corner along the first edge clockwise from the way we came in.
+	// A dead end turns around onto the twin (delta 2π)
+	const double TwinAngle = FMath::Atan2(From.Y - To.Position.Y, From.X - To.Position.X);
+
+	FIntPoint Best(HalfEdge.X, 1 - HalfEdge.Y);
+	double BestDelta = UE_DOUBLE_TWO_PI;
+
+	for (const int32 OtherKey : To.Walls)
+	{
+		if (OtherKey == HalfEdge.X)
+		{
+			continue;
+		}
+
+		const FWall& Other = Walls.FindChecked(OtherKey);
+		const int32 Side = Other.Corners[0] == ToId ? 0 : 1;
+		const FVector2D OtherEnd = Corners[Other.Corners[1 - Side]].Position;
+
+		double Delta = TwinAngle - FMath::Atan2(OtherEnd.Y - To.Position.Y, OtherEnd.X - To.Position.X);
+		while (Delta <= 0.0) Delta += UE_DOUBLE_TWO_PI;
+		while (Delta > UE_DOUBLE_TWO_PI) Delta -= UE_DOUBLE_TWO_PI;
+
+		if (Delta < BestDelta)
+		{
+			BestDelta = Delta;
+			Best = FIntPoint(OtherKey, Side);
+		}
+	}
+
+	return Best;
+}
+
+void FOrionRoomDetector::TraceFace(const FIntPoint& Start, FFace& OutFace, TSet<FIntPoint>& Visited) const
+{
+	// Every half-edge belongs to exactly one face, the walk can't be longer than all of them
+	const int32 MaxSteps = Walls.Num() * 2;
+
+	FIntPoint HalfEdge = Start;
+	for (int32 Step = 0; Step < MaxSteps; ++Step)
+	{
+		Visited.Add(HalfEdge);
+		OutFace.HalfEdges.Add(HalfEdge);
+
+		const FWall& Wall = Walls.FindChecked(HalfEdge.X);
+		OutFace.Polygon.Add(Corners[Wall.Corners[HalfEdge.Y]].Position);
+
+		HalfEdge = NextHalfEdge(HalfEdge);
+		if (HalfEdge == Start)
+		{
+			break;
+		}
+	}
+
+	/* Shoelace, counter-clockwise (bounded) faces come out positive */
+	const int32 NumPoints = OutFace.Polygon.Num();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const FVector2D& A = OutFace.Polygon[i];
+		const FVector2D& B = OutFace.Polygon[(i + 1) % NumPoints];
+		OutFace.Area += A.X * B.Y - B.X * A.Y;
+	}
+	OutFace.Area *= 0.5;
+
+	// Outer faces are dropped anyway, and they are the long ones
+	if (OutFace.Area <= MinRoomArea)
+	{
+		return;
+	}
+
+	/* Walls walked on both sides stick into the face, they don't enclose anything */
+	const TSet<FIntPoint> FaceHalfEdges(OutFace.HalfEdges);
+	for (const FIntPoint& Edge : OutFace.HalfEdges)
+	{
+		if (!FaceHalfEdges.Contains(FIntPoint(Edge.X, 1 - Edge.Y)))
+		{
+			OutFace.Perimeter += Walls.FindChecked(Edge.X).Length;
+		}
+	}
+}
+
+int32 FOrionRoomDetector::AddRoom(FFace&& Face, const int32 Level)
+{
+	FOrionRoom Room;
+	Room.Level = Level;
+	Room.Area = Face.Area;
+	Room.Perimeter = Face.Perimeter;
+	Room.Polygon = MoveTemp(Face.Polygon);
+	Room.HalfEdges = MoveTemp(Face.HalfEdges);
+	for (const FVector2D& Point : Room.Polygon)
+	{
+		Room.Bounds += Point;
+	}
+
+	const int32 RoomId = Rooms.Add(MoveTemp(Room));
+	const FOrionRoom& Added = Rooms[RoomId];
+
+	for (const FIntPoint& HalfEdge : Added.HalfEdges)
+	{
+		Walls.FindChecked(HalfEdge.X).Rooms[HalfEdge.Y] = RoomId;
+	}
+
+	/* Rasterize: cells whose center is inside the polygon (even-odd, spikes cancel out) */
+	const FIntVector MinCell = ToCell(Added.Bounds.Min, Level);
+	const FIntVector MaxCell = ToCell(Added.Bounds.Max, Level);
+	const int32 NumPoints = Added.Polygon.Num();
+
+	for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+	{
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+		{
+			const FVector2D CellCenter((x + 0.5) * CellSize, (y + 0.5) * CellSize);
+
+			bool bInside = false;
+			for (int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++)
+			{
+				const FVector2D& A = Added.Polygon[i];
+				const FVector2D& B = Added.Polygon[j];
+				if ((A.Y > CellCenter.Y) != (B.Y > CellCenter.Y) &&
+					CellCenter.X < (B.X - A.X) * (CellCenter.Y - A.Y) / (B.Y - A.Y) + A.X)
+				{
+					bInside = !bInside;
+				}
+			}
+
+			if (bInside)
+			{
+				RoomCells.FindOrAdd(FIntVector(x, y, Level)).Add(RoomId);
+			}
+		}
+	}
+
+	return RoomId;
+}
+
+void FOrionRoomDetector::RemoveRoom(const int32 RoomId)
+{
+	if (!Rooms.IsValidIndex(RoomId))
+	{
+		return;
+	}
+
+	const FOrionRoom& Room = Rooms[RoomId];
+
+	for (const FIntPoint& HalfEdge : Room.HalfEdges)
+	{
+		if (FWall* Wall = Walls.Find(HalfEdge.X); Wall && Wall->Rooms[HalfEdge.Y] == RoomId)
+		{
+			Wall->Rooms[HalfEdge.Y] = INDEX_NONE;
+		}
+	}
+
+	const FIntVector MinCell = ToCell(Room.Bounds.Min, Room.Level);
+	const FIntVector MaxCell = ToCell(Room.Bounds.Max, Room.Level);
+	for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+	{
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+		{
+			const FIntVector Cell(x, y, Room.Level);
+			if (auto* CellRooms = RoomCells.Find(Cell))
+			{
+				CellRooms->RemoveSingleSwap(RoomId, EAllowShrinking::No);
+				if (CellRooms->Num() == 0)
+				{
+					RoomCells.Remove(Cell);
+				}
+			}
+		}
+	}
+
+	Rooms.RemoveAt(RoomId);
+}
+
+void FOrionRoomDetector::Update()
+{
+	TSet<int32> VisitedCorners;
+	TArray<int32> Queue;
+	TArray<int32> ComponentWalls;
+	TSet<int32> ComponentWallSet;
+
+	for (const int32 DirtyCorner : DirtyCorners)
+	{
+		if (!Corners.IsValidIndex(DirtyCorner) || VisitedCorners.Contains(DirtyCorner))
+		{
+			continue;
+		}
+
+		/* 1. Connected walls around the changed corner (one level: corners are keyed per level) */
+		ComponentWalls.Reset();
+		ComponentWallSet.Reset();
+		Queue.Reset();
+		Queue.Add(DirtyCorner);
+		VisitedCorners.Add(DirtyCorner);
+
+		while (Queue.Num() > 0)
+		{
+			const FCorner& Corner = Corners[Queue.Pop(EAllowShrinking::No)];
+			for (const int32 WallKey : Corner.Walls)
+			{
+				bool bAlreadyInSet = false;
+				ComponentWallSet.Add(WallKey, &bAlreadyInSet);
+				if (bAlreadyInSet)
+				{
+					continue;
+				}
+				ComponentWalls.Add(WallKey);
+
+				for (const int32 Next : Walls.FindChecked(WallKey).Corners)
+				{
+					if (!VisitedCorners.Contains(Next))
+					{
+						VisitedCorners.Add(Next);
+						Queue.Add(Next);
+					}
+				}
+			}
+		}
+
+		const int32 Level = Corners[DirtyCorner].Key.Z;
+
+		/* 2. Trace every face of the component, keep the bounded ones */
+		TSet<FIntPoint> VisitedHalfEdges;
+		TArray<FFace> Faces;
+		for (const int32 WallKey : ComponentWalls)
+		{
+			for (int32 Side = 0; Side < 2; ++Side)
+			{
+				if (const FIntPoint HalfEdge(WallKey, Side); !VisitedHalfEdges.Contains(HalfEdge))
+				{
+					FFace Face;
+					TraceFace(HalfEdge, Face, VisitedHalfEdges);
+					if (Face.Area > MinRoomArea)
+					{
+						Faces.Add(MoveTemp(Face));
+					}
+				}
+			}
+		}
+
+		/* 3. Faces with exactly the boundary of an existing room keep it (and its id) */
+		TSet<int32> KeptRooms;
+		TArray<FFace> NewFaces;
+		for (FFace& Face : Faces)
+		{
+			const FIntPoint& First = Face.HalfEdges[0];
+			const int32 OldRoom = Walls.FindChecked(First.X).Rooms[First.Y];
+
+			bool bSame = Rooms.IsValidIndex(OldRoom) && Rooms[OldRoom].HalfEdges.Num() == Face.HalfEdges.Num();
+			for (int32 i = 1; bSame && i < Face.HalfEdges.Num(); ++i)
+			{
+				bSame = Walls.FindChecked(Face.HalfEdges[i].X).Rooms[Face.HalfEdges[i].Y] == OldRoom;
+			}
+
+			if (bSame)
+			{
+				KeptRooms.Add(OldRoom);
+			}
+			else
+			{
+				NewFaces.Add(MoveTemp(Face));
+			}
+		}
+
+		/* 4. Drop the rooms that no longer exist, add the new ones */
+		for (const int32 WallKey : ComponentWalls)
+		{
+			for (const int32 RoomId : Walls.FindChecked(WallKey).Rooms)
+			{
+				if (RoomId != INDEX_NONE && !KeptRooms.Contains(RoomId))
+				{
+					RemoveRoom(RoomId);
+				}
+			}
+		}
+
+		for (FFace& Face : NewFaces)
+		{
+			AddRoom(MoveTemp(Face), Level);
+		}
+	}
+
+	DirtyCorners.Reset();
+}
+
+int32 FOrionRoomDetector::FindRoomAt(const FVector& Location) const
+{
+	const auto* CellRooms = RoomCells.Find(ToCell(FVector2D(Location), GetLevel(Location.Z)));
+	if (!CellRooms)
+	{
+		return INDEX_NONE;
+	}
+
+	// Nested rooms: the innermost (smallest) one
+	int32 Best = INDEX_NONE;
+	for (const int32 RoomId : *CellRooms)
+	{
+		if (Best == INDEX_NONE || Rooms[RoomId].Area < Rooms[Best].Area)
+		{
+			Best = RoomId;
+		}
+	}
+	return Best;
+}
+
+FString FOrionRoomDetector::ToCsv() const
+{
+	FString Csv = TEXT("RoomId,Level,Area,Perimeter,NumEdges,CenterX,CenterY\n");
+
+	ForEachRoom([&Csv](const int32 RoomId, const FOrionRoom& Room)
+	{
+		const FVector2D Center = Room.Bounds.GetCenter();
+		Csv += FString::Printf(TEXT("%d,%d,%.1f,%.1f,%d,%.1f,%.1f\n"),
+		                       RoomId, Room.Level, Room.Area, Room.Perimeter, Room.HalfEdges.Num(), Center.X, Center.Y);
+	});
+
+	return Csv;
+}
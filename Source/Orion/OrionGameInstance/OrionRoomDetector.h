@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+
+/* One enclosed area: a bounded face of the wall graph of a floor level */
+struct FOrionRoom
+{
+	int32 Level = 0;
+	double Area = 0.0;      // cm²
+	double Perimeter = 0.0; // cm, walls sticking into the room are not counted
+
+	TArray<FVector2D> Polygon; // Corners, counter-clockwise
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	// Half-edges bounding the room: (wall key, side), side 0 runs from the wall start to its end
+	TArray<FIntPoint> HalfEdges;
+};
+
+/**
+ * Runtime version of Scripts/BuildingAnalysis.py: finds the rooms enclosed by walls, per floor level.
+ *
+ * Walls are segments keyed by their structure graph node id (same keys as the box set / occupancy grid), their
+ * end points are welded into corners (walls only meet at their ends), and the rooms are the bounded faces of that
+ * planar graph, traced with the usual "next edge clockwise" rule. Changes only mark the touched corners dirty;
+ * Update() re-traces the connected wall components containing them and keeps the rooms whose boundary did not
+ * change (ids stay stable).
+ *
+ * Rooms are rasterized into CellSize cells per level, so FindRoomAt() is one hash lookup. A cell inside nested
+ * rooms answers the smallest one.
+ */
+class ORION_API FOrionRoomDetector
+{
+public:
+	static constexpr float FloorHeight = 300.f; // Wall height (2 * STRUCTURE_HEIGHT_BASE)
+	static constexpr float CornerWeld = 10.f;   // Wall ends closer than this share a corner
+	static constexpr float CellSize = 25.f;     // Lookup resolution, a triangle foundation is ~10 cells
+	static constexpr double MinRoomArea = 1000.0;
+
+	static int32 GetLevel(const float Z) { return FMath::FloorToInt(Z / FloorHeight); }
+
+	/* Wall segment along the longest horizontal axis of its box, at mid height */
+	void AddWall(int32 Key, const FOrionOrientedBox& WallBox);
+	void AddWall(int32 Key, const FVector& Start, const FVector& End);
+	void RemoveWall(int32 Key);
+	void Reset();
+
+	bool IsDirty() const { return DirtyCorners.Num() > 0; }
+
+	/* Re-traces the wall components changed since the last update */
+	void Update();
+
+	/* Room containing Location (its level from Z), INDEX_NONE if outside. Call Update() first */
+	int32 FindRoomAt(const FVector& Location) const;
+
+	const FOrionRoom* GetRoom(const int32 RoomId) const
+	{
+		return Rooms.IsValidIndex(RoomId) ? &Rooms[RoomId] : nullptr;
+	}
+
+	template <typename FuncType>
+	void ForEachRoom(FuncType&& Func) const
+	{
+		for (auto It = Rooms.CreateConstIterator(); It; ++It)
+		{
+			Func(It.GetIndex(), *It);
+		}
+	}
+
+	int32 NumRooms() const { return Rooms.Num(); }
+	int32 NumWalls() const { return Walls.Num(); }
+
+	/* RoomId,Level,Area,Perimeter,NumEdges,CenterX,CenterY per room (debugging output) */
+	FString ToCsv() const;
+
+private:
+	struct FCorner
+	{
+		FVector2D Position;
+		FIntVector Key;
+		TArray<int32, TInlineAllocator<4>> Walls;
+	};
+
+	struct FWall
+	{
+		int32 Corners[2] = {INDEX_NONE, INDEX_NONE};
+		int32 Rooms[2] = {INDEX_NONE, INDEX_NONE}; // Room on the left of each side
+		double Length = 0.0;
+	};
+
+	// Result of tracing one face
+	struct FFace
+	{
+		TArray<FIntPoint> HalfEdges;
+		TArray<FVector2D> Polygon;
+		double Area = 0.0;
+		double Perimeter = 0.0;
+	};
+
+	int32 FindOrAddCorner(const FVector2D& Position, int32 Level);
+	void RemoveRoom(int32 RoomId);
+	int32 AddRoom(FFace&& Face, int32 Level);
+
+	FIntPoint NextHalfEdge(const FIntPoint& HalfEdge) const;
+	void TraceFace(const FIntPoint& Start, FFace& OutFace, TSet<FIntPoint>& Visited) const;
+
+	static FIntVector ToCell(const FVector2D& Position, const int32 Level)
+	{
+		return FIntVector(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize), Level);
+	}
+
+	TSparseArray<FCorner> Corners;
+	TMap<FIntVector, int32> CornerByKey;
+	TMap<int32, FWall> Walls;
+
+	TSparseArray<FOrionRoom> Rooms;
+	TMap<FIntVector, TArray<int32, TInlineAllocator<2>>> RoomCells;
+
+	TSet<int32> DirtyCorners;
+};
@@ -0,0 +1,366 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionSocketRegistry.h"
+#include "Algo/SortBy.h"
+
+int64 FOrionSocketRegistry::GetCellKey(const FVector& Location)
+{
+	const int32 X = FMath::FloorToInt(Location.X / CellSize);
+	const int32 Y = FMath::FloorToInt(Location.Y / CellSize);
+	return MakeCellKey(X, Y);
+}
+
+int32 FOrionSocketRegistry::FCellPartition::Add(const FOrionGlobalSocket& Socket, const int32 SocketId)
+{
+	Positions.Add(Socket.Location);
+	Rotations.Add(Socket.Rotation);
+	Scales.Add(Socket.Scale);
+	Owners.Add(Socket.Owner);
+	Flags.Add(Socket.bOccupied ? SF_Occupied : SF_None);
+	BlockerCounts.Add(0);
+	return SocketIds.Add(SocketId);
+}
+
+void FOrionSocketRegistry::FCellPartition::RemoveAtSwap(const int32 Slot)
+{
+	Positions.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Rotations.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Scales.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Owners.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	BlockerCounts.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	SocketIds.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+}
+
+template <typename FuncType>
+void FOrionSocketRegistry::ForEachWithinBlockDistance(const FVector& Location, FuncType&& Func)
+{
+	constexpr float BlockDistanceSqr = BlockDistance * BlockDistance;
+
+	// BlockDistance << CellSize, so the direct neighbour cells are always enough
+	const int64 CenterKey = GetCellKey(Location);
+	const int32 CenterX = CenterKey >> 32;
+	const int32 CenterY = static_cast<int32>(CenterKey);
+
+	for (int32 x = -1; x <= 1; ++x)
+	{
+		for (int32 y = -1; y <= 1; ++y)
+		{
+			FCell* Cell = Cells.Find(MakeCellKey(CenterX + x, CenterY + y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (FCellPartition& Partition : Cell->Partitions)
+			{
+				const int32 Count = Partition.Num();
+				for (int32 i = 0; i < Count; ++i)
+				{
+					if (FVector::DistSquared(Partition.Positions[i], Location) < BlockDistanceSqr)
+					{
+						Func(Partition, i);
+					}
+				}
+			}
+		}
+	}
+}
+
+uint16 FOrionSocketRegistry::CountBlockers(const FVector& Location)
+{
+	uint16 BlockerCount = 0;
+	ForEachWithinBlockDistance(Location, [&BlockerCount](const FCellPartition& Partition, const int32 i)
+	{
+		BlockerCount += (Partition.Flags[i] & SF_Occupied) ? 1 : 0;
+	});
+	return BlockerCount;
+}
+
+void FOrionSocketRegistry::AddBlocker(const FVector& Location, const int32 SelfSocketId)
+{
+	ForEachWithinBlockDistance(Location, [SelfSocketId](FCellPartition& Partition, const int32 i)
+	{
+		if (Partition.SocketIds[i] != SelfSocketId)
+		{
+			++Partition.BlockerCounts[i];
+			Partition.Flags[i] |= SF_Blocked;
+		}
+	});
+}
+
+int32 FOrionSocketRegistry::AddToCell(FCell& Cell, const int64 CellKey, const FOrionGlobalSocket& Socket,
+                                      const uint16 BlockerCount)
+{
+	const int32 KindIndex = static_cast<int32>(Socket.Kind);
+	FCellPartition& Partition = Cell.Partitions[KindIndex];
+
+	FSocketLocation Loc;
+	Loc.CellKey = CellKey;
+	Loc.Kind = Socket.Kind;
+
+	const int32 SocketId = Locations.Add(Loc);
+	const int32 Slot = Partition.Add(Socket, SocketId);
+	Partition.BlockerCounts[Slot] = BlockerCount;
+	if (BlockerCount > 0)
+	{
+		Partition.Flags[Slot] |= SF_Blocked;
+	}
+
+	Locations[SocketId].Slot = Slot;
+	Locations[SocketId].KindSlot = KindLists[KindIndex].Add(SocketId);
+	++Cell.Num;
+
+	if (AActor* Owner = Socket.Owner.Get())
+	{
+		OwnerIndex.FindOrAdd(Owner).Add(SocketId);
+	}
+
+	return SocketId;
+}
+
+int32 FOrionSocketRegistry::Register(const FOrionGlobalSocket& Socket)
+{
+	// Blocked state of the new socket: occupied neighbours already in the grid
+	const uint16 BlockerCount = CountBlockers(Socket.Location);
+
+	const int64 CellKey = GetCellKey(Socket.Location);
+	const int32 SocketId = AddToCell(Cells.FindOrAdd(CellKey), CellKey, Socket, BlockerCount);
+
+	// A new occupied socket blocks every neighbour within range
+	if (Socket.bOccupied)
+	{
+		AddBlocker(Socket.Location, SocketId);
+	}
+
+	return SocketId;
+}
+
+void FOrionSocketRegistry::RegisterBatch(const TConstArrayView<FOrionGlobalSocket> Sockets)
+{
+	const int32 Count = Sockets.Num();
+	if (Count == 0)
+	{
+		return;
+	}
+
+	/* 1. Blocked state against what is already in the grid (before any of the batch is inserted) */
+	TArray<uint16> BlockerCounts;
+	BlockerCounts.SetNumUninitialized(Count);
+
+	struct FKeyedIndex
+	{
+		int64 CellKey;
+		int32 Index;
+	};
+	TArray<FKeyedIndex> Order;
+	Order.SetNumUninitialized(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		BlockerCounts[i] = CountBlockers(Sockets[i].Location);
+		Order[i] = {GetCellKey(Sockets[i].Location), i};
+	}
+
+	/* 2. Insert grouped by cell: one map lookup per touched cell */
+	Algo::SortBy(Order, &FKeyedIndex::CellKey);
+
+	TArray<int32> SocketIds;
+	SocketIds.SetNumUninitialized(Count);
+
+	for (int32 Begin = 0; Begin < Count;)
+	{
+		const int64 CellKey = Order[Begin].CellKey;
+		FCell& Cell = Cells.FindOrAdd(CellKey);
+
+		int32 End = Begin;
+		for (; End < Count && Order[End].CellKey == CellKey; ++End)
+		{
+			const int32 Index = Order[End].Index;
+			SocketIds[Index] = AddToCell(Cell, CellKey, Sockets[Index], BlockerCounts[Index]);
+		}
+		Begin = End;
+	}
+
+	/* 3. Occupied sockets of the batch block their neighbours (old and new) */
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Sockets[i].bOccupied)
+		{
+			AddBlocker(Sockets[i].Location, SocketIds[i]);
+		}
+	}
+}
+
+int32 FOrionSocketRegistry::UnregisterOwner(const AActor* Owner)
+{
+	if (!Owner)
+	{
+		return 0;
+	}
+
+	TArray<int32> SocketIds;
+	if (!OwnerIndex.RemoveAndCopyValue(Owner, SocketIds))
+	{
+		return 0;
+	}
+
+	for (const int32 SocketId : SocketIds)
+	{
+		RemoveById(SocketId);
+	}
+
+	return SocketIds.Num();
+}
+
+void FOrionSocketRegistry::DetachOwner(const AActor* Owner, AActor* NewOwner, TArray<int32>& OutSocketIds)
+{
+	OutSocketIds.Reset();
+	if (!Owner || !OwnerIndex.RemoveAndCopyValue(Owner, OutSocketIds))
+	{
+		return;
+	}
+
+	for (const int32 SocketId : OutSocketIds)
+	{
+		const FSocketLocation& Loc = Locations[SocketId];
+		Cells.FindChecked(Loc.CellKey).Partitions[static_cast<int32>(Loc.Kind)].Owners[Loc.Slot] = NewOwner;
+	}
+}
+
+void FOrionSocketRegistry::UnregisterIds(const TConstArrayView<int32> SocketIds)
+{
+	for (const int32 SocketId : SocketIds)
+	{
+		if (Locations.IsValidIndex(SocketId))
+		{
+			RemoveById(SocketId);
+		}
+	}
+}
+
+void FOrionSocketRegistry::RemoveById(const int32 SocketId)
+{
+	const FSocketLocation Loc = Locations[SocketId];
+	const int32 KindIndex = static_cast<int32>(Loc.Kind);
+
+	/* Cell partition: swap-remove, then patch the slot of the socket that moved into the hole */
+	FCell& Cell = Cells.FindChecked(Loc.CellKey);
+	FCellPartition& Partition = Cell.Partitions[KindIndex];
+
+	const FVector Location = Partition.Positions[Loc.Slot];
+	const bool bWasOccupied = (Partition.Flags[Loc.Slot] & SF_Occupied) != 0;
+
+	Partition.RemoveAtSwap(Loc.Slot);
+	if (Partition.SocketIds.IsValidIndex(Loc.Slot))
+	{
+		Locations[Partition.SocketIds[Loc.Slot]].Slot = Loc.Slot;
+	}
+
+	if (--Cell.Num == 0)
+	{
+		Cells.Remove(Loc.CellKey);
+	}
+
+	/* Kind list: same scheme */
+	TArray<int32>& KindList = KindLists[KindIndex];
+	KindList.RemoveAtSwap(Loc.KindSlot, 1, EAllowShrinking::No);
+	if (KindList.IsValidIndex(Loc.KindSlot))
+	{
+		Locations[KindList[Loc.KindSlot]].KindSlot = Loc.KindSlot;
+	}
+
+	Locations.RemoveAt(SocketId);
+
+	/* Release the neighbours this socket was blocking (itself is already gone) */
+	if (bWasOccupied)
+	{
+		ForEachWithinBlockDistance(Location, [](FCellPartition& Neighbour, const int32 i)
+		{
+			if (Neighbour.BlockerCounts[i] > 0 && --Neighbour.BlockerCounts[i] == 0)
+			{
+				Neighbour.Flags[i] &= ~SF_Blocked;
+			}
+		});
+	}
+}
+
+void FOrionSocketRegistry::Reset()
+{
+	Locations.Empty();
+	Cells.Empty();
+	for (TArray<int32>& KindList : KindLists)
+	{
+		KindList.Empty();
+	}
+	OwnerIndex.Empty();
+}
+
+FOrionGlobalSocket FOrionSocketRegistry::GetSocket(const int32 SocketId) const
+{
+	const FSocketLocation& Loc = Locations[SocketId];
+	const FCellPartition& Partition = Cells.FindChecked(Loc.CellKey).Partitions[static_cast<int32>(Loc.Kind)];
+	const int32 i = Loc.Slot;
+
+	FOrionGlobalSocket Socket(Partition.Positions[i], Partition.Rotations[i], Loc.Kind,
+	                          (Partition.Flags[i] & SF_Occupied) != 0, nullptr, Partition.Scales[i]);
+	Socket.Owner = Partition.Owners[i];
+	return Socket;
+}
+
+bool FOrionSocketRegistry::IsBlocked(const int32 SocketId) const
+{
+	const FSocketLocation& Loc = Locations[SocketId];
+	const FCellPartition& Partition = Cells.FindChecked(Loc.CellKey).Partitions[static_cast<int32>(Loc.Kind)];
+	return Partition.Flags[Loc.Slot] != SF_None;
+}
+
+int32 FOrionSocketRegistry::FindNearest(const FVector& QueryPos, const float Radius, const EOrionStructure Kind) const
+{
+	const int32 KindIndex = static_cast<int32>(Kind);
+	float MinDistSqr = Radius * Radius;
+	int32 BestSocketId = INDEX_NONE;
+
+	const int64 CenterKey = GetCellKey(QueryPos);
+	const int32 CenterX = CenterKey >> 32;
+	const int32 CenterY = static_cast<int32>(CenterKey);
+
+	for (int32 x = -1; x <= 1; ++x)
+	{
+		for (int32 y = -1; y <= 1; ++y)
+		{
+			const FCell* Cell = Cells.Find(MakeCellKey(CenterX + x, CenterY + y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			const FCellPartition& Partition = Cell->Partitions[KindIndex];
+			const FVector* Positions = Partition.Positions.GetData();
+			const uint8* Flags = Partition.Flags.GetData();
+			const int32 Count = Partition.Num();
+
+			for (int32 i = 0; i < Count; ++i)
+			{
+				// Distance early-out first; Flags covers both "occupied" and "blocked by an occupied neighbour"
+				const float DistSqr = FVector::DistSquared(Positions[i], QueryPos);
+				if (DistSqr > MinDistSqr || Flags[i] != SF_None)
+				{
+					continue;
+				}
+
+				// [Safe] Owner check only for sockets that would actually win
+				if (!Partition.Owners[i].IsValid())
+				{
+					continue;
+				}
+
+				MinDistSqr = DistSqr;
+				BestSocketId = Partition.SocketIds[i];
+			}
+		}
+	}
+
+	return BestSocketId;
+}
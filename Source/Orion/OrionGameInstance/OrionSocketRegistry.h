@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+#include "UObject/ObjectKey.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+
+/**
+ * Global snapping socket storage used by UOrionBuildingManager.
+ *
+ * Sockets live in a spatial hash of cells, each cell partitioned by socket kind.
+ * Every socket gets a stable id (index into a sparse array) that records where it currently lives
+ * (cell key, kind, slot); storage inside a partition uses swap-remove and patches the moved socket's slot.
+ * An owner index maps each structure to its socket ids, so registering / removing one structure
+ * costs O(sockets of that structure) instead of a scan over the whole grid.
+ * The per-kind lists (formerly UOrionBuildingManager::SocketsByKind) are part of the same bookkeeping.
+ *
+ * Partitions are stored as SoA so the snapping query only touches positions and flags.
+ * "Blocked" (an occupied socket of any kind within BlockDistance) is maintained incrementally on
+ * register / unregister, so FindNearest is a single branch-light pass without allocation.
+ */
+class ORION_API FOrionSocketRegistry
+{
+public:
+	static constexpr float CellSize = 500.f;
+	static constexpr float BlockDistance = 5.f; // Blocked if Occupied within 5cm
+	static constexpr int32 NumKinds = static_cast<int32>(EOrionStructure::InclinedRoof) + 1;
+
+	static int64 GetCellKey(const FVector& Location);
+
+	static int64 MakeCellKey(const int32 X, const int32 Y)
+	{
+		return (static_cast<int64>(X) << 32) | static_cast<uint32>(Y); // High 32 bits store X, Low 32 bits store Y
+	}
+
+	/** Returns the stable socket id */
+	int32 Register(const FOrionGlobalSocket& Socket);
+
+	/**
+	 * Registers many sockets at once (structure templates, bulk loads).
+	 * Sockets are grouped by cell so each touched cell is looked up / inserted once.
+	 */
+	void RegisterBatch(TConstArrayView<FOrionGlobalSocket> Sockets);
+
+	/** Removes every socket owned by Owner, returns how many were removed */
+	int32 UnregisterOwner(const AActor* Owner);
+
+	/**
+	 * Hands every socket of Owner over to NewOwner and drops them from the owner index,
+	 * so they are addressed by id only from now on (instanced structures share one owner actor).
+	 */
+	void DetachOwner(const AActor* Owner, AActor* NewOwner, TArray<int32>& OutSocketIds);
+
+	/** Removes sockets by id (ids from DetachOwner) */
+	void UnregisterIds(TConstArrayView<int32> SocketIds);
+
+	void Reset();
+
+	int32 Num() const { return Locations.Num(); }
+
+	bool IsValidId(const int32 SocketId) const { return Locations.IsValidIndex(SocketId); }
+
+	/** Gathers the SoA columns of one socket back into the AoS struct */
+	FOrionGlobalSocket GetSocket(int32 SocketId) const;
+
+	bool IsBlocked(int32 SocketId) const;
+
+	const TArray<int32>& GetSocketIdsByKind(const EOrionStructure Kind) const
+	{
+		return KindLists[static_cast<int32>(Kind)];
+	}
+
+	const TArray<int32>* GetSocketIdsByOwner(const AActor* Owner) const
+	{
+		return OwnerIndex.Find(Owner);
+	}
+
+	/**
+	 * Nearest free socket of Kind within Radius of QueryPos (3x3 cells around the query).
+	 * Skips occupied / blocked sockets and sockets whose owner is gone. No heap allocation.
+	 * @return socket id, INDEX_NONE if nothing matched
+	 */
+	int32 FindNearest(const FVector& QueryPos, float Radius, EOrionStructure Kind) const;
+
+private:
+	enum ESocketFlags : uint8
+	{
+		SF_None = 0,
+		SF_Occupied = 1 << 0,
+		SF_Blocked = 1 << 1, // BlockerCount > 0
+	};
+
+	/* Where a stable socket id currently lives */
+	struct FSocketLocation
+	{
+		int64 CellKey = 0;
+		EOrionStructure Kind = EOrionStructure::None;
+		int32 Slot = INDEX_NONE;     // Index inside the cell partition
+		int32 KindSlot = INDEX_NONE; // Index inside KindLists[Kind]
+	};
+
+	/* One kind inside one cell, all columns share the same index */
+	struct FCellPartition
+	{
+		TArray<FVector> Positions;
+		TArray<FRotator> Rotations;
+		TArray<FVector> Scales;
+		TArray<TWeakObjectPtr<AActor>> Owners;
+		TArray<uint8> Flags;
+		TArray<uint16> BlockerCounts; // Occupied sockets (any kind, excluding self) within BlockDistance
+		TArray<int32> SocketIds;
+
+		int32 Num() const { return SocketIds.Num(); }
+
+		int32 Add(const FOrionGlobalSocket& Socket, int32 SocketId);
+		void RemoveAtSwap(int32 Slot);
+	};
+
+	struct FCell
+	{
+		FCellPartition Partitions[NumKinds];
+		int32 Num = 0;
+	};
+
+	/* Calls Func(FCellPartition&, Slot) for every socket of any kind within BlockDistance of Location */
+	template <typename FuncType>
+	void ForEachWithinBlockDistance(const FVector& Location, FuncType&& Func);
+
+	/* Appends to the cell and all indices, returns the new socket id */
+	int32 AddToCell(FCell& Cell, int64 CellKey, const FOrionGlobalSocket& Socket, uint16 BlockerCount);
+
+	/* Counts occupied sockets within BlockDistance of Location */
+	uint16 CountBlockers(const FVector& Location);
+
+	/* Marks every socket within BlockDistance of an occupied socket as blocked, except the socket itself */
+	void AddBlocker(const FVector& Location, int32 SelfSocketId);
+
+	void RemoveById(int32 SocketId);
+
+	TSparseArray<FSocketLocation> Locations;
+	TMap<int64, FCell> Cells;
+	TArray<int32> KindLists[NumKinds];
+	TMap<TObjectKey<AActor>, TArray<int32>> OwnerIndex;
+};
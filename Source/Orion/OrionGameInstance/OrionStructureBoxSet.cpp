@@ -0,0 +1,203 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionStructureBoxSet.h"
+
+bool FOrionStructureBoxSet::Intersects(const FOrionOrientedBox& A, const FOrionOrientedBox& B, const float Tolerance)
+{
+	// Ericson, Real-Time Collision Detection 4.4.1, everything expressed in A's frame
+	const FVector AxesA[3] = {A.Rotation.GetAxisX(), A.Rotation.GetAxisY(), A.Rotation.GetAxisZ()};
+	const FVector AxesB[3] = {B.Rotation.GetAxisX(), B.Rotation.GetAxisY(), B.Rotation.GetAxisZ()};
+
+	const FVector ExtentA = (A.Extent + FVector(Tolerance)).ComponentMax(FVector::ZeroVector);
+	const FVector& ExtentB = B.Extent;
+
+	// Epsilon on |R| keeps the cross axes robust when edges are (nearly) parallel, e.g. walls on a foundation
+	constexpr double ParallelEpsilon = 1e-6;
+
+	double R[3][3];
+	double AbsR[3][3];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		for (int32 j = 0; j < 3; ++j)
+		{
+			R[i][j] = FVector::DotProduct(AxesA[i], AxesB[j]);
+			AbsR[i][j] = FMath::Abs(R[i][j]) + ParallelEpsilon;
+		}
+	}
+
+	const FVector Delta = B.Center - A.Center;
+	const double T[3] = {
+		FVector::DotProduct(Delta, AxesA[0]),
+		FVector::DotProduct(Delta, AxesA[1]),
+		FVector::DotProduct(Delta, AxesA[2])
+	};
+
+	/* 1. Face axes of A */
+	for (int32 i = 0; i < 3; ++i)
+	{
+		const double RadiusB = ExtentB.X * AbsR[i][0] + ExtentB.Y * AbsR[i][1] + ExtentB.Z * AbsR[i][2];
+		if (FMath::Abs(T[i]) > ExtentA[i] + RadiusB)
+		{
+			return false;
+		}
+	}
+
+	/* 2. Face axes of B */
+	for (int32 j = 0; j < 3; ++j)
+	{
+		const double RadiusA = ExtentA.X * AbsR[0][j] + ExtentA.Y * AbsR[1][j] + ExtentA.Z * AbsR[2][j];
+		const double Distance = T[0] * R[0][j] + T[1] * R[1][j] + T[2] * R[2][j];
+		if (FMath::Abs(Distance) > RadiusA + ExtentB[j])
+		{
+			return false;
+		}
+	}
+
+	/* 3. Edge x edge axes A_i x B_j */
+	for (int32 i = 0; i < 3; ++i)
+	{
+		const int32 i1 = (i + 1) % 3;
+		const int32 i2 = (i + 2) % 3;
+
+		for (int32 j = 0; j < 3; ++j)
+		{
+			const int32 j1 = (j + 1) % 3;
+			const int32 j2 = (j + 2) % 3;
+
+			const double RadiusA = ExtentA[i1] * AbsR[i2][j] + ExtentA[i2] * AbsR[i1][j];
+			const double RadiusB = ExtentB[j1] * AbsR[i][j2] + ExtentB[j2] * AbsR[i][j1];
+			const double Distance = T[i2] * R[i1][j] - T[i1] * R[i2][j];
+			if (FMath::Abs(Distance) > RadiusA + RadiusB)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+FIntPoint FOrionStructureBoxSet::ToCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FOrionStructureBoxSet::Add(const int32 Key, const FOrionOrientedBox& Box)
+{
+	Remove(Key);
+
+	const FBox Bounds = Box.GetAABB();
+
+	FEntry Entry;
+	Entry.Box = Box;
+	Entry.MinCell = ToCell(Bounds.Min);
+	Entry.MaxCell = ToCell(Bounds.Max);
+
+	for (int32 x = Entry.MinCell.X; x <= Entry.MaxCell.X; ++x)
+	{
+		for (int32 y = Entry.MinCell.Y; y <= Entry.MaxCell.Y; ++y)
+		{
+			Cells.FindOrAdd(MakeCellKey(x, y)).Add(Key);
+		}
+	}
+
+	Entries.Add(Key, Entry);
+}
+
+void FOrionStructureBoxSet::Remove(const int32 Key)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	for (int32 x = Entry.MinCell.X; x <= Entry.MaxCell.X; ++x)
+	{
+		for (int32 y = Entry.MinCell.Y; y <= Entry.MaxCell.Y; ++y)
+		{
+			const int64 CellKey = MakeCellKey(x, y);
+			if (TArray<int32>* Cell = Cells.Find(CellKey))
+			{
+				Cell->RemoveSingleSwap(Key, EAllowShrinking::No);
+				if (Cell->Num() == 0)
+				{
+					Cells.Remove(CellKey);
+				}
+			}
+		}
+	}
+}
+
+void FOrionStructureBoxSet::Reset()
+{
+	Entries.Empty();
+	Cells.Empty();
+}
+
+template <typename FuncType>
+void FOrionStructureBoxSet::ForEachCandidate(const FBox& Bounds, FuncType&& Func) const
+{
+	const FIntPoint MinCell = ToCell(Bounds.Min);
+	const FIntPoint MaxCell = ToCell(Bounds.Max);
+
+	// A box spanning several cells is listed in each of them: only report it from the first visited cell it shares
+	for (int32 x = MinCell.X; x <= MaxCell.X; ++x)
+	{
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; ++y)
+		{
+			const TArray<int32>* Cell = Cells.Find(MakeCellKey(x, y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 Key : *Cell)
+			{
+				const FEntry& Entry = Entries.FindChecked(Key);
+				const int32 FirstX = FMath::Max(MinCell.X, Entry.MinCell.X);
+				const int32 FirstY = FMath::Max(MinCell.Y, Entry.MinCell.Y);
+				if (x != FirstX || y != FirstY)
+				{
+					continue;
+				}
+
+				if (!Func(Key, Entry.Box))
+				{
+					return;
+				}
+			}
+		}
+	}
+}
+
+void FOrionStructureBoxSet::QueryIntersecting(const FOrionOrientedBox& Box, const float Tolerance, TArray<int32>& OutKeys,
+                                              const int32 IgnoredKey) const
+{
+	FBox Bounds = Box.GetAABB();
+	if (Tolerance > 0.f)
+	{
+		Bounds = Bounds.ExpandBy(Tolerance);
+	}
+
+	ForEachCandidate(Bounds, [&Box, Tolerance, &OutKeys, IgnoredKey](const int32 Key, const FOrionOrientedBox& Other)
+	{
+		if (Key != IgnoredKey && Intersects(Box, Other, Tolerance))
+		{
+			OutKeys.Add(Key);
+		}
+		return true;
+	});
+}
+
+bool FOrionStructureBoxSet::AnyOverlapping(const FOrionOrientedBox& Box, const int32 IgnoredKey) const
+{
+	bool bFound = false;
+	ForEachCandidate(Box.GetAABB(), [&Box, &bFound, IgnoredKey](const int32 Key, const FOrionOrientedBox& Other)
+	{
+		bFound = Key != IgnoredKey && Intersects(Box, Other, OverlapTolerance);
+		return !bFound;
+	});
+	return bFound;
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Orion/OrionGlobals/OrionStructureData.h"
+
+/**
+ * In-memory oriented boxes of every placed structure, used by UOrionBuildingManager for neighbour and blocker
+ * queries between structures instead of going to the physics scene (no scene locks, callable from any thread
+ * that owns the set, no world needed).
+ *
+ * Boxes are keyed by structure graph node id and bucketed in a 2D spatial hash (same cell scheme as the socket
+ * registry); a query gathers candidates from the cells under its AABB and runs a separating axis test on each.
+ * Intersects() is a pure function of two boxes so it can be checked in isolation.
+ */
+class ORION_API FOrionStructureBoxSet
+{
+public:
+	static constexpr float CellSize = 500.f;
+
+	// Adjacency tolerance: same 5cm padding the physics neighbour query used
+	static constexpr float TouchTolerance = 5.f;
+
+	// Faces that merely touch are not an overlap (blocker queries)
+	static constexpr float OverlapTolerance = -0.1f;
+
+	/**
+	 * Separating axis test (15 axes) between two oriented boxes.
+	 * A is grown by Tolerance on every axis first (negative shrinks it), so Tolerance > 0 is a "touch" test.
+	 */
+	static bool Intersects(const FOrionOrientedBox& A, const FOrionOrientedBox& B, float Tolerance = 0.f);
+
+	void Add(int32 Key, const FOrionOrientedBox& Box);
+	void Remove(int32 Key);
+	void Reset();
+
+	const FOrionOrientedBox* Find(const int32 Key) const
+	{
+		const FEntry* Entry = Entries.Find(Key);
+		return Entry ? &Entry->Box : nullptr;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+
+	template <typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (const TPair<int32, FEntry>& Pair : Entries)
+		{
+			Func(Pair.Key, Pair.Value.Box);
+		}
+	}
+
+	/* Keys of the boxes within Tolerance of Box (IgnoredKey excluded) */
+	void QueryIntersecting(const FOrionOrientedBox& Box, float Tolerance, TArray<int32>& OutKeys,
+	                       int32 IgnoredKey = INDEX_NONE) const;
+
+	/* Neighbours: boxes touching Box within TouchTolerance */
+	void QueryTouching(const FOrionOrientedBox& Box, TArray<int32>& OutKeys, const int32 IgnoredKey = INDEX_NONE) const
+	{
+		QueryIntersecting(Box, TouchTolerance, OutKeys, IgnoredKey);
+	}
+
+	/* Blockers: true if any box really overlaps Box */
+	bool AnyOverlapping(const FOrionOrientedBox& Box, int32 IgnoredKey = INDEX_NONE) const;
+
+private:
+	struct FEntry
+	{
+		FOrionOrientedBox Box;
+		FIntPoint MinCell;
+		FIntPoint MaxCell;
+	};
+
+	static FIntPoint ToCell(const FVector& Location);
+
+	static int64 MakeCellKey(const int32 X, const int32 Y)
+	{
+		return (static_cast<int64>(X) << 32) | static_cast<uint32>(Y);
+	}
+
+	/* Calls Func(Key) once per candidate box whose cells overlap Bounds; Func returns false to stop */
+	template <typename FuncType>
+	void ForEachCandidate(const FBox& Bounds, FuncType&& Func) const;
+
+	TMap<int32, FEntry> Entries;
+	TMap<int64, TArray<int32>> Cells;
+};
@@ -0,0 +1,435 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionStructureGraph.h"
+#include "Orion/OrionComponents/OrionStructureComponent.h"
+
+namespace
+{
+	constexpr float StabilityEpsilon = 0.001f;
+
+	struct FStabilityHeapEntry
+	{
+		float Stability;
+		int32 Index;
+	};
+
+	// Max-heap on stability: the most stable node is expanded first
+	struct FStabilityHeapPredicate
+	{
+		bool operator()(const FStabilityHeapEntry& A, const FStabilityHeapEntry& B) const
+		{
+			return A.Stability > B.Stability;
+		}
+	};
+}
+
+int32 FOrionStructureGraph::AddNode(UOrionStructureComponent* Component, const float Decay, const bool bGrounded)
+{
+	checkf(Component && !ComponentToNode.Contains(Component),
+	       TEXT("FOrionStructureGraph::AddNode: Component is null or already registered."));
+
+	FNode Node;
+	Node.Component = Component;
+	Node.ComponentKey = Component;
+	Node.Decay = FMath::Max(Decay, StabilityEpsilon); // Keeps the support forest acyclic
+	Node.bGrounded = bGrounded;
+	Node.Stability = bGrounded ? 1.0f : 0.0f;
+	Node.StructureId = NextStructureId++; // Not rewound by Reset either
+
+	const int32 NodeId = Nodes.Add(MoveTemp(Node));
+	ComponentToNode.Add(Component, NodeId);
+	++Version;
+	return NodeId;
+}
+
+void FOrionStructureGraph::AddEdge(const int32 A, const int32 B)
+{
+	if (A == B || !Nodes.IsValidIndex(A) || !Nodes.IsValidIndex(B))
+	{
+		return;
+	}
+
+	if (!Nodes[A].Edges.Contains(B))
+	{
+		Nodes[A].Edges.Add(B);
+		Nodes[B].Edges.Add(A);
+		++Version;
+	}
+}
+
+void FOrionStructureGraph::SetGrounded(const int32 NodeId)
+{
+	if (Nodes.IsValidIndex(NodeId) && !Nodes[NodeId].bGrounded)
+	{
+		Nodes[NodeId].bGrounded = true;
+		++Version;
+	}
+}
+
+void FOrionStructureGraph::RemoveNode(const int32 NodeId)
+{
+	if (!Nodes.IsValidIndex(NodeId))
+	{
+		return;
+	}
+
+	for (const int32 Neighbour : Nodes[NodeId].Edges)
+	{
+		Nodes[Neighbour].Edges.RemoveSingleSwap(NodeId, EAllowShrinking::No);
+	}
+
+	ComponentToNode.Remove(Nodes[NodeId].ComponentKey);
+	Nodes.RemoveAt(NodeId);
+	++Version;
+	++RemovalVersion;
+}
+
+void FOrionStructureGraph::RebindNode(const int32 NodeId, UOrionStructureComponent* Component)
+{
+	if (!Nodes.IsValidIndex(NodeId))
+	{
+		return;
+	}
+
+	checkf(!Component || !ComponentToNode.Contains(Component),
+	       TEXT("FOrionStructureGraph::RebindNode: Component is already registered."));
+
+	FNode& Node = Nodes[NodeId];
+	ComponentToNode.Remove(Node.ComponentKey);
+
+	Node.Component = Component;
+	Node.ComponentKey = Component;
+	if (Component)
+	{
+		ComponentToNode.Add(Component, NodeId);
+	}
+}
+
+void FOrionStructureGraph::Reset()
+{
+	Nodes.Empty();
+	ComponentToNode.Empty();
+	++Version; // Never rewinds, so results from before the reset stay stale
+	++RemovalVersion;
+}
+
+void FOrionStructureGraph::PropagateImprovement(const int32 NodeId, TArray<int32>& OutChanged)
+{
+	if (!Nodes.IsValidIndex(NodeId))
+	{
+		return;
+	}
+
+	/* 1. The node itself: grounded, or best neighbour minus own decay */
+	FNode& Node = Nodes[NodeId];
+	float Best = Node.bGrounded ? 1.0f : 0.0f;
+	int32 BestParent = INDEX_NONE;
+
+	if (!Node.bGrounded)
+	{
+		for (const int32 Neighbour : Node.Edges)
+		{
+			if (const float Candidate = Nodes[Neighbour].Stability - Node.Decay; Candidate > Best)
+			{
+				Best = Candidate;
+				BestParent = Neighbour;
+			}
+		}
+	}
+
+	if (!FMath::IsNearlyEqual(Node.Stability, Best, StabilityEpsilon) || Node.SupportParent != BestParent)
+	{
+		Node.Stability = Best;
+		Node.SupportParent = BestParent;
+		OutChanged.Add(NodeId);
+		++Version;
+	}
+
+	/* 2. Push improvements outward, most stable first; only nodes that actually improve are visited */
+	TArray<FStabilityHeapEntry, TInlineAllocator<32>> Heap;
+	Heap.HeapPush({Best, NodeId}, FStabilityHeapPredicate());
+
+	while (Heap.Num() > 0)
+	{
+		FStabilityHeapEntry Top;
+		Heap.HeapPop(Top, FStabilityHeapPredicate(), EAllowShrinking::No);
+
+		const FNode& Current = Nodes[Top.Index];
+		if (Top.Stability + StabilityEpsilon < Current.Stability)
+		{
+			continue; // Stale entry
+		}
+
+		for (const int32 Neighbour : Current.Edges)
+		{
+			FNode& Next = Nodes[Neighbour];
+			if (Next.bGrounded)
+			{
+				continue;
+			}
+
+			if (const float Candidate = Current.Stability - Next.Decay; Candidate > Next.Stability + StabilityEpsilon)
+			{
+				Next.Stability = Candidate;
+				Next.SupportParent = Top.Index;
+				OutChanged.Add(Neighbour);
+				Heap.HeapPush({Candidate, Neighbour}, FStabilityHeapPredicate());
+				++Version;
+			}
+		}
+	}
+}
+
+void FOrionStructureGraph::CollectSupportDependents(const TConstArrayView<int32> Roots, TSet<int32>& OutDependents) const
+{
+	TArray<int32, TInlineAllocator<64>> Queue;
+	TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<64>> Visited;
+
+	for (const int32 Root : Roots)
+	{
+		if (Nodes.IsValidIndex(Root) && !Visited.Contains(Root))
+		{
+			Visited.Add(Root);
+			Queue.Add(Root);
+		}
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Current = Queue[Head];
+		for (const int32 Neighbour : Nodes[Current].Edges)
+		{
+			if (Nodes[Neighbour].SupportParent == Current && !Visited.Contains(Neighbour))
+			{
+				Visited.Add(Neighbour);
+				Queue.Add(Neighbour);
+				OutDependents.Add(Neighbour);
+			}
+		}
+	}
+}
+
+void FOrionStructureGraph::BuildJob(const TSet<int32>& Region, FOrionStabilityJob& OutJob) const
+{
+	OutJob = FOrionStabilityJob();
+	OutJob.GraphVersion = Version;
+	OutJob.RemovalVersion = RemovalVersion;
+
+	TMap<int32, int32> GlobalToLocal;
+	GlobalToLocal.Reserve(Region.Num());
+
+	for (const int32 NodeId : Region)
+	{
+		if (Nodes.IsValidIndex(NodeId))
+		{
+			GlobalToLocal.Add(NodeId, OutJob.NodeIds.Add(NodeId));
+		}
+	}
+
+	const int32 Count = OutJob.NodeIds.Num();
+	OutJob.Decays.SetNumUninitialized(Count);
+	OutJob.Grounded.SetNumUninitialized(Count);
+	OutJob.SeedStability.SetNumUninitialized(Count);
+	OutJob.SeedParents.SetNumUninitialized(Count);
+	OutJob.EdgeOffsets.SetNumUninitialized(Count + 1);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FNode& Node = Nodes[OutJob.NodeIds[i]];
+		OutJob.Decays[i] = Node.Decay;
+		OutJob.Grounded[i] = Node.bGrounded ? 1 : 0;
+		OutJob.SeedStability[i] = 0.f;
+		OutJob.SeedParents[i] = INDEX_NONE;
+		OutJob.EdgeOffsets[i] = OutJob.Edges.Num();
+
+		for (const int32 Neighbour : Node.Edges)
+		{
+			if (const int32* Local = GlobalToLocal.Find(Neighbour))
+			{
+				OutJob.Edges.Add(*Local);
+			}
+			else if (Nodes[Neighbour].Stability > OutJob.SeedStability[i])
+			{
+				// Outside the region: its value is final for this solve
+				OutJob.SeedStability[i] = Nodes[Neighbour].Stability;
+				OutJob.SeedParents[i] = Neighbour;
+			}
+		}
+	}
+	OutJob.EdgeOffsets[Count] = OutJob.Edges.Num();
+}
+
+void FOrionStructureGraph::Solve(const FOrionStabilityJob& Job, FOrionStabilityResult& OutResult)
+{
+	const int32 Count = Job.Num();
+
+	OutResult.GraphVersion = Job.GraphVersion;
+	OutResult.RemovalVersion = Job.RemovalVersion;
+	OutResult.NodeIds = Job.NodeIds;
+	OutResult.Stability.SetNumZeroed(Count);
+	OutResult.SupportParents.Init(INDEX_NONE, Count);
+
+	/* 1. Sources: grounded nodes of the region and nodes touching the untouched rest of the graph */
+	TArray<FStabilityHeapEntry> Heap;
+	Heap.Reserve(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Job.Grounded[i])
+		{
+			OutResult.Stability[i] = 1.0f;
+		}
+		else if (const float FromSeed = Job.SeedStability[i] - Job.Decays[i]; FromSeed > 0.f)
+		{
+			OutResult.Stability[i] = FromSeed;
+			OutResult.SupportParents[i] = Job.SeedParents[i];
+		}
+
+		if (OutResult.Stability[i] > 0.f)
+		{
+			Heap.HeapPush({OutResult.Stability[i], i}, FStabilityHeapPredicate());
+		}
+	}
+
+	/* 2. Multi-source best-first expansion inside the region */
+	while (Heap.Num() > 0)
+	{
+		FStabilityHeapEntry Top;
+		Heap.HeapPop(Top, FStabilityHeapPredicate(), EAllowShrinking::No);
+
+		if (Top.Stability + StabilityEpsilon < OutResult.Stability[Top.Index])
+		{
+			continue; // Stale entry
+		}
+
+		for (int32 e = Job.EdgeOffsets[Top.Index]; e < Job.EdgeOffsets[Top.Index + 1]; ++e)
+		{
+			const int32 Next = Job.Edges[e];
+			if (Job.Grounded[Next])
+			{
+				continue;
+			}
+
+			if (const float Candidate = Top.Stability - Job.Decays[Next];
+				Candidate > OutResult.Stability[Next] + StabilityEpsilon)
+			{
+				OutResult.Stability[Next] = Candidate;
+				OutResult.SupportParents[Next] = Job.NodeIds[Top.Index];
+				Heap.HeapPush({Candidate, Next}, FStabilityHeapPredicate());
+			}
+		}
+	}
+}
+
+void FOrionStructureGraph::ApplyResult(const FOrionStabilityResult& Result, TArray<int32>& OutChanged)
+{
+	for (int32 i = 0; i < Result.NodeIds.Num(); ++i)
+	{
+		const int32 NodeId = Result.NodeIds[i];
+		if (!Nodes.IsValidIndex(NodeId))
+		{
+			continue;
+		}
+
+		FNode& Node = Nodes[NodeId];
+		const float NewStability = FMath::Max(Result.Stability[i], 0.f);
+		if (!FMath::IsNearlyEqual(Node.Stability, NewStability, StabilityEpsilon))
+		{
+			OutChanged.Add(NodeId);
+		}
+
+		Node.Stability = NewStability;
+		Node.SupportParent = Result.SupportParents[i];
+	}
+	++Version;
+}
+
+float FOrionStructureGraph::EvaluateAddition(const TConstArrayView<int32> Neighbours, const float Decay,
+                                             const bool bGrounded, int32& OutSupportNode,
+                                             TArray<TPair<int32, float>>* OutImproved) const
+{
+	OutSupportNode = INDEX_NONE;
+
+	/* 1. The proposed piece itself */
+	float Best = bGrounded ? 1.0f : 0.0f;
+	if (!bGrounded)
+	{
+		const float EffectiveDecay = FMath::Max(Decay, StabilityEpsilon);
+		for (const int32 Neighbour : Neighbours)
+		{
+			if (!Nodes.IsValidIndex(Neighbour))
+			{
+				continue;
+			}
+
+			if (const float Candidate = Nodes[Neighbour].Stability - EffectiveDecay; Candidate > Best)
+			{
+				Best = Candidate;
+				OutSupportNode = Neighbour;
+			}
+		}
+	}
+
+	if (!OutImproved || Best <= 0.f)
+	{
+		return Best;
+	}
+
+	/* 2. Same outward propagation as PropagateImprovement, on a scratch overlay instead of the nodes */
+	TMap<int32, float, TInlineSetAllocator<32>> Overlay;
+	auto GetStability = [this, &Overlay](const int32 NodeId)
+	{
+		const float* Overridden = Overlay.Find(NodeId);
+		return Overridden ? *Overridden : Nodes[NodeId].Stability;
+	};
+
+	TArray<FStabilityHeapEntry, TInlineAllocator<32>> Heap;
+	for (const int32 Neighbour : Neighbours)
+	{
+		if (!Nodes.IsValidIndex(Neighbour) || Nodes[Neighbour].bGrounded)
+		{
+			continue;
+		}
+
+		if (const float Candidate = Best - Nodes[Neighbour].Decay; Candidate > GetStability(Neighbour) + StabilityEpsilon)
+		{
+			Overlay.Add(Neighbour, Candidate);
+			Heap.HeapPush({Candidate, Neighbour}, FStabilityHeapPredicate());
+		}
+	}
+
+	while (Heap.Num() > 0)
+	{
+		FStabilityHeapEntry Top;
+		Heap.HeapPop(Top, FStabilityHeapPredicate(), EAllowShrinking::No);
+
+		if (Top.Stability + StabilityEpsilon < GetStability(Top.Index))
+		{
+			continue; // Stale entry
+		}
+
+		for (const int32 Neighbour : Nodes[Top.Index].Edges)
+		{
+			if (Nodes[Neighbour].bGrounded)
+			{
+				continue;
+			}
+
+			if (const float Candidate = Top.Stability - Nodes[Neighbour].Decay;
+				Candidate > GetStability(Neighbour) + StabilityEpsilon)
+			{
+				Overlay.Add(Neighbour, Candidate);
+				Heap.HeapPush({Candidate, Neighbour}, FStabilityHeapPredicate());
+			}
+		}
+	}
+
+	OutImproved->Reset();
+	for (const TPair<int32, float>& Pair : Overlay)
+	{
+		OutImproved->Emplace(Pair.Key, Pair.Value);
+	}
+
+	return Best;
+}
@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+#include "UObject/ObjectKey.h"
+
+class UOrionStructureComponent;
+
+/**
+ * Self-contained input for FOrionStructureGraph::Solve.
+ * Holds a copy of one region of the graph (CSR adjacency over local indices), so it can be solved on any thread.
+ */
+struct FOrionStabilityJob
+{
+	uint32 GraphVersion = 0;
+	uint32 RemovalVersion = 0;
+
+	TArray<int32> NodeIds;       // Global node id per local index
+	TArray<float> Decays;
+	TArray<uint8> Grounded;
+	TArray<float> SeedStability; // Best stability offered by a neighbour outside the region, 0 if none
+	TArray<int32> SeedParents;   // Global id of that neighbour
+
+	TArray<int32> EdgeOffsets;   // Num + 1 entries, edges of local i are Edges[EdgeOffsets[i] .. EdgeOffsets[i + 1])
+	TArray<int32> Edges;         // Local indices
+
+	int32 Num() const { return NodeIds.Num(); }
+};
+
+struct FOrionStabilityResult
+{
+	uint32 GraphVersion = 0;
+	uint32 RemovalVersion = 0;
+
+	TArray<int32> NodeIds;
+	TArray<float> Stability;
+	TArray<int32> SupportParents;
+};
+
+/**
+ * Structure connectivity graph used for stability (Rust-style: grounded = 1.0, every hop loses the node's decay).
+ *
+ * Stability of a node is the best "1 - sum of decays" over all paths from a grounded node, i.e. a widest path
+ * problem solved as a multi-source best-first search (BFS ordered by stability) from the grounded nodes.
+ * Each node remembers the neighbour it draws support from, which forms a support forest:
+ *  - Adding a node / edge can only raise values, so it is propagated synchronously and touches only improved nodes.
+ *  - Removing a node can only lower values of its support subtree; that region is re-solved by Solve(),
+ *    seeded from the untouched neighbours around it. Solve() only reads the job and can run off the game thread.
+ */
+class ORION_API FOrionStructureGraph
+{
+public:
+	struct FNode
+	{
+		TWeakObjectPtr<UOrionStructureComponent> Component;
+		TObjectKey<UOrionStructureComponent> ComponentKey; // Still usable after the component is gone
+		float Decay = 0.1f;
+		float Stability = 0.f;
+		int32 SupportParent = INDEX_NONE; // Neighbour this node currently draws its stability from
+		uint32 StructureId = 0;           // Never reused (node ids are), keys the structure's save record
+		bool bGrounded = false;
+		TArray<int32, TInlineAllocator<8>> Edges;
+	};
+
+	int32 AddNode(UOrionStructureComponent* Component, float Decay, bool bGrounded);
+	void AddEdge(int32 A, int32 B);
+
+	/** Grounds an existing node (only raises values, so PropagateImprovement is enough afterwards) */
+	void SetGrounded(int32 NodeId);
+
+	/**
+	 * Moves a node to another component, keeping edges and values. A null component leaves the node
+	 * unbound (instanced structure without an actor, see UOrionBuildingRenderManager).
+	 */
+	void RebindNode(int32 NodeId, UOrionStructureComponent* Component);
+
+	/** Removes the node and all its edges. Neighbours keep their current values until re-solved. */
+	void RemoveNode(int32 NodeId);
+
+	void Reset();
+
+	int32 FindNode(const UOrionStructureComponent* Component) const
+	{
+		const int32* NodeId = ComponentToNode.Find(Component);
+		return NodeId ? *NodeId : INDEX_NONE;
+	}
+
+	bool IsValidNode(const int32 NodeId) const { return Nodes.IsValidIndex(NodeId); }
+	const FNode& GetNode(const int32 NodeId) const { return Nodes[NodeId]; }
+	int32 Num() const { return Nodes.Num(); }
+
+	/** Bumped on every topology or value change; results solved against an older version are stale */
+	uint32 GetVersion() const { return Version; }
+
+	/**
+	 * Bumped when a node is removed (or on reset). Additions only raise values, so a result solved before them
+	 * can still be applied and the additions propagated again; after a removal it is stale
+	 */
+	uint32 GetRemovalVersion() const { return RemovalVersion; }
+
+	/**
+	 * Recomputes NodeId from its neighbours and pushes any improvement outward.
+	 * Appends every node whose stability changed to OutChanged.
+	 */
+	void PropagateImprovement(int32 NodeId, TArray<int32>& OutChanged);
+
+	/** Adds every node that (transitively) draws its support from one of Roots, Roots excluded */
+	void CollectSupportDependents(TConstArrayView<int32> Roots, TSet<int32>& OutDependents) const;
+
+	/** Snapshots Region (ids that no longer exist are skipped) into a job */
+	void BuildJob(const TSet<int32>& Region, FOrionStabilityJob& OutJob) const;
+
+	/** Pure function of the job, safe on worker threads */
+	static void Solve(const FOrionStabilityJob& Job, FOrionStabilityResult& OutResult);
+
+	/** Writes a result back. Appends nodes whose stability changed to OutChanged. */
+	void ApplyResult(const FOrionStabilityResult& Result, TArray<int32>& OutChanged);
+
+	/**
+	 * Read-only "what if" for a piece that is not in the graph yet (placement preview).
+	 * Returns the stability it would get from Neighbours; OutSupportNode is the neighbour it would draw from.
+	 * OutImproved (optional) receives existing nodes that would gain stability through it, with their new value.
+	 */
+	float EvaluateAddition(TConstArrayView<int32> Neighbours, float Decay, bool bGrounded, int32& OutSupportNode,
+	                       TArray<TPair<int32, float>>* OutImproved = nullptr) const;
+
+private:
+	TSparseArray<FNode> Nodes;
+	TMap<TObjectKey<UOrionStructureComponent>, int32> ComponentToNode;
+	uint32 Version = 0;
+	uint32 RemovalVersion = 0;
+	uint32 NextStructureId = 1; // 0: no id (records of older saves)
+};
@@ -0,0 +1,448 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
+#include "Orion/OrionGameInstance/OrionGameInstance.h"
+#include "Orion/OrionGameInstance/OrionActorManager.h"
+#include "Orion/OrionGameInstance/OrionCharaManager.h"
+#include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingRenderManager.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionGameInstance/OrionAutosaveManager.h"
+#include "Orion/OrionStructure/OrionStructure.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+
+void UOrionWorldLoadManager::Deinitialize()
+{
+	if (IsLoading())
+	{
+		Abort();
+	}
+
+	Super::Deinitialize();
+}
+
+UOrionWorldLoadManager* UOrionWorldLoadManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UOrionWorldLoadManager>() : nullptr;
+}
+
+bool UOrionWorldLoadManager::StartLoad(UOrionSaveGame* LoadObj)
+{
+	check(LoadObj);
+
+	if (IsLoading())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[WorldLoad] A load is already running, ignored."));
+		return false;
+	}
+
+	const UOrionGameInstance* GameInstance = Cast<UOrionGameInstance>(GetGameInstance());
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!GameInstance || !World)
+	{
+		return false;
+	}
+
+	SaveObj = LoadObj;
+	LoadWorld = World;
+	ResolveGameId = [GameInstance](const FGuid& GameId) { return GameInstance->FindSerializableById(GameId); };
+
+	// Names become FNames on worker threads up front, the records then only copy them
+	LoadObj->NameTable.DecodeNames();
+
+	// Slot saves carry no structures, the world keeps its buildings then
+	bLoadStructures = LoadObj->SavedStructures.Num() > 0;
+
+	/* Everything the save replaces, destroyed in the first phase. Actors and characters still in the save are
+	 * matched by GameId and updated in place, only the missing ones are destroyed and the new ones spawned */
+	ToDestroy.Reset();
+	ReusableActors.Reset();
+	ReusableCharas.Reset();
+	if (bLoadStructures)
+	{
+		for (TActorIterator<AOrionStructure> It(World); It; ++It)
+		{
+			ToDestroy.Add(*It);
+		}
+	}
+
+	TMap<FGuid, AOrionActor*> Actors;
+	TArray<AOrionActor*> StaleActors;
+	UOrionActorManager::MatchLiveActors(World, LoadObj->SavedActors, Actors, StaleActors);
+	ToDestroy.Append(StaleActors);
+	for (const TPair<FGuid, AOrionActor*>& Pair : Actors)
+	{
+		ReusableActors.Add(Pair.Key, Pair.Value);
+	}
+
+	if (const UOrionCharaManager* CharaManager = GetGameInstance()->GetSubsystem<UOrionCharaManager>())
+	{
+		TMap<FGuid, AOrionChara*> Charas;
+		TArray<AOrionChara*> StaleCharas;
+		CharaManager->MatchLiveCharacters(LoadObj->SavedCharacters, Charas, StaleCharas);
+		ToDestroy.Append(StaleCharas);
+		for (const TPair<FGuid, AOrionChara*>& Pair : Charas)
+		{
+			ReusableCharas.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	Phase = EOrionWorldLoadPhase::Clearing;
+	Cursor = 0;
+	TotalSteps = 0;
+	for (const EOrionWorldLoadPhase Each : {EOrionWorldLoadPhase::Clearing, EOrionWorldLoadPhase::Structures,
+	                                        EOrionWorldLoadPhase::Actors, EOrionWorldLoadPhase::Characters,
+	                                        EOrionWorldLoadPhase::Inventories, EOrionWorldLoadPhase::ActionQueues})
+	{
+		TotalSteps += GetPhaseNum(Each);
+	}
+	DoneSteps = 0;
+	NumFrames = 0;
+	StartTime = FPlatformTime::Seconds();
+
+	// 读档期间的同步加载是预期内的
+	if (UOrionAssetPreloadManager* PreloadManager = GetGameInstance()->GetSubsystem<UOrionAssetPreloadManager>())
+	{
+		PreloadManager->BeginLoadingPhase();
+	}
+
+	/* Sockets and the stability graph are dropped before the old structures are destroyed, so their EndPlay finds
+	 * no node to remove (no support re-solve, no collapse per piece). The bulk load stays open until the
+	 * Structures phase ends */
+	if (bLoadStructures)
+	{
+		if (auto* BuildingManager = GetGameInstance()->GetSubsystem<UOrionBuildingManager>())
+		{
+			BuildingManager->ResetAllSockets(World);
+
+			// Per-spawn socket, stability and navigation work is deferred to the end of the Structures phase
+			BuildingManager->BeginBulkLoad();
+		}
+	}
+
+	bWasPaused = UGameplayStatics::IsGamePaused(World);
+	KeepPaused(*World);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UOrionWorldLoadManager::OnLoadTick));
+
+	UE_LOG(LogTemp, Log,
+	       TEXT("[WorldLoad] Started: %d steps (%d to clear, %d structures, %d actors (%d reused), %d characters (%d reused))."),
+	       TotalSteps, ToDestroy.Num(), GetPhaseNum(EOrionWorldLoadPhase::Structures), LoadObj->SavedActors.Num(),
+	       ReusableActors.Num(), LoadObj->SavedCharacters.Num(), ReusableCharas.Num());
+
+	OnProgress.Broadcast(Phase, 0.f);
+	return true;
+}
+
+bool UOrionWorldLoadManager::OnLoadTick(float /*DeltaTime*/)
+{
+	UWorld* World = LoadWorld.Get();
+	if (!World || World != GetGameInstance()->GetWorld())
+	{
+		Abort();
+		return false;
+	}
+
+	// Something (pause menu, debug key) may have resumed the game meanwhile
+	KeepPaused(*World);
+
+	const double SliceStart = FPlatformTime::Seconds();
+	const double BudgetSeconds = FrameBudgetMs / 1000.0;
+	bool bDone = false;
+
+	{
+		// Navigation octree updates of this slice are flushed together (structures: of the whole phase)
+		FNavigationLockContext NavLock(World, ENavigationLockReason::Unknown);
+
+		while (FPlatformTime::Seconds() - SliceStart <= BudgetSeconds)
+		{
+			if (Cursor >= GetPhaseNum(Phase))
+			{
+				if (!AdvancePhase(*World))
+				{
+					bDone = true;
+					break;
+				}
+				continue;
+			}
+
+			RunStep(*World);
+			++Cursor;
+			++DoneSteps;
+		}
+	}
+	++NumFrames;
+
+	if (bDone)
+	{
+		Commit(*World);
+		return false;
+	}
+
+	OnProgress.Broadcast(Phase, GetProgress());
+	return true;
+}
+
+void UOrionWorldLoadManager::RunStep(UWorld& World)
+{
+	UGameInstance* GameInstance = GetGameInstance();
+
+	switch (Phase)
+	{
+	case EOrionWorldLoadPhase::Clearing:
+		if (AActor* Actor = ToDestroy[Cursor].Get())
+		{
+			Actor->Destroy();
+		}
+		break;
+
+	case EOrionWorldLoadPhase::Structures:
+		// BeginPlay registers the sockets into the open batch
+		if (AOrionStructure* Structure = CastChecked<UOrionGameInstance>(GameInstance)->SpawnStructure(
+			SaveObj->SavedStructures[Cursor], &World))
+		{
+			SpawnedStructures.Add(Structure);
+		}
+		break;
+
+	case EOrionWorldLoadPhase::Actors:
+		if (auto* AMgr = GameInstance->GetSubsystem<UOrionActorManager>())
+		{
+			const FOrionActorFullRecord& Rec = SaveObj->SavedActors[Cursor];
+			if (AOrionActor* Existing = ReusableActors.FindRef(Rec.ActorGameId).Get())
+			{
+				AMgr->ApplyActorRecord(Existing, Rec, SaveObj->NameTable, ResolveGameId);
+			}
+			else
+			{
+				AMgr->SpawnAndRegisterActor(&World, Rec, SaveObj->NameTable, ResolveGameId);
+			}
+		}
+		break;
+
+	case EOrionWorldLoadPhase::Characters:
+		if (auto* CharaManager = GameInstance->GetSubsystem<UOrionCharaManager>())
+		{
+			const FOrionCharaSerializable& S = SaveObj->SavedCharacters[Cursor];
+			if (AOrionChara* Existing = ReusableCharas.FindRef(S.CharaGameId).Get())
+			{
+				CharaManager->ApplyCharaRecord(Existing, S, SaveObj->NameTable, ResolveGameId);
+			}
+			else
+			{
+				CharaManager->LoadCharacter(S, SaveObj->NameTable, ResolveGameId);
+			}
+		}
+		break;
+
+	case EOrionWorldLoadPhase::Inventories:
+		{
+			const FOrionInventorySerializable& Rec = SaveObj->SavedInventories[Cursor];
+			UOrionInventoryManager::ApplyInventoryRecord(Cast<AActor>(ResolveGameId(Rec.OwnerGameId)), Rec);
+		}
+		break;
+
+	case EOrionWorldLoadPhase::ActionQueues:
+		if (auto* CharaManager = GameInstance->GetSubsystem<UOrionCharaManager>())
+		{
+			const FOrionCharaSerializable& S = SaveObj->SavedCharacters[Cursor];
+			if (AOrionChara* Chara = CharaManager->FindCharaById(S.CharaGameId))
+			{
+				CharaManager->RecoverProcActions(Chara, S);
+			}
+		}
+		break;
+
+	default:
+		checkNoEntry();
+	}
+}
+
+bool UOrionWorldLoadManager::AdvancePhase(UWorld& World)
+{
+	UGameInstance* GameInstance = GetGameInstance();
+
+	/* ① End of the current phase */
+	if (Phase == EOrionWorldLoadPhase::Structures && bLoadStructures)
+	{
+		if (auto* BuildingManager = GameInstance->GetSubsystem<UOrionBuildingManager>())
+		{
+			BuildingManager->EndBulkLoad();
+		}
+
+		// Large bases are rendered through per-class HISM, actors are only kept for interaction
+		if (UOrionBuildingRenderManager* RenderManager = GameInstance->GetSubsystem<UOrionBuildingRenderManager>();
+			RenderManager && RenderManager->bInstanceStructures)
+		{
+			TArray<AActor*> Spawned;
+			Spawned.Reserve(SpawnedStructures.Num());
+			for (const TWeakObjectPtr<AActor>& Actor : SpawnedStructures)
+			{
+				if (Actor.IsValid())
+				{
+					Spawned.Add(Actor.Get());
+				}
+			}
+			RenderManager->InstanceStructures(Spawned);
+		}
+		SpawnedStructures.Empty();
+	}
+	else if (Phase == EOrionWorldLoadPhase::Clearing)
+	{
+		ToDestroy.Empty();
+	}
+
+	if (Phase == EOrionWorldLoadPhase::ActionQueues)
+	{
+		return false;
+	}
+
+	/* ② Start of the next one */
+	Phase = static_cast<EOrionWorldLoadPhase>(static_cast<uint8>(Phase) + 1);
+	Cursor = 0;
+
+	switch (Phase)
+	{
+	case EOrionWorldLoadPhase::Structures:
+		// The bulk load was opened by StartLoad
+		if (bLoadStructures)
+		{
+			SpawnedStructures.Reserve(SaveObj->SavedStructures.Num());
+		}
+		break;
+
+	case EOrionWorldLoadPhase::Actors:
+		// Stale objects are gone now: the registries keep exactly the reused ones, all of them registered before
+		// the first record is applied, so references between records resolve whatever their order
+		if (auto* AMgr = GameInstance->GetSubsystem<UOrionActorManager>())
+		{
+			AMgr->RetainActors(ReusableActors);
+		}
+		if (auto* CharaManager = GameInstance->GetSubsystem<UOrionCharaManager>())
+		{
+			CharaManager->RetainCharas(ReusableCharas);
+		}
+		break;
+
+	default:
+		break;
+	}
+	return true;
+}
+
+int32 UOrionWorldLoadManager::GetPhaseNum(const EOrionWorldLoadPhase InPhase) const
+{
+	switch (InPhase)
+	{
+	case EOrionWorldLoadPhase::Clearing: return ToDestroy.Num();
+	case EOrionWorldLoadPhase::Structures: return bLoadStructures ? SaveObj->SavedStructures.Num() : 0;
+	case EOrionWorldLoadPhase::Actors: return SaveObj->SavedActors.Num();
+	case EOrionWorldLoadPhase::Characters: return SaveObj->SavedCharacters.Num();
+	case EOrionWorldLoadPhase::Inventories: return SaveObj->SavedInventories.Num();
+	case EOrionWorldLoadPhase::ActionQueues: return SaveObj->SavedCharacters.Num();
+	default: return 0;
+	}
+}
+
+void UOrionWorldLoadManager::Commit(UWorld& World)
+{
+	UGameInstance* GameInstance = GetGameInstance();
+
+	if (UOrionAssetPreloadManager* PreloadManager = GameInstance->GetSubsystem<UOrionAssetPreloadManager>())
+	{
+		PreloadManager->EndLoadingPhase();
+	}
+
+	// The world no longer matches the autosave base
+	if (UOrionAutosaveManager* AutosaveManager = GameInstance->GetSubsystem<UOrionAutosaveManager>())
+	{
+		AutosaveManager->InvalidateBase();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[WorldLoad] Committed %d steps over %d frames in %.2f ms."),
+	       DoneSteps, NumFrames, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	SaveObj = nullptr;
+	ResolveGameId = nullptr;
+	ReusableActors.Empty();
+	ReusableCharas.Empty();
+	Phase = EOrionWorldLoadPhase::Idle;
+	TickerHandle.Reset();
+
+	// Last: gameplay resumes on a complete world
+	if (!bWasPaused)
+	{
+		UGameplayStatics::SetGamePaused(&World, false);
+	}
+
+	OnProgress.Broadcast(EOrionWorldLoadPhase::Idle, 1.f);
+	OnFinished.Broadcast();
+}
+
+void UOrionWorldLoadManager::Abort()
+{
+	UE_LOG(LogTemp, Warning, TEXT("[WorldLoad] World changed during the load, aborted in phase %d (%d / %d steps)."),
+	       static_cast<int32>(Phase), DoneSteps, TotalSteps);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	UGameInstance* GameInstance = GetGameInstance();
+	if (UOrionAssetPreloadManager* PreloadManager = GameInstance->GetSubsystem<UOrionAssetPreloadManager>())
+	{
+		PreloadManager->EndLoadingPhase();
+	}
+	if (Phase <= EOrionWorldLoadPhase::Structures && bLoadStructures)
+	{
+		if (auto* BuildingManager = GameInstance->GetSubsystem<UOrionBuildingManager>())
+		{
+			BuildingManager->EndBulkLoad();
+		}
+	}
+
+	SaveObj = nullptr;
+	ResolveGameId = nullptr;
+	ReusableActors.Empty();
+	ReusableCharas.Empty();
+	ToDestroy.Empty();
+	SpawnedStructures.Empty();
+	Phase = EOrionWorldLoadPhase::Idle;
+
+	// The load paused the game, an aborted load must not leave it paused
+	if (UWorld* World = LoadWorld.Get(); World && !bWasPaused)
+	{
+		UGameplayStatics::SetGamePaused(World, false);
+	}
+	LoadWorld.Reset();
+
+	OnFinished.Broadcast();
+}
+
+void UOrionWorldLoadManager::KeepPaused(UWorld& World) const
+{
+	if (!UGameplayStatics::IsGamePaused(&World))
+	{
+		UGameplayStatics::SetGamePaused(&World, true);
+	}
+}
+
+FText UOrionWorldLoadManager::GetPhaseText(const EOrionWorldLoadPhase InPhase)
+{
+	switch (InPhase)
+	{
+	case EOrionWorldLoadPhase::Clearing: return FText::FromString(TEXT("Clearing world"));
+	case EOrionWorldLoadPhase::Structures: return FText::FromString(TEXT("Loading structures"));
+	case EOrionWorldLoadPhase::Actors: return FText::FromString(TEXT("Loading actors"));
+	case EOrionWorldLoadPhase::Characters: return FText::FromString(TEXT("Loading characters"));
+	case EOrionWorldLoadPhase::Inventories: return FText::FromString(TEXT("Restoring inventories"));
+	case EOrionWorldLoadPhase::ActionQueues: return FText::FromString(TEXT("Restoring action queues"));
+	default: return FText::GetEmpty();
+	}
+}
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "OrionWorldLoadManager.generated.h"
+
+class AOrionActor;
+class AOrionChara;
+
+UENUM(BlueprintType)
+enum class EOrionWorldLoadPhase : uint8
+{
+	Idle,
+	Clearing,     // Old structures, actors / characters missing from the save destroyed (inside the bulk load)
+	Structures,   // One bulk load (UOrionBuildingManager) from StartLoad on, instanced when the phase ends
+	Actors,
+	Characters,   // Spawned and deserialized, no actions yet
+	Inventories,
+	ActionQueues, // Action targets resolve once every actor and character exists
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnOrionWorldLoadProgress, EOrionWorldLoadPhase /*Phase*/, float /*Progress*/);
+DECLARE_MULTICAST_DELEGATE(FOnOrionWorldLoadFinished);
+
+/**
+ * Time-sliced world load: applies the records of a save over several frames, at most FrameBudgetMs per frame,
+ * instead of destroying and respawning the whole world in one frame.
+ *
+ * Actors and characters that are still in the save are matched by GameId and their record is written into them in
+ * place, so a quickload spawns / destroys only what changed; structures are rebuilt when the save carries them.
+ *
+ * Phases run in order (clear, structures, actors, characters, inventories, action queues), each depends on the
+ * previous one: characters are traced onto loaded structures, references resolve to loaded actors. The game is
+ * paused from StartLoad until the last phase commits, so no gameplay tick sees a half loaded world; the slices run
+ * on the core ticker, which keeps ticking while paused. OnProgress is broadcast once per frame for the loading
+ * widget.
+ */
+UCLASS()
+class ORION_API UOrionWorldLoadManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	static UOrionWorldLoadManager* Get(const UObject* WorldContextObject);
+
+	float FrameBudgetMs = 10.f;
+
+	/* Starts applying LoadObj to the current world (its classes should be preloaded). False if a load is running */
+	bool StartLoad(UOrionSaveGame* LoadObj);
+
+	bool IsLoading() const { return Phase != EOrionWorldLoadPhase::Idle; }
+	EOrionWorldLoadPhase GetPhase() const { return Phase; }
+
+	/* 0..1 over every step of every phase */
+	float GetProgress() const { return TotalSteps > 0 ? static_cast<float>(DoneSteps) / TotalSteps : 1.f; }
+
+	static FText GetPhaseText(EOrionWorldLoadPhase InPhase);
+
+	FOnOrionWorldLoadProgress OnProgress;
+	FOnOrionWorldLoadFinished OnFinished;
+
+private:
+	bool OnLoadTick(float DeltaTime);
+
+	/* Applies step Cursor of the current phase */
+	void RunStep(UWorld& World);
+
+	/* End of the current phase (socket batch, instancing), then start of the next one. False after the last */
+	bool AdvancePhase(UWorld& World);
+	int32 GetPhaseNum(EOrionWorldLoadPhase InPhase) const;
+
+	void Commit(UWorld& World);
+	void Abort();
+	void KeepPaused(UWorld& World) const;
+
+	UPROPERTY()
+	TObjectPtr<UOrionSaveGame> SaveObj;
+
+	TWeakObjectPtr<UWorld> LoadWorld;
+	FOrionNameTableArchive::FResolveGameId ResolveGameId;
+	EOrionWorldLoadPhase Phase = EOrionWorldLoadPhase::Idle;
+	int32 Cursor = 0;
+
+	bool bLoadStructures = false;
+	bool bWasPaused = false;
+
+	// Clearing: everything the save replaces. Structures: spawned ones, instanced at the end of the phase
+	TArray<TWeakObjectPtr<AActor>> ToDestroy;
+	TArray<TWeakObjectPtr<AActor>> SpawnedStructures;
+
+	// Live objects matched to a record by GameId, updated in place instead of respawned
+	TMap<FGuid, TWeakObjectPtr<AOrionActor>> ReusableActors;
+	TMap<FGuid, TWeakObjectPtr<AOrionChara>> ReusableCharas;
+
+	int32 TotalSteps = 0;
+	int32 DoneSteps = 0;
+	int32 NumFrames = 0;
+	double StartTime = 0.0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -330,7 +330,7 @@ void AOrionGameMode::OnTestKey6Pressed()
 	AOrionChara* SpawnedChara = SpawnCharaInstance(SpawnLocation, SpawnParams);
 	if (SpawnedChara && SpawnedChara->AttributeComp)
 	{
-		SpawnedChara->AttributeComp->ActorFaction = EFaction::PlayerFaction;
+		SpawnedChara->AttributeComp->SetActorFaction(EFaction::PlayerFaction);
 		UE_LOG(LogTemp, Log, TEXT("Set spawned character faction to PlayerFaction"));
 	}
 }
@@ -584,7 +584,7 @@ AOrionChara* AOrionGameMode::SpawnEnemyCharaAt(const FVector& SpawnLocation)
 	AOrionChara* Enemy = SpawnCharaInstance(SpawnLocation, SpawnParams);
 	if (Enemy && Enemy->AttributeComp)
 	{
-		Enemy->AttributeComp->ActorFaction = EFaction::Vagrants;
+		Enemy->AttributeComp->SetActorFaction(EFaction::Vagrants);
 	}
 	return Enemy;
 }
@@ -599,7 +599,7 @@ AOrionChara* AOrionGameMode::SpawnFriendlyCharaAt(const FVector& SpawnLocation)
 	AOrionChara* Ally = SpawnCharaInstance(SpawnLocation, SpawnParams);
 	if (Ally && Ally->AttributeComp)
 	{
-		Ally->AttributeComp->ActorFaction = EFaction::PlayerFaction;
+		Ally->AttributeComp->SetActorFaction(EFaction::PlayerFaction);
 	}
 	return Ally;
 }
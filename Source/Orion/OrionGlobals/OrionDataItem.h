@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Engine/Texture2D.h"
 #include "OrionDataItem.generated.h"
 
 USTRUCT(BlueprintType)
@@ -30,16 +32,49 @@ struct FOrionDataItem
 	/** Standard production/processing time (seconds) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
 	float ProductionTimeCostSTD = 0.f;
+
+	/** Icon, async loaded and kept resident by UOrionItemManager */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	TSoftObjectPtr<UTexture2D> Icon;
 };
 
-inline TMap<int32, TSoftObjectPtr<UTexture2D>> ItemIDToTextureMap = {
-	{
-		1,
-		TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTLogIcon.GPTLogIcon")))
-	},
+// DataTable 行结构（用于编辑器配置，新增物品无需改动 C++）
+USTRUCT(BlueprintType)
+struct FOrionDataItemRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	int32 ItemId = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	FText DisplayName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	FText ChineseDisplayName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	float PriceSTD = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data")
+	float ProductionTimeCostSTD = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Data", meta = (AllowedClasses = "Texture2D"))
+	TSoftObjectPtr<UTexture2D> Icon;
+
+	FOrionDataItem ToDataItem() const
 	{
-		2,
-		TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTStoneOreIcon.GPTStoneOreIcon")))
-	},
-	{3, TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/_Orion/UI/Images/GPTBullet.GPTBullet")))},
+		FOrionDataItem Result;
+		Result.ItemId = ItemId;
+		Result.Name = Name;
+		Result.DisplayName = DisplayName;
+		Result.ChineseDisplayName = ChineseDisplayName;
+		Result.PriceSTD = PriceSTD;
+		Result.ProductionTimeCostSTD = ProductionTimeCostSTD;
+		Result.Icon = Icon;
+		return Result;
+	}
 };
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OrionStructureData.generated.h"
+
+UENUM()
+enum class EOrionStructure : uint8
+{
+	None,
+	BasicSquareFoundation,
+	BasicTriangleFoundation,
+	Wall,
+	DoubleWall,
+	BasicRoof,
+	InclinedRoof,
+};
+
+USTRUCT()
+struct FOrionGlobalSocket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location;
+
+	UPROPERTY()
+	FRotator Rotation;
+
+	UPROPERTY()
+	FVector Scale;
+
+	UPROPERTY()
+	EOrionStructure Kind;
+
+	UPROPERTY()
+	bool bOccupied = false;
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Owner;
+
+	FOrionGlobalSocket() = default;
+
+	FOrionGlobalSocket(const FVector& InLoc,
+	                   const FRotator& InRot,
+	                   const EOrionStructure InKind,
+	                   const bool bInOccupied,
+	                   AActor* InOwner, const FVector& Scale = FVector(1.0f, 1.0f, 1.0f))
+		: Location(InLoc)
+		  , Rotation(InRot)
+		  , Scale(Scale)
+		  , Kind(InKind)
+		  , bOccupied(bInOccupied)
+		  , Owner(InOwner)
+	{
+	}
+};
+
+/* One socket of a structure type, relative to the structure mesh (location + rotation, scale ignored) */
+struct FOrionSocketTemplateEntry
+{
+	FVector Offset = FVector::ZeroVector;
+	FRotator RotationOffset = FRotator::ZeroRotator;
+	FVector Scale = FVector(1.0f, 1.0f, 1.0f);
+	EOrionStructure Kind = EOrionStructure::None;
+	bool bOccupied = false;
+	bool bRotateOffset = true; // false: Offset is applied along world axes (DoubleWall legacy layout)
+
+	FOrionSocketTemplateEntry() = default;
+
+	FOrionSocketTemplateEntry(const FVector& InOffset, const float InYawOffset, const EOrionStructure InKind,
+	                          const bool bInOccupied = false, const bool bInRotateOffset = true)
+		: Offset(InOffset)
+		  , RotationOffset(0.f, InYawOffset, 0.f)
+		  , Kind(InKind)
+		  , bOccupied(bInOccupied)
+		  , bRotateOffset(bInRotateOffset)
+	{
+	}
+};
+
+/* World-space oriented box of a structure (mesh bounds, half extents) */
+struct FOrionOrientedBox
+{
+	FVector Center = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector Extent = FVector::ZeroVector;
+
+	FOrionOrientedBox() = default;
+
+	FOrionOrientedBox(const FVector& InCenter, const FQuat& InRotation, const FVector& InExtent)
+		: Center(InCenter)
+		  , Rotation(InRotation)
+		  , Extent(InExtent)
+	{
+	}
+
+	/* World-space axis-aligned bounds */
+	FBox GetAABB() const
+	{
+		const FVector WorldExtent =
+			Rotation.GetAxisX().GetAbs() * Extent.X +
+			Rotation.GetAxisY().GetAbs() * Extent.Y +
+			Rotation.GetAxisZ().GetAbs() * Extent.Z;
+		return FBox(Center - WorldExtent, Center + WorldExtent);
+	}
+
+	bool ContainsPoint(const FVector& Point, const float Tolerance = 0.f) const
+	{
+		const FVector Local = Rotation.UnrotateVector(Point - Center);
+		return FMath::Abs(Local.X) <= Extent.X + Tolerance &&
+			FMath::Abs(Local.Y) <= Extent.Y + Tolerance &&
+			FMath::Abs(Local.Z) <= Extent.Z + Tolerance;
+	}
+};
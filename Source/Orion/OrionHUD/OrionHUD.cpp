@@ -12,6 +12,7 @@
 #include "Orion/OrionGameInstance/OrionBuildingManager.h"
 #include "Orion/OrionGameInstance/OrionFactionManager.h"
 #include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
 #include "Orion/OrionPlayerController/OrionPlayerController.h"
 #include "Orion/OrionGameMode/OrionGameMode.h"
 // [Fix] Include ActionComponent
@@ -96,6 +97,12 @@ void AOrionHUD::BeginPlay()
 
 	/* 4. Bind Events */
 
+	if (UOrionWorldLoadManager* WorldLoadManager = GetGameInstance()->GetSubsystem<UOrionWorldLoadManager>())
+	{
+		WorldLoadManager->OnProgress.AddUObject(this, &AOrionHUD::OnWorldLoadProgress);
+		WorldLoadManager->OnFinished.AddUObject(this, &AOrionHUD::OnWorldLoadFinished);
+	}
+
 }
 
 void AOrionHUD::Tick(float DeltaTime)
@@ -105,6 +112,32 @@ void AOrionHUD::Tick(float DeltaTime)
 	TickCharaInfoPanel();
 }
 
+void AOrionHUD::OnWorldLoadProgress(const EOrionWorldLoadPhase Phase, const float Progress)
+{
+	if (!LoadingScreen && WB_LoadingScreen)
+	{
+		LoadingScreen = CreateWidget<UOrionUserWidgetLoading>(GetWorld(), WB_LoadingScreen);
+	}
+	if (!LoadingScreen)
+	{
+		return;
+	}
+
+	if (!LoadingScreen->IsInViewport())
+	{
+		LoadingScreen->AddToViewport(100);
+	}
+	LoadingScreen->SetProgress(Phase, Progress);
+}
+
+void AOrionHUD::OnWorldLoadFinished() const
+{
+	if (LoadingScreen)
+	{
+		LoadingScreen->RemoveFromParent();
+	}
+}
+
 void AOrionHUD::UpdatePlayerFactionResourceDisplay()
 {
 	if (!DeveloperUIBase) return;
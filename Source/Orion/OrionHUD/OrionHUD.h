@@ -6,6 +6,7 @@
 #include "GameFramework/HUD.h"
 #include "Orion/OrionChara/OrionChara.h"
 #include "Orion/OrionHUD/OrionUserWidgetCharaInfo.h"
+#include "Orion/OrionHUD/OrionUserWidgetLoading.h"
 #include "OrionHUD.generated.h"
 
 class UOrionFactionManager;
@@ -62,6 +63,16 @@ public:
 	UPROPERTY()
 	UOrionUserWidgetUIBase* DeveloperUIBase = nullptr;
 
+	/* Loading screen, shown while a save is applied to the world */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+	TSubclassOf<UOrionUserWidgetLoading> WB_LoadingScreen;
+
+	UPROPERTY(Transient)
+	UOrionUserWidgetLoading* LoadingScreen = nullptr;
+
+	void OnWorldLoadProgress(EOrionWorldLoadPhase Phase, float Progress);
+	void OnWorldLoadFinished() const;
+
 	/* Player Operation Menu */
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blueprint Use Only")
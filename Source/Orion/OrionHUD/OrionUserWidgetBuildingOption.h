@@ -6,6 +6,7 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/CheckBox.h"
 #include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
 #include "OrionUserWidgetBuildingOption.generated.h"
 
 
@@ -56,7 +57,11 @@ public:
 
 		// —— 1) Prepare base background brush —— 
 		FSlateBrush BaseBrush;
-		if (UTexture2D* BackgroundTexture = LoadObject<UTexture2D>(nullptr, *InBuildingData.BuildingImageReference))
+		// 建筑图标已由 PreloadManager 预加载
+		const UOrionAssetPreloadManager* PreloadManager = UOrionAssetPreloadManager::Get(this);
+		if (UTexture2D* BackgroundTexture = PreloadManager
+			                                    ? PreloadManager->FindOrLoadObject<UTexture2D>(InBuildingData.BuildingImageReference)
+			                                    : LoadObject<UTexture2D>(nullptr, *InBuildingData.BuildingImageReference))
 		{
 			BaseBrush.SetResourceObject(BackgroundTexture);
 		}
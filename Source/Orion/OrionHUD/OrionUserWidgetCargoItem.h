@@ -8,6 +8,7 @@
 #include "Components/Image.h"
 #include "Orion/OrionComponents/OrionInventoryComponent.h"
 #include "Orion/OrionGlobals/OrionDataItem.h"
+#include "Orion/OrionGameInstance/OrionItemManager.h"
 #include "OrionUserWidgetCargoItem.generated.h"
 
 /**
@@ -83,18 +84,11 @@ public:
 
 		if (ImageCargo)
 		{
-			if (const TSoftObjectPtr<UTexture2D>* TexturePtr = ItemIDToTextureMap.Find(ItemId))
+			// Icons are async loaded and kept resident by the item registry
+			const UOrionItemManager* ItemManager = UOrionItemManager::Get(this);
+			if (UTexture2D* Texture = ItemManager ? ItemManager->GetItemIcon(ItemId) : nullptr)
 			{
-				UTexture2D* Texture = TexturePtr->Get();
-				if (!Texture)
-				{
-					// Synchronous load
-					Texture = TexturePtr->LoadSynchronous();
-				}
-				if (Texture)
-				{
-					ImageCargo->SetBrushFromTexture(Texture);
-				}
+				ImageCargo->SetBrushFromTexture(Texture);
 			}
 		}
 	}
@@ -7,6 +7,7 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/VerticalBox.h"
 #include "Orion/OrionComponents/OrionInventoryComponent.h"
+#include "Orion/OrionGameInstance/OrionItemManager.h"
 #include "OrionUserWidgetCharaDetails.generated.h"
 
 /**
@@ -30,13 +31,14 @@ public:
 			return;
 		}
 
+		const UOrionItemManager* ItemManager = UOrionItemManager::Get(this);
+
 		for (const auto& Pair : InventoryComponent->InventoryMap)
 		{
 			const int32 ItemId = Pair.Key;
 			const int32 Quantity = Pair.Value;
 
-			const FOrionDataItem* Info = UOrionInventoryComponent::ItemInfoTable.FindByPredicate(
-				[ItemId](const FOrionDataItem& I) { return I.ItemId == ItemId; });
+			const FOrionDataItem* Info = ItemManager ? ItemManager->FindItemInfo(ItemId) : nullptr;
 
 			const FText Name = Info
 				                   ? Info->DisplayName
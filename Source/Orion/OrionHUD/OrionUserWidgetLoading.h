@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/ProgressBar.h"
+#include "Components/TextBlock.h"
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
+#include "OrionUserWidgetLoading.generated.h"
+
+/**
+ * Loading screen shown by the HUD while UOrionWorldLoadManager applies a save
+ */
+UCLASS(Blueprintable)
+class ORION_API UOrionUserWidgetLoading : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Bind widget in Blueprint */
+	UPROPERTY(meta = (BindWidget))
+	UProgressBar* LoadProgress = nullptr;
+
+	UPROPERTY(meta = (BindWidget))
+	UTextBlock* PhaseText = nullptr;
+
+	void SetProgress(const EOrionWorldLoadPhase Phase, const float Progress)
+	{
+		LoadProgress->SetPercent(Progress);
+		PhaseText->SetText(UOrionWorldLoadManager::GetPhaseText(Phase));
+	}
+};
@@ -20,6 +20,13 @@
 #include "Orion/OrionChara/OrionChara.h"
 #include "Orion/OrionGameInstance/OrionFactionManager.h"
 #include "Orion/OrionGameInstance/OrionCharaManager.h"
+#include "Orion/OrionGameInstance/OrionGameInstance.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarShowPlacementQueryStats(
+	TEXT("Orion.Building.ShowQueryStats"), false,
+	TEXT("Shows the placement query counters (physics queries, occupancy grid answers) of the last frame on screen."));
+#endif
 
 AOrionPlayerController::AOrionPlayerController()
 {
@@ -50,6 +57,7 @@ void AOrionPlayerController::SetupInputComponent()
 
 		InputComponent->BindAction("Key7Pressed", IE_Pressed, this, &AOrionPlayerController::OnKey7Pressed);
 		InputComponent->BindAction("Key8Pressed", IE_Pressed, this, &AOrionPlayerController::OnKey8Pressed);
+		InputComponent->BindAction("Key9Pressed", IE_Pressed, this, &AOrionPlayerController::OnKey9Pressed);
 
 		InputComponent->BindAction("RightMouseClick", IE_Released, this, &AOrionPlayerController::OnRightMouseUp);
 		InputComponent->BindAction("ShiftPress", IE_Pressed, this, &AOrionPlayerController::OnShiftPressed);
@@ -127,6 +135,10 @@ void AOrionPlayerController::SwitchFromPlacingStructures(const int32 InBuildingI
 			IsStructureSnapped = false;
 			// Cache the BuildingId when preview is successfully created
 			CachedPreviewBuildingId = FoundInfo->BuildingId;
+
+			// Pooled preview may still carry the tint of its last use
+			bPreviewPlacementValid = true;
+			SetPreviewTint(PreviewStructure, true);
 		}
 		else
 		{
@@ -165,6 +177,12 @@ void AOrionPlayerController::OnKey7Pressed()
 {
 	UE_LOG(LogTemp, Log, TEXT("Key 7 Pressed"));
 
+	// Dev: character / actor record archives, name table vs name as string, sizes + timings in the log
+	if (const UOrionGameInstance* GameInstance = GetGameInstance<UOrionGameInstance>())
+	{
+		GameInstance->BenchmarkRecordArchives();
+	}
+
 	//BuildBP = TriangleFoundationBP;
 
 	//TogglePlacingStructure(BuildBP, PreviewStructure);
@@ -173,10 +191,28 @@ void AOrionPlayerController::OnKey7Pressed()
 void AOrionPlayerController::OnKey8Pressed()
 {
 	UE_LOG(LogTemp, Log, TEXT("Key 8 Pressed"));
+
+	// Dev: physics vs box set neighbour queries, equivalence + timings in the log
+	if (BuildingManager)
+	{
+		BuildingManager->BenchmarkStructureQueries();
+	}
+
 	//BuildBP = DoubleWallBP;
 	//TogglePlacingStructure(BuildBP, PreviewStructure);
 }
 
+void AOrionPlayerController::OnKey9Pressed()
+{
+	UE_LOG(LogTemp, Log, TEXT("Key 9 Pressed"));
+
+	// Dev: structure record encodings (JSON / tagged / compact), sizes + timings in the log
+	if (const UOrionGameInstance* GameInstance = GetGameInstance<UOrionGameInstance>())
+	{
+		GameInstance->BenchmarkStructureRecords();
+	}
+}
+
 void AOrionPlayerController::OnBPressed()
 {
 	UE_LOG(LogTemp, Log, TEXT("OrionPlayerController::OnBPressed: B Pressed. "));
@@ -421,6 +457,10 @@ FVector AOrionPlayerController::GetAutoPlacementLocation(const FVector& GroundIm
 		ECC_Visibility,
 		QueryParams
 	);
+	if (BuildingManager)
+	{
+		BuildingManager->CountPhysicsQuery();
+	}
 
 	FVector PlacementLocation = GroundImpactPointLocation;
 
@@ -541,7 +581,6 @@ void AOrionPlayerController::TickPlacingStructure(AActor*& Preview)
 
 
 	const FVector DesiredLocation = GroundHit.ImpactPoint;
-	const FVector AutoPlacedLocation = GetAutoPlacementLocation(DesiredLocation, StructureComp);
 
 
 	if (IsInputKeyDown(EKeys::U))
@@ -591,10 +630,52 @@ void AOrionPlayerController::TickPlacingStructure(AActor*& Preview)
 		}
 		if (!IsStructureSnapped)
 		{
+			// Only needed while free placing: saves the downward trace every tick while snapped
 			CachedSnapTarget = nullptr;
-			Preview->SetActorLocation(AutoPlacedLocation);
+			Preview->SetActorLocation(GetAutoPlacementLocation(DesiredLocation, StructureComp));
 		}
 	}
+
+	/* ---------- ④ Stability preview (pure data, nothing is spawned) ---------- */
+	UpdatePreviewStability(Preview, Kind);
+
+#if !UE_BUILD_SHIPPING
+	/* ---------- ⑤ Placement query counters of the last frame ---------- */
+	if (CVarShowPlacementQueryStats.GetValueOnGameThread() && GEngine)
+	{
+		const FOrionPlacementQueryStats& Stats = BuildingManager->GetPlacementQueryStats();
+		GEngine->AddOnScreenDebugMessage(
+			static_cast<int32>(GetUniqueID()), 0.f, FColor::Cyan,
+			FString::Printf(TEXT("[Building] Physics queries: %d | Grid free: %d, blocked: %d, maybe: %d"),
+			                Stats.PhysicsQueries, Stats.GridFree, Stats.GridBlocked, Stats.GridMaybe));
+	}
+#endif
+}
+
+void AOrionPlayerController::UpdatePreviewStability(AActor* Preview, const EOrionStructure Kind)
+{
+	if (!Preview || !BuildingManager) return;
+
+	const FOrionStabilityPreview StabilityPreview =
+		BuildingManager->PreviewPlacementStability(Kind, Preview->GetClass(), Preview->GetActorTransform(), Preview);
+
+	if (const bool bValid = StabilityPreview.IsValidPlacement(); bValid != bPreviewPlacementValid)
+	{
+		bPreviewPlacementValid = bValid;
+		SetPreviewTint(Preview, bValid);
+	}
+}
+
+void AOrionPlayerController::SetPreviewTint(const AActor* Preview, const bool bValid) const
+{
+	if (!Preview) return;
+
+	const UOrionStructureComponent* StructureComp = Preview->FindComponentByClass<UOrionStructureComponent>();
+	if (!StructureComp || !StructureComp->StructureMesh) return;
+
+	// 预览材质需要暴露 PreviewTint 向量参数（绿色 = 可放置，红色 = 无支撑会立即坍塌）
+	StructureComp->StructureMesh->SetVectorParameterValueOnMaterials(
+		PreviewTintParameterName, bValid ? FVector(0.f, 1.f, 0.f) : FVector(1.f, 0.f, 0.f));
 }
 
 void AOrionPlayerController::ConfirmPlaceStructure(AActor*& PreviewPtr)
@@ -614,6 +695,13 @@ void AOrionPlayerController::ConfirmPlaceStructure(AActor*& PreviewPtr)
 		return; // Preview has no structure component → Direct free placement
 	}
 
+	/* Reject unsupported placements before any resource is spent */
+	if (!bPreviewPlacementValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OrionPlayerController::ConfirmPlaceStructure: Placement has no support, rejected."));
+		return;
+	}
+
 
 	/* Check Fraction Affordability */
 	UOrionFactionManager* FactionManager = GetGameInstance()->GetSubsystem<UOrionFactionManager>();
@@ -747,6 +835,13 @@ void AOrionPlayerController::DemolishStructureUnderCursor() const
 		HitResult
 	);
 	AActor* HitStructure = Cast<AActor>(HitResult.GetActor());
+
+	// Instanced structure: bring the actor back so it is destroyed through the normal path
+	if (UOrionBuildingRenderManager::IsStructureInstanceComponent(HitResult.GetComponent()))
+	{
+		HitStructure = GetGameInstance()->GetSubsystem<UOrionBuildingRenderManager>()->HydrateFromHit(HitResult);
+	}
+
 	if (HitStructure)
 	{
 		UE_LOG(LogTemp, Log, TEXT("Demolishing structure: %s"), *HitStructure->GetName());
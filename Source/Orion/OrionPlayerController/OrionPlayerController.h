@@ -160,6 +160,14 @@ public:
 	bool IsPlacingStructure = false;
 	bool IsStructureSnapped = false;
 
+	// [Stability] 预览位置的稳定性评估结果（每帧更新），不稳定的位置在确认时直接拒绝
+	bool bPreviewPlacementValid = true;
+	void UpdatePreviewStability(AActor* Preview, EOrionStructure Kind);
+	void SetPreviewTint(const AActor* Preview, bool bValid) const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Build")
+	FName PreviewTintParameterName = TEXT("PreviewTint");
+
 	/* 0. Demolishing Mode */
 
 	void OnToggleDemolishingMode(bool bIsChecked);
@@ -195,6 +203,7 @@ public:
 	void OnKey6Pressed();
 	void OnKey7Pressed();
 	void OnKey8Pressed();
+	void OnKey9Pressed();
 
 
 	/* Niagara Interaction Effect */
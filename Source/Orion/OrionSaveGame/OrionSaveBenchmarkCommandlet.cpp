@@ -0,0 +1,537 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionSaveGame/OrionSaveBenchmarkCommandlet.h"
+#include "Orion/OrionGameInstance/OrionGameInstance.h"
+#include "Orion/OrionGameInstance/OrionActorManager.h"
+#include "Orion/OrionGameInstance/OrionAssetPreloadManager.h"
+#include "Orion/OrionGameInstance/OrionBuildingManager.h"
+#include "Orion/OrionGameInstance/OrionCharaManager.h"
+#include "Orion/OrionGameInstance/OrionInventoryManager.h"
+#include "Orion/OrionGameInstance/OrionWorldLoadManager.h"
+#include "Orion/OrionComponents/OrionInventoryComponent.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "Orion/OrionSaveGame/OrionStructureRecordCodec.h"
+#include "Orion/OrionStructure/OrionStructure.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "EngineUtils.h"
+#include "GameMapsSettings.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr double StructureSpacing = 125.0;   // Foundation edge
+	constexpr double FoundationHalfHeight = 10.0;
+	constexpr double CharaSpacing = 200.0;
+
+	/* Hash tolerances. Loads teleport to the saved floats; quantized structure records move by at most half a
+	 * codec step, which stays well inside them (the benchmark grid itself lies on exact multiples) */
+	constexpr double LocationTolerance = 0.1;  // cm
+	constexpr double RotationTolerance = 0.5;  // degrees
+	constexpr double ScaleTolerance = 0.001;
+	static_assert(FOrionStructureRecordCodec::PositionStep < LocationTolerance);
+	static_assert(360.0 / FOrionStructureRecordCodec::YawSteps < RotationTolerance);
+
+	void WriteRounded(FArchive& Ar, const FVector& Vector, const double Tolerance)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			int64 Value = FMath::RoundToInt64(Vector[Axis] / Tolerance);
+			Ar << Value;
+		}
+	}
+
+	void WriteRounded(FArchive& Ar, const FRotator& Rotator)
+	{
+		WriteRounded(Ar, Rotator.GetNormalized().Euler(), RotationTolerance);
+	}
+
+	/* SaveGame properties against a table of their own, so the bytes do not depend on the other records */
+	void WriteObjectState(FArchive& Ar, UObject& Object)
+	{
+		FOrionSaveNameTableBuilder Names;
+		TArray<uint8> Bytes;
+		FOrionNameTableArchive::WriteObject(Object, Names, Bytes);
+
+		FOrionSaveNameTable Table;
+		Names.TakeNewEntries(Table);
+		Ar << Bytes << Table.Names << Table.GameIds;
+	}
+
+	void WriteSortedMap(FArchive& Ar, const TMap<int32, int32>& Map)
+	{
+		TArray<TPair<int32, int32>> Pairs = Map.Array();
+		Pairs.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key < B.Key; });
+		for (TPair<int32, int32>& Pair : Pairs)
+		{
+			Ar << Pair.Key << Pair.Value;
+		}
+	}
+
+	struct FStateEntry
+	{
+		uint8 Kind = 0;
+		FGuid GameId;
+		TArray<uint8> Bytes;
+	};
+}
+
+UOrionSaveBenchmarkCommandlet::UOrionSaveBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOrionSaveBenchmarkCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+	FParse::Value(*Params, TEXT("Actions="), NumActionsPerCharacter);
+	FParse::Value(*Params, TEXT("Structures="), NumStructures);
+	FParse::Value(*Params, TEXT("Inventories="), NumInventories);
+
+	int32 Iterations = 3;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	const bool bInPlace = FParse::Param(*Params, TEXT("InPlace"));
+
+	FString CsvPath = FPaths::ProjectSavedDir() / TEXT("SaveBenchmark") / TEXT("SaveBenchmark.csv");
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	const FString SavePath = FPaths::ProjectSavedDir() / TEXT("SaveBenchmark") / TEXT("SaveBenchmark.sav");
+
+	/* ① Standalone game instance and its world */
+	UOrionGameInstance* GameInstance = CreateGameInstance();
+	if (!GameInstance)
+	{
+		return 1;
+	}
+
+	UOrionAssetPreloadManager* PreloadManager = GameInstance->GetSubsystem<UOrionAssetPreloadManager>();
+	UOrionWorldLoadManager* WorldLoadManager = GameInstance->GetSubsystem<UOrionWorldLoadManager>();
+	check(PreloadManager && WorldLoadManager);
+
+	if (!PumpUntil([PreloadManager]() { return PreloadManager->IsPreloadComplete(); }))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveBenchmark] Startup preload did not finish."));
+		return 1;
+	}
+
+	/* ② Synthetic world */
+	BuildWorld(*GameInstance);
+	const uint64 ExpectedHash = HashWorldState(*GameInstance);
+
+	bool bSaveFinished = false;
+	bool bSaveSucceeded = false;
+	const FDelegateHandle SaveHandle = GameInstance->OnSaveFinished.AddLambda(
+		[&bSaveFinished, &bSaveSucceeded](const FString&, const bool bSuccess)
+		{
+			bSaveFinished = true;
+			bSaveSucceeded = bSuccess;
+		});
+
+	bool bLoadFinished = false;
+	int32 LoadFrames = 0;
+	const FDelegateHandle ProgressHandle = WorldLoadManager->OnProgress.AddLambda(
+		[&LoadFrames](EOrionWorldLoadPhase, float) { ++LoadFrames; });
+	const FDelegateHandle FinishedHandle = WorldLoadManager->OnFinished.AddLambda(
+		[&bLoadFinished]() { bLoadFinished = true; });
+
+	const TCHAR* CsvHeader = TEXT("Iteration,Characters,ActionsPerCharacter,Structures,Inventories,InPlace,"
+		"SnapshotMs,WriteMs,FileBytes,ReadMs,ApplyMs,ApplyFrames,PeakUsedMB,ExpectedHash,LoadedHash,Match");
+	TArray<FString> CsvRows;
+	UE_LOG(LogTemp, Display, TEXT("%s"), CsvHeader);
+
+	bool bAllMatched = true;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		/* ③ Save: records on the game thread, container + compression + write on a worker */
+		PumpUntil([GameInstance]() { return !GameInstance->IsSaveInProgress(); });
+
+		double StartTime = FPlatformTime::Seconds();
+		UOrionSaveGame* SaveObj = NewObject<UOrionSaveGame>();
+		FOrionSaveNameTableBuilder Names;
+		GameInstance->CollectAllRecords(SaveObj, Names);
+		const double SnapshotMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		bSaveFinished = false;
+		bSaveSucceeded = false;
+		if (!GameInstance->WriteSaveAsync(SaveObj, SavePath) ||
+			!PumpUntil([&bSaveFinished]() { return bSaveFinished; }) || !bSaveSucceeded)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SaveBenchmark] Save to %s failed."), *SavePath);
+			bAllMatched = false;
+			break;
+		}
+		const double WriteMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		const int64 FileBytes = IFileManager::Get().FileSize(*SavePath);
+
+		if (!bInPlace)
+		{
+			ClearWorld(*GameInstance);
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		/* ④ Load: file + parallel section decode, then the time-sliced world load */
+		StartTime = FPlatformTime::Seconds();
+		UOrionSaveGame* LoadObj = GameInstance->ReadSaveFile(SavePath);
+		const double ReadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		if (!LoadObj)
+		{
+			bAllMatched = false;
+			break;
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		bLoadFinished = false;
+		LoadFrames = 0;
+		GameInstance->RestoreFromSave(LoadObj);
+		if (!PumpUntil([&bLoadFinished]() { return bLoadFinished; }))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SaveBenchmark] World load did not finish."));
+			bAllMatched = false;
+			break;
+		}
+		const double ApplyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		/* ⑤ Round trip check */
+		const uint64 LoadedHash = HashWorldState(*GameInstance);
+		const bool bMatch = LoadedHash == ExpectedHash;
+		bAllMatched &= bMatch;
+
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		const FString Row = FString::Printf(
+			TEXT("%d,%d,%d,%d,%d,%d,%.3f,%.3f,%lld,%.3f,%.3f,%d,%.1f,%016llx,%016llx,%d"),
+			Iteration, NumCharacters, NumActionsPerCharacter, NumStructures, NumInventories, bInPlace ? 1 : 0,
+			SnapshotMs, WriteMs, FileBytes, ReadMs, ApplyMs, LoadFrames,
+			MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0), ExpectedHash, LoadedHash, bMatch ? 1 : 0);
+		UE_LOG(LogTemp, Display, TEXT("%s"), *Row);
+		CsvRows.Add(Row);
+
+		if (!bMatch)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SaveBenchmark] Iteration %d: world state differs after the round trip."),
+			       Iteration);
+		}
+	}
+
+	GameInstance->OnSaveFinished.Remove(SaveHandle);
+	WorldLoadManager->OnProgress.Remove(ProgressHandle);
+	WorldLoadManager->OnFinished.Remove(FinishedHandle);
+
+	/* ⑥ Rows are appended, one file tracks a series of runs */
+	if (CsvRows.Num() > 0)
+	{
+		if (!IFileManager::Get().FileExists(*CsvPath))
+		{
+			CsvRows.Insert(CsvHeader, 0);
+		}
+		FFileHelper::SaveStringArrayToFile(CsvRows, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		                                   &IFileManager::Get(), FILEWRITE_Append);
+		UE_LOG(LogTemp, Display, TEXT("[SaveBenchmark] Results appended to %s"), *CsvPath);
+	}
+
+	UWorld* World = GameInstance->GetWorld();
+	GameInstance->Shutdown();
+	GameInstance->RemoveFromRoot();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return bAllMatched ? 0 : 1;
+}
+
+UOrionGameInstance* UOrionSaveBenchmarkCommandlet::CreateGameInstance()
+{
+	// The project's game instance (data tables, subsystems configured in its Blueprint)
+	UClass* GameInstanceClass = GetDefault<UGameMapsSettings>()->GameInstanceClass.TryLoadClass<UOrionGameInstance>();
+	if (!GameInstanceClass)
+	{
+		GameInstanceClass = UOrionGameInstance::StaticClass();
+	}
+
+	UOrionGameInstance* GameInstance = NewObject<UOrionGameInstance>(GEngine, GameInstanceClass);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone(TEXT("OrionSaveBenchmark"));
+
+	UWorld* World = GameInstance->GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveBenchmark] Failed to create the world."));
+		GameInstance->RemoveFromRoot();
+		return nullptr;
+	}
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	return GameInstance;
+}
+
+void UOrionSaveBenchmarkCommandlet::BuildWorld(UOrionGameInstance& GameInstance) const
+{
+	UWorld* World = GameInstance.GetWorld();
+	check(World);
+
+	/* Structures on X, Y >= 0, characters on Y < 0, inventory actors on X, Y < 0 */
+	const int32 StructureSide = FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumStructures)));
+	const int32 CharaSide = FMath::Max(1, FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumCharacters))));
+	const int32 InventorySide = FMath::Max(1, FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumInventories))));
+	const double Extent = FMath::Max3(StructureSide * StructureSpacing, CharaSide * CharaSpacing,
+	                                  InventorySide * CharaSpacing) + 1000.0;
+
+	/* ① Floor: structures are grounded, characters traced onto it at load */
+	if (UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")))
+	{
+		AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0, 0.0, -50.0), FRotator::ZeroRotator);
+		Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+		Floor->SetActorScale3D(FVector(Extent / 50.0, Extent / 50.0, 1.0));
+	}
+
+	/* ② Inventory actors, targets of the interact actions below */
+	FRandomStream Random(0);
+	TArray<AOrionActor*> InventoryActors;
+	for (int32 i = 0; i < NumInventories; ++i)
+	{
+		const FVector Location(-300.0 - (i % InventorySide) * CharaSpacing, -300.0 - (i / InventorySide) * CharaSpacing,
+		                       0.0);
+		AOrionActor* Actor = World->SpawnActor<AOrionActor>(AOrionActor::StaticClass(), Location, FRotator::ZeroRotator);
+		if (!Actor || !Actor->InventoryComp)
+		{
+			continue;
+		}
+
+		TMap<int32, int32> Items;
+		TMap<int32, int32> Capacity;
+		for (int32 ItemId = 1; ItemId <= 5; ++ItemId)
+		{
+			Items.Add(ItemId, Random.RandRange(0, 100));
+			Capacity.Add(ItemId, 100);
+		}
+		Actor->InventoryComp->SetCapacityMap(Capacity);
+		Actor->InventoryComp->ForceSetInventory(Items);
+		InventoryActors.Add(Actor);
+	}
+
+	/* ③ Characters with procedural queues */
+	if (UOrionCharaManager* CharaManager = GameInstance.GetSubsystem<UOrionCharaManager>())
+	{
+		for (int32 i = 0; i < NumCharacters; ++i)
+		{
+			FOrionCharaSpawnParams SpawnParams;
+			SpawnParams.SpawnRotation = FRotator(0.0, Random.RandRange(0, 3) * 90.0, 0.0);
+			for (int32 j = 0; j < NumActionsPerCharacter; ++j)
+			{
+				FOrionActionParams Action;
+				if (j % 4 == 3 && InventoryActors.Num() > 0)
+				{
+					Action.OrionActionType = EOrionAction::InteractWithActor;
+					Action.TargetActorId = InventoryActors[Random.RandHelper(InventoryActors.Num())]->GetSerializable().GameId;
+				}
+				else
+				{
+					Action.OrionActionType = EOrionAction::MoveToLocation;
+					Action.TargetLocation = FVector(Random.FRandRange(0.0, Extent), Random.FRandRange(-Extent, 0.0), 0.0);
+				}
+				SpawnParams.InitialProceduralActions.Add(Action);
+			}
+
+			const FVector Location((i % CharaSide) * CharaSpacing, -300.0 - (i / CharaSide) * CharaSpacing, 0.0);
+			CharaManager->SpawnCharaInstance(Location, SpawnParams);
+		}
+	}
+
+	/* ④ Structures: a foundation grid, scaled as placed pieces are, through the same bulk path as a load */
+	UOrionSaveGame* Structures = NewObject<UOrionSaveGame>();
+	if (const UOrionBuildingManager* BuildingManager = GameInstance.GetSubsystem<UOrionBuildingManager>())
+	{
+		const FOrionDataBuilding* Foundation = BuildingManager->GetOrionDataBuildings().FindByPredicate(
+			[](const FOrionDataBuilding& Data)
+			{
+				return Data.BuildingPlacingRule == EOrionStructure::BasicSquareFoundation;
+			});
+		const FVector* OriginalScale =
+			UOrionBuildingManager::StructureOriginalScaleMap.Find(EOrionStructure::BasicSquareFoundation);
+		const FVector Scale = OriginalScale ? *OriginalScale : FVector::OneVector;
+
+		for (int32 i = 0; Foundation && i < NumStructures; ++i)
+		{
+			const FVector Location((i % StructureSide) * StructureSpacing, (i / StructureSide) * StructureSpacing,
+			                       FoundationHalfHeight);
+			Structures->SavedStructures.Emplace(Foundation->BuildingBlueprintReference,
+			                                    FTransform(FRotator::ZeroRotator, Location, Scale));
+		}
+	}
+	GameInstance.LoadAllBuildings(Structures, World);
+
+	UE_LOG(LogTemp, Display, TEXT("[SaveBenchmark] World: %d characters, %d structures, %d inventory actors."),
+	       NumCharacters, Structures->SavedStructures.Num(), InventoryActors.Num());
+}
+
+void UOrionSaveBenchmarkCommandlet::ClearWorld(UOrionGameInstance& GameInstance)
+{
+	UWorld* World = GameInstance.GetWorld();
+	check(World);
+
+	if (UOrionCharaManager* CharaManager = GameInstance.GetSubsystem<UOrionCharaManager>())
+	{
+		CharaManager->RemoveAllCharacters(World);
+	}
+	if (UOrionActorManager* ActorManager = GameInstance.GetSubsystem<UOrionActorManager>())
+	{
+		UOrionActorManager::RemoveAllActors(World);
+		ActorManager->ResetActorMap();
+	}
+
+	// Same order as UOrionWorldLoadManager::StartLoad: empty graph first, then destroy inside one bulk load
+	UOrionBuildingManager* BuildingManager = GameInstance.GetSubsystem<UOrionBuildingManager>();
+	if (BuildingManager)
+	{
+		BuildingManager->ResetAllSockets(World);
+		BuildingManager->BeginBulkLoad();
+	}
+	for (TActorIterator<AOrionStructure> It(World); It; ++It)
+	{
+		It->Destroy();
+	}
+	if (BuildingManager)
+	{
+		BuildingManager->EndBulkLoad();
+	}
+}
+
+uint64 UOrionSaveBenchmarkCommandlet::HashWorldState(const UOrionGameInstance& GameInstance)
+{
+	const UWorld* World = GameInstance.GetWorld();
+	check(World);
+
+	TArray<FStateEntry> Entries;
+	auto AddEntry = [&Entries](const uint8 Kind, const FGuid& GameId) -> TArray<uint8>&
+	{
+		FStateEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Kind = Kind;
+		Entry.GameId = GameId;
+		return Entry.Bytes;
+	};
+
+	/* ① Characters: transform, procedural queue, SaveGame properties */
+	if (const UOrionCharaManager* CharaManager = GameInstance.GetSubsystem<UOrionCharaManager>())
+	{
+		for (const TPair<FGuid, TWeakObjectPtr<AOrionChara>>& Pair : CharaManager->GetAllCharas())
+		{
+			AOrionChara* Chara = Pair.Value.Get();
+			if (!Chara)
+			{
+				continue;
+			}
+
+			FOrionCharaSerializable S = UOrionCharaManager::GatherCharaRecord(Chara);
+			FMemoryWriter Ar(AddEntry(0, S.CharaGameId));
+			WriteRounded(Ar, S.CharaLocation, LocationTolerance);
+			WriteRounded(Ar, S.CharaRotation);
+			for (FOrionActionParams& Action : S.SerializedProcActions)
+			{
+				uint8 Type = static_cast<uint8>(Action.OrionActionType);
+				Ar << Type << Action.TargetActorId << Action.Quantity;
+				WriteRounded(Ar, Action.TargetLocation, LocationTolerance);
+				WriteRounded(Ar, Action.HitOffset, LocationTolerance);
+			}
+			WriteObjectState(Ar, *Chara);
+		}
+	}
+
+	/* ② Actors */
+	for (TActorIterator<AOrionActor> It(World); It; ++It)
+	{
+		FOrionActorFullRecord R = UOrionActorManager::GatherActorRecord(*It);
+		FMemoryWriter Ar(AddEntry(1, R.ActorGameId));
+		Ar << R.ClassPath;
+		WriteRounded(Ar, R.ActorTransform.GetLocation(), LocationTolerance);
+		WriteRounded(Ar, R.ActorTransform.Rotator());
+		WriteObjectState(Ar, **It);
+	}
+
+	/* ③ Inventories */
+	if (const UOrionInventoryManager* InventoryManager = GameInstance.GetSubsystem<UOrionInventoryManager>())
+	{
+		TArray<FOrionInventorySerializable> Inventories;
+		InventoryManager->CollectInventoryRecords(Inventories);
+		for (const FOrionInventorySerializable& Inventory : Inventories)
+		{
+			FMemoryWriter Ar(AddEntry(2, Inventory.OwnerGameId));
+			WriteSortedMap(Ar, Inventory.SerializedInventoryMap);
+			WriteSortedMap(Ar, Inventory.SerializedAvailableInventoryMap);
+		}
+	}
+
+	/* ④ Structures: raw transforms, so a codec error beyond the tolerances changes the hash */
+	if (const UOrionBuildingManager* BuildingManager = GameInstance.GetSubsystem<UOrionBuildingManager>())
+	{
+		TArray<FOrionStructureRecord> Records;
+		BuildingManager->CollectStructureRecords(Records);
+		for (FOrionStructureRecord& Record : Records)
+		{
+			FMemoryWriter Ar(AddEntry(3, FGuid()));
+			Ar << Record.ClassPath;
+			WriteRounded(Ar, Record.Transform.GetLocation(), LocationTolerance);
+			WriteRounded(Ar, Record.Transform.Rotator());
+			WriteRounded(Ar, Record.Transform.GetScale3D(), ScaleTolerance);
+		}
+	}
+
+	/* Record order depends on spawn order, the hash must not */
+	Entries.Sort([](const FStateEntry& A, const FStateEntry& B)
+	{
+		if (A.Kind != B.Kind)
+		{
+			return A.Kind < B.Kind;
+		}
+		if (A.GameId != B.GameId)
+		{
+			return A.GameId < B.GameId;
+		}
+		if (A.Bytes.Num() != B.Bytes.Num())
+		{
+			return A.Bytes.Num() < B.Bytes.Num();
+		}
+		return FMemory::Memcmp(A.Bytes.GetData(), B.Bytes.GetData(), A.Bytes.Num()) < 0;
+	});
+
+	FXxHash64Builder Hash;
+	for (const FStateEntry& Entry : Entries)
+	{
+		Hash.Update(&Entry.Kind, sizeof(Entry.Kind));
+		Hash.Update(&Entry.GameId, sizeof(Entry.GameId));
+		Hash.Update(Entry.Bytes.GetData(), Entry.Bytes.Num());
+	}
+	return Hash.Finalize().Hash;
+}
+
+bool UOrionSaveBenchmarkCommandlet::PumpUntil(const TFunctionRef<bool()> IsDone, const double TimeoutSeconds)
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	const double StartTime = FPlatformTime::Seconds();
+
+	while (!IsDone())
+	{
+		if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+		{
+			return false;
+		}
+
+		// Streamable requests, the time-sliced world load and AsyncTask(GameThread) callbacks
+		ProcessAsyncLoading(true, false, DeltaTime);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		FPlatformProcess::Sleep(0.f);
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OrionSaveBenchmarkCommandlet.generated.h"
+
+class UOrionGameInstance;
+
+/**
+ * Headless save / load round trip, for tracking save performance without playing:
+ *
+ *   UnrealEditor-Cmd Orion.uproject -run=OrionSaveBenchmark -nullrhi -unattended
+ *       [-Characters=200] [-Actions=8] [-Structures=2000] [-Inventories=100] [-Iterations=3] [-InPlace]
+ *       [-Csv=Saved/SaveBenchmark/SaveBenchmark.csv]
+ *
+ * Builds a synthetic world in a standalone game instance (characters with procedural action queues, a grid of
+ * structures on a floor, actors holding inventories), then runs the game instance pipelines: CollectAllRecords +
+ * WriteSaveAsync, ReadSaveFile + RestoreFromSave. The world is cleared before each load, or updated in place with
+ * -InPlace. A hash of the world state must be the same after the round trip.
+ *
+ * One CSV row per iteration (timings, file size, peak memory, hashes) goes to the log and is appended to the Csv
+ * file. Returns 1 if a load failed or a hash differs.
+ */
+UCLASS()
+class ORION_API UOrionSaveBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOrionSaveBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	static UOrionGameInstance* CreateGameInstance();
+
+	void BuildWorld(UOrionGameInstance& GameInstance) const;
+
+	/* Destroys every character, actor and structure (the next load spawns all of them again) */
+	static void ClearWorld(UOrionGameInstance& GameInstance);
+
+	/* Order independent hash of what a save keeps */
+	static uint64 HashWorldState(const UOrionGameInstance& GameInstance);
+
+	/* Ticks the core ticker, async loading and the game thread tasks until IsDone, false after TimeoutSeconds */
+	static bool PumpUntil(TFunctionRef<bool()> IsDone, double TimeoutSeconds = 600.0);
+
+	int32 NumCharacters = 200;
+	int32 NumActionsPerCharacter = 8;
+	int32 NumStructures = 2000;
+	int32 NumInventories = 100;
+};
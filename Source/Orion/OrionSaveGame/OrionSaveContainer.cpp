@@ -0,0 +1,420 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionSaveGame/OrionSaveContainer.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "Orion/OrionSaveGame/OrionStructureRecordCodec.h"
+#include "Orion/OrionChara/OrionChara.h"
+#include "Orion/OrionComponents/OrionInventoryComponent.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace
+{
+	template <typename T>
+	void SerializeRecords(FArchive& InnerAr, TArray<T>& Records)
+	{
+		FObjectAndNameAsStringProxyArchive Ar(InnerAr, InnerAr.IsLoading());
+		Ar.ArIsSaveGame = true;
+
+		int32 Num = Records.Num();
+		Ar << Num;
+
+		if (Ar.IsLoading())
+		{
+			// Every record takes at least a few bytes, a larger count means a broken chunk
+			if (Num < 0 || Num > InnerAr.TotalSize() - InnerAr.Tell())
+			{
+				InnerAr.SetError();
+				return;
+			}
+			Records.Reset(Num);
+			Records.SetNum(Num);
+		}
+
+		UScriptStruct* Struct = T::StaticStruct();
+		for (T& Record : Records)
+		{
+			Struct->SerializeItem(Ar, &Record, nullptr);
+		}
+	}
+
+	template <typename T>
+	void SerializeStruct(FArchive& InnerAr, T& Value)
+	{
+		FObjectAndNameAsStringProxyArchive Ar(InnerAr, InnerAr.IsLoading());
+		Ar.ArIsSaveGame = true;
+		T::StaticStruct()->SerializeItem(Ar, &Value, nullptr);
+	}
+
+	struct FSectionDesc
+	{
+		EOrionSaveSection Id;
+		uint32 Version;
+		const TCHAR* Name;
+		void (*Serialize)(FArchive&, UOrionSaveGame&, uint32 /*Version*/);
+	};
+
+	// 新增存档数据：在 UOrionSaveGame 里加数组，在这里加一个 section；记录格式不兼容地改动时提升 Version
+	const FSectionDesc GSections[] = {
+		{
+			EOrionSaveSection::Characters, 1, TEXT("Characters"),
+			[](FArchive& Ar, UOrionSaveGame& Save, uint32) { SerializeRecords(Ar, Save.SavedCharacters); }
+		},
+		{
+			EOrionSaveSection::Actors, 1, TEXT("Actors"),
+			[](FArchive& Ar, UOrionSaveGame& Save, uint32) { SerializeRecords(Ar, Save.SavedActors); }
+		},
+		{
+			// 2: FOrionStructureRecordCodec (class dictionary, quantized delta-encoded transforms)
+			// 3: + scale dictionary, scaled pieces quantized too
+			// 4: + StructureId per record (autosave delta key)
+			EOrionSaveSection::Structures, FOrionStructureRecordCodec::Version, TEXT("Structures"),
+			[](FArchive& Ar, UOrionSaveGame& Save, const uint32 Version)
+			{
+				if (Version >= 2)
+				{
+					FOrionStructureRecordCodec::Serialize(Ar, Save.SavedStructures, Version);
+				}
+				else
+				{
+					SerializeRecords(Ar, Save.SavedStructures);
+				}
+			}
+		},
+		{
+			EOrionSaveSection::Inventories, 1, TEXT("Inventories"),
+			[](FArchive& Ar, UOrionSaveGame& Save, uint32) { SerializeRecords(Ar, Save.SavedInventories); }
+		},
+		{
+			EOrionSaveSection::Removed, 1, TEXT("Removed"),
+			[](FArchive& Ar, UOrionSaveGame& Save, uint32) { SerializeRecords(Ar, Save.RemovedRecords); }
+		},
+		{
+			EOrionSaveSection::NameTable, 1, TEXT("NameTable"),
+			[](FArchive& Ar, UOrionSaveGame& Save, uint32) { SerializeStruct(Ar, Save.NameTable); }
+		},
+	};
+
+	const FSectionDesc* FindSection(const uint32 Id)
+	{
+		for (const FSectionDesc& Desc : GSections)
+		{
+			if (static_cast<uint32>(Desc.Id) == Id)
+			{
+				return &Desc;
+			}
+		}
+		return nullptr;
+	}
+
+	enum class ECompressionMethod : uint8
+	{
+		Zlib = 0,
+		Oodle = 1,
+	};
+
+	FName GetCompressionFormat(const ECompressionMethod Method)
+	{
+		return Method == ECompressionMethod::Oodle ? NAME_Oodle : NAME_Zlib;
+	}
+
+	bool ReadMagic(const TConstArrayView<uint8> Bytes, const uint32 Expected)
+	{
+		if (Bytes.Num() < static_cast<int32>(sizeof(uint32)))
+		{
+			return false;
+		}
+
+		uint32 FileMagic = 0;
+		FMemory::Memcpy(&FileMagic, Bytes.GetData(), sizeof(uint32));
+		return FileMagic == Expected;
+	}
+}
+
+const TCHAR* FOrionSaveContainer::GetSectionName(const uint32 Id)
+{
+	const FSectionDesc* Desc = FindSection(Id);
+	return Desc ? Desc->Name : TEXT("Unknown");
+}
+
+bool FOrionSaveContainer::IsContainer(const TConstArrayView<uint8> Bytes)
+{
+	return ReadMagic(Bytes, Magic);
+}
+
+bool FOrionSaveContainer::IsCompressed(const TConstArrayView<uint8> Bytes)
+{
+	return ReadMagic(Bytes, CompressedMagic);
+}
+
+bool FOrionSaveContainer::Compress(const TConstArrayView<uint8> RawBytes, TArray<uint8>& OutBytes)
+{
+	const ECompressionMethod Method = FCompression::IsFormatValid(NAME_Oodle)
+		                                  ? ECompressionMethod::Oodle
+		                                  : ECompressionMethod::Zlib;
+	const FName Format = GetCompressionFormat(Method);
+
+	uint32 FileMagic = CompressedMagic;
+	uint8 MethodByte = static_cast<uint8>(Method);
+	int64 RawSize = RawBytes.Num();
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	Writer << FileMagic << MethodByte << RawSize;
+	const int32 HeaderSize = OutBytes.Num();
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(Format, RawBytes.Num());
+	OutBytes.SetNumUninitialized(HeaderSize + CompressedSize);
+
+	if (!FCompression::CompressMemory(Format, OutBytes.GetData() + HeaderSize, CompressedSize,
+	                                  RawBytes.GetData(), RawBytes.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Compression (%s) failed"), *Format.ToString());
+		OutBytes.Reset();
+		return false;
+	}
+
+	OutBytes.SetNum(HeaderSize + CompressedSize);
+	return true;
+}
+
+bool FOrionSaveContainer::Decompress(const TConstArrayView<uint8> Bytes, TArray<uint8>& OutRawBytes)
+{
+	if (!IsCompressed(Bytes))
+	{
+		OutRawBytes.Reset(Bytes.Num());
+		OutRawBytes.Append(Bytes.GetData(), Bytes.Num());
+		return true;
+	}
+
+	FMemoryReaderView Reader(Bytes);
+
+	uint32 FileMagic = 0;
+	uint8 MethodByte = 0;
+	int64 RawSize = 0;
+	Reader << FileMagic << MethodByte << RawSize;
+
+	if (Reader.IsError() || MethodByte > static_cast<uint8>(ECompressionMethod::Oodle) ||
+		RawSize < 0 || RawSize > MAX_int32)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Broken compressed header"));
+		return false;
+	}
+
+	const FName Format = GetCompressionFormat(static_cast<ECompressionMethod>(MethodByte));
+	const int32 HeaderSize = static_cast<int32>(Reader.Tell());
+
+	OutRawBytes.SetNumUninitialized(static_cast<int32>(RawSize));
+	if (!FCompression::UncompressMemory(Format, OutRawBytes.GetData(), OutRawBytes.Num(),
+	                                    Bytes.GetData() + HeaderSize, Bytes.Num() - HeaderSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Decompression (%s) failed"), *Format.ToString());
+		OutRawBytes.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FOrionSaveContainer::Write(UOrionSaveGame& SaveObj, TArray<uint8>& OutBytes)
+{
+	constexpr int32 NumSections = UE_ARRAY_COUNT(GSections);
+
+	/* ① Chunks, independent of each other */
+	TArray<TArray<uint8>> Chunks;
+	Chunks.SetNum(NumSections);
+
+	ParallelFor(NumSections, [&](const int32 i)
+	{
+		FMemoryWriter ChunkWriter(Chunks[i]);
+		GSections[i].Serialize(ChunkWriter, SaveObj, GSections[i].Version);
+	});
+
+	/* ② Header + table of contents */
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = FormatVersion;
+	int32 Count = NumSections;
+	Writer << FileMagic << FileVersion << Count;
+
+	int64 Offset = 0;
+	for (int32 i = 0; i < NumSections; ++i)
+	{
+		FOrionSaveSectionEntry Entry;
+		Entry.Id = static_cast<uint32>(GSections[i].Id);
+		Entry.Version = GSections[i].Version;
+		Entry.Offset = Offset;
+		Entry.Size = Chunks[i].Num();
+		Entry.Checksum = FCrc::MemCrc32(Chunks[i].GetData(), Chunks[i].Num());
+		Writer << Entry;
+
+		Offset += Entry.Size;
+	}
+
+	/* ③ Chunks */
+	for (TArray<uint8>& Chunk : Chunks)
+	{
+		Writer.Serialize(Chunk.GetData(), Chunk.Num());
+	}
+}
+
+bool FOrionSaveContainer::ReadToc(const TConstArrayView<uint8> Bytes, TArray<FOrionSaveSectionEntry>& OutToc,
+                                  int64& OutDataStart)
+{
+	OutToc.Reset();
+	OutDataStart = 0;
+
+	if (!IsContainer(Bytes))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(Bytes);
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	int32 Count = 0;
+	Reader << FileMagic << FileVersion << Count;
+
+	if (FileVersion > FormatVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Format version %u is newer than supported %u"),
+		       FileVersion, FormatVersion);
+		return false;
+	}
+
+	constexpr int32 EntrySize = 3 * sizeof(uint32) + 2 * sizeof(int64);
+	if (Reader.IsError() || Count < 0 || Count > Bytes.Num() / EntrySize)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Broken header"));
+		return false;
+	}
+
+	OutToc.SetNum(Count);
+	for (FOrionSaveSectionEntry& Entry : OutToc)
+	{
+		Reader << Entry;
+	}
+
+	OutDataStart = Reader.Tell();
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Broken table of contents"));
+		OutToc.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FOrionSaveContainer::Read(const TConstArrayView<uint8> Bytes, UOrionSaveGame& SaveObj,
+                               const TConstArrayView<EOrionSaveSection> Sections)
+{
+	TArray<FOrionSaveSectionEntry> Toc;
+	int64 DataStart = 0;
+	if (!ReadToc(Bytes, Toc, DataStart))
+	{
+		return false;
+	}
+
+	/* ① Pick the sections to decode */
+	TArray<TPair<const FOrionSaveSectionEntry*, const FSectionDesc*>> Jobs;
+	TSet<uint32> SeenIds;
+	for (const FOrionSaveSectionEntry& Entry : Toc)
+	{
+		if (Sections.Num() > 0 && !Sections.Contains(static_cast<EOrionSaveSection>(Entry.Id)))
+		{
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		SeenIds.Add(Entry.Id, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SaveContainer] Duplicate section %u ignored"), Entry.Id);
+			continue;
+		}
+
+		const FSectionDesc* Desc = FindSection(Entry.Id);
+		if (!Desc)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[SaveContainer] Skipping unknown section %u"), Entry.Id);
+			continue;
+		}
+		if (Entry.Version > Desc->Version)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SaveContainer] Skipping section %s: version %u is newer than %u"),
+			       Desc->Name, Entry.Version, Desc->Version);
+			continue;
+		}
+
+		Jobs.Emplace(&Entry, Desc);
+	}
+
+	/* ② Decode in parallel: each section fills its own array of SaveObj, records hold no object references */
+	TArray<bool> Succeeded;
+	Succeeded.Init(false, Jobs.Num());
+
+	ParallelFor(Jobs.Num(), [&](const int32 i)
+	{
+		const FOrionSaveSectionEntry& Entry = *Jobs[i].Key;
+
+		const int64 Begin = DataStart + Entry.Offset;
+		if (Entry.Offset < 0 || Entry.Size < 0 || Begin + Entry.Size > Bytes.Num())
+		{
+			return;
+		}
+
+		const TConstArrayView<uint8> Chunk(Bytes.GetData() + Begin, static_cast<int32>(Entry.Size));
+		if (FCrc::MemCrc32(Chunk.GetData(), Chunk.Num()) != Entry.Checksum)
+		{
+			return;
+		}
+
+		FMemoryReaderView ChunkReader(Chunk);
+		Jobs[i].Value->Serialize(ChunkReader, SaveObj, Jobs[i].Key->Version);
+		Succeeded[i] = !ChunkReader.IsError();
+	});
+
+	bool bAllSucceeded = true;
+	for (int32 i = 0; i < Jobs.Num(); ++i)
+	{
+		if (!Succeeded[i])
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SaveContainer] Section %s is corrupt"), Jobs[i].Value->Name);
+			bAllSucceeded = false;
+		}
+	}
+	return bAllSucceeded;
+}
+
+bool FOrionSaveContainer::WriteFileAtomically(const FString& Path, const TConstArrayView<uint8> Bytes)
+{
+	const FString TempPath = Path + TEXT(".tmp");
+	if (FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, /*Replace=*/true))
+	{
+		return true;
+	}
+
+	IFileManager::Get().Delete(*TempPath, /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+	return false;
+}
+
+bool FOrionSaveContainer::ReadFile(const FString& Path, UOrionSaveGame& SaveObj)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	TArray<uint8> RawBytes;
+	return Decompress(FileData, RawBytes) && Read(RawBytes, SaveObj);
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UOrionSaveGame;
+
+/* Sections of the chunked save file, one per record array of UOrionSaveGame */
+enum class EOrionSaveSection : uint32
+{
+	Characters = 1,
+	Actors = 2,
+	Structures = 3,
+	Inventories = 4,
+	Removed = 5, // Delta autosave chunks only
+	NameTable = 6,
+};
+
+/* Table of contents entry */
+struct FOrionSaveSectionEntry
+{
+	uint32 Id = 0;
+	uint32 Version = 0;
+	int64 Offset = 0;    // From the end of the table of contents
+	int64 Size = 0;      // Bytes
+	uint32 Checksum = 0; // CRC32 of the chunk
+
+	friend FArchive& operator<<(FArchive& Ar, FOrionSaveSectionEntry& Entry)
+	{
+		return Ar << Entry.Id << Entry.Version << Entry.Offset << Entry.Size << Entry.Checksum;
+	}
+};
+
+/**
+ * Chunked binary save file:
+ *
+ *   Magic | FormatVersion | NumSections | TOC entries... | chunk | chunk | ...
+ *
+ * Each chunk holds one record array of UOrionSaveGame, written with tagged property serialization (SaveGame
+ * properties), so fields added to a record later still load. Sections are independent: any subset can be read
+ * and they are decoded in parallel. Unknown section ids and versions newer than this build are skipped.
+ */
+class ORION_API FOrionSaveContainer
+{
+public:
+	static constexpr uint32 Magic = 0x5653524F; // "ORSV"
+	static constexpr uint32 FormatVersion = 1;
+
+	static bool IsContainer(TConstArrayView<uint8> Bytes);
+
+	static void Write(UOrionSaveGame& SaveObj, TArray<uint8>& OutBytes);
+
+	static bool ReadToc(TConstArrayView<uint8> Bytes, TArray<FOrionSaveSectionEntry>& OutToc, int64& OutDataStart);
+
+	/* Decodes the given sections (all known ones if empty) into SaveObj. False if any of them is corrupt */
+	static bool Read(TConstArrayView<uint8> Bytes, UOrionSaveGame& SaveObj,
+	                 TConstArrayView<EOrionSaveSection> Sections = {});
+
+	static const TCHAR* GetSectionName(uint32 Id);
+
+	/* Compressed file: CompressedMagic | method | raw size | compressed container (Oodle when available, else zlib) */
+	static constexpr uint32 CompressedMagic = 0x5A53524F; // "ORSZ"
+
+	static bool IsCompressed(TConstArrayView<uint8> Bytes);
+	static bool Compress(TConstArrayView<uint8> RawBytes, TArray<uint8>& OutBytes);
+
+	/* Copies Bytes as is if they are not compressed */
+	static bool Decompress(TConstArrayView<uint8> Bytes, TArray<uint8>& OutRawBytes);
+
+	/* Writes Path.tmp then renames it over Path, so a crash never leaves a truncated file (any thread) */
+	static bool WriteFileAtomically(const FString& Path, TConstArrayView<uint8> Bytes);
+
+	/* Reads a (compressed) container file into SaveObj (any thread) */
+	static bool ReadFile(const FString& Path, UOrionSaveGame& SaveObj);
+};
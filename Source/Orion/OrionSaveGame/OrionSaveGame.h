@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
 #include "Orion/OrionActor/OrionActor.h"
+#include "Orion/OrionSaveGame/OrionSaveNameTable.h"
 #include "OrionSaveGame.generated.h"
 
 struct FOrionCharaSerializable;
@@ -21,14 +22,33 @@ struct FOrionStructureRecord
 	UPROPERTY(SaveGame)
 	FTransform Transform;
 
+	/** Graph node StructureId when the record was taken, key of the record in autosave deltas (0: none) */
+	UPROPERTY(SaveGame)
+	uint32 StructureId = 0;
+
 	FOrionStructureRecord() = default;
 
-	FOrionStructureRecord(const FString& InPath, const FTransform& InTM)
-		: ClassPath(InPath), Transform(InTM)
+	FOrionStructureRecord(const FString& InPath, const FTransform& InTM, const uint32 InStructureId = 0)
+		: ClassPath(InPath), Transform(InTM), StructureId(InStructureId)
 	{
 	}
 };
 
+/** Record removed since the previous snapshot, only written into delta autosave chunks */
+USTRUCT()
+struct FOrionSaveRemovedRecord
+{
+	GENERATED_BODY()
+
+	/** EOrionSaveSection of the record */
+	UPROPERTY(SaveGame)
+	uint32 Section = 0;
+
+	/** GameId, or the structure key for structures */
+	UPROPERTY(SaveGame)
+	FGuid Key;
+};
+
 UCLASS()
 class ORION_API UOrionSaveGame : public USaveGame
 {
@@ -46,4 +66,11 @@ public:
 
 	UPROPERTY(SaveGame)
 	TArray<FOrionInventorySerializable> SavedInventories;
+
+	UPROPERTY(SaveGame)
+	TArray<FOrionSaveRemovedRecord> RemovedRecords;
+
+	/** Shared by the SerializedBytes of SavedCharacters and SavedActors */
+	UPROPERTY(SaveGame)
+	FOrionSaveNameTable NameTable;
 };
@@ -0,0 +1,535 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionSaveGame/OrionSaveNameTable.h"
+#include "Orion/OrionInterface/OrionInterfaceSerializable.h"
+#include "Serialization/ArchiveUObject.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Async/ParallelFor.h"
+#include "UObject/SoftObjectPtr.h"
+
+bool FOrionSaveNameTable::Append(const FOrionSaveNameTable& Delta)
+{
+	const int32 NameEnd = NameOffset + Names.Num();
+	const int32 GameIdEnd = GameIdOffset + GameIds.Num();
+
+	// A chunk in between is missing
+	if (Delta.NameOffset > NameEnd || Delta.GameIdOffset > GameIdEnd)
+	{
+		return false;
+	}
+
+	// Chunks replayed once more after a compaction overlap the entries merged already
+	const int32 NumNewNames = Delta.NameOffset + Delta.Names.Num() - NameEnd;
+	if (NumNewNames > 0)
+	{
+		Names.Append(Delta.Names.GetData() + Delta.Names.Num() - NumNewNames, NumNewNames);
+	}
+
+	const int32 NumNewGameIds = Delta.GameIdOffset + Delta.GameIds.Num() - GameIdEnd;
+	if (NumNewGameIds > 0)
+	{
+		GameIds.Append(Delta.GameIds.GetData() + Delta.GameIds.Num() - NumNewGameIds, NumNewGameIds);
+	}
+	DecodedNames.Reset();
+	return true;
+}
+
+void FOrionSaveNameTable::DecodeNames()
+{
+	DecodedNames.SetNum(Names.Num());
+	ParallelFor(Names.Num(), [this](const int32 i)
+	{
+		// Number 0: the string is the plain name, a "_N" suffix is part of it. Too long for an FName: read as string
+		DecodedNames[i] = Names[i].Len() < NAME_SIZE ? FName(*Names[i], NAME_NO_NUMBER_INTERNAL) : NAME_None;
+	});
+}
+
+int32 FOrionSaveNameTableBuilder::AddName(const FString& Name)
+{
+	if (const int32* Index = NameIndices.Find(Name))
+	{
+		return *Index;
+	}
+
+	const int32 Index = Names.Add(Name);
+	NameIndices.Add(Name, Index);
+	return Index;
+}
+
+int32 FOrionSaveNameTableBuilder::AddGameId(const FGuid& GameId)
+{
+	if (const int32* Index = GameIdIndices.Find(GameId))
+	{
+		return *Index;
+	}
+
+	const int32 Index = GameIds.Add(GameId);
+	GameIdIndices.Add(GameId, Index);
+	return Index;
+}
+
+void FOrionSaveNameTableBuilder::TakeNewEntries(FOrionSaveNameTable& OutTable)
+{
+	OutTable.NameOffset = NumTakenNames;
+	OutTable.Names = TArray<FString>(Names.GetData() + NumTakenNames, Names.Num() - NumTakenNames);
+	OutTable.GameIdOffset = NumTakenGameIds;
+	OutTable.GameIds = TArray<FGuid>(GameIds.GetData() + NumTakenGameIds, GameIds.Num() - NumTakenGameIds);
+
+	NumTakenNames = Names.Num();
+	NumTakenGameIds = GameIds.Num();
+}
+
+void FOrionSaveNameTableBuilder::Reset()
+{
+	NameIndices.Reset();
+	Names.Reset();
+	GameIdIndices.Reset();
+	GameIds.Reset();
+	NumTakenNames = 0;
+	NumTakenGameIds = 0;
+}
+
+FOrionNameTableArchive::FOrionNameTableArchive(FArchive& InInnerArchive, FOrionSaveNameTableBuilder& InBuilder)
+	: FArchiveProxy(InInnerArchive)
+	, Builder(&InBuilder)
+{
+	check(InInnerArchive.IsSaving());
+	ArIsSaveGame = true;
+}
+
+FOrionNameTableArchive::FOrionNameTableArchive(FArchive& InInnerArchive, TArray<FReference>& InReferences)
+	: FArchiveProxy(InInnerArchive)
+	, References(&InReferences)
+{
+	check(InInnerArchive.IsSaving());
+	ArIsSaveGame = true;
+}
+
+FOrionNameTableArchive::FOrionNameTableArchive(FArchive& InInnerArchive, const FOrionSaveNameTable& InTable,
+                                               FResolveGameId InResolveGameId)
+	: FArchiveProxy(InInnerArchive)
+	, Table(&InTable)
+	, ResolveGameId(MoveTemp(InResolveGameId))
+{
+	check(InInnerArchive.IsLoading());
+	ArIsSaveGame = true;
+}
+
+bool FOrionNameTableArchive::IsValidIndex(const int32 Index, const int32 Offset, const int32 Num)
+{
+	if (Index >= Offset && Index - Offset < Num)
+	{
+		return true;
+	}
+
+	// Record and table do not belong together
+	SetError();
+	return false;
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FName& Value)
+{
+	int32 Index = 0;
+	int32 Number = 0;
+
+	if (IsLoading())
+	{
+		InnerArchive << Index << Number;
+		Value = NAME_None;
+		if (IsValidIndex(Index, Table->NameOffset, Table->Names.Num()))
+		{
+			const int32 Entry = Index - Table->NameOffset;
+			const bool bDecoded = Table->DecodedNames.Num() == Table->Names.Num() && !Table->DecodedNames[Entry].IsNone();
+			Value = bDecoded ? FName(Table->DecodedNames[Entry], Number) : FName(*Table->Names[Entry], Number);
+		}
+	}
+	else
+	{
+		FReference Reference;
+		Reference.Name = Value;
+		WriteReference(MoveTemp(Reference));
+		Number = Value.GetNumber();
+		InnerArchive << Number;
+	}
+	return *this;
+}
+
+void FOrionNameTableArchive::SerializePath(FString& Path)
+{
+	int32 Index = 0;
+
+	if (IsLoading())
+	{
+		InnerArchive << Index;
+		Path = IsValidIndex(Index, Table->NameOffset, Table->Names.Num())
+			       ? Table->Names[Index - Table->NameOffset]
+			       : FString();
+	}
+	else
+	{
+		FReference Reference;
+		Reference.Kind = static_cast<uint8>(EReferenceKind::Path);
+		Reference.Path = Path;
+		WriteReference(MoveTemp(Reference));
+	}
+}
+
+void FOrionNameTableArchive::WriteReference(FReference&& Reference)
+{
+	int32 Index = INDEX_NONE;
+	if (References)
+	{
+		Reference.Offset = InnerArchive.Tell();
+		References->Add(MoveTemp(Reference));
+	}
+	else if (Reference.Kind == static_cast<uint8>(EReferenceKind::GameId))
+	{
+		Index = Builder->AddGameId(Reference.GameId);
+	}
+	else
+	{
+		Index = Builder->AddName(Reference.Kind == static_cast<uint8>(EReferenceKind::Path)
+			                         ? Reference.Path
+			                         : Reference.Name.GetPlainNameString());
+	}
+	InnerArchive << Index;
+}
+
+FArchive& FOrionNameTableArchive::operator<<(UObject*& Value)
+{
+	uint8 Kind = static_cast<uint8>(EReferenceKind::Null);
+
+	if (IsLoading())
+	{
+		InnerArchive << Kind;
+		Value = nullptr;
+
+		if (Kind == static_cast<uint8>(EReferenceKind::GameId))
+		{
+			int32 Index = 0;
+			InnerArchive << Index;
+			if (IsValidIndex(Index, Table->GameIdOffset, Table->GameIds.Num()) && ResolveGameId)
+			{
+				Value = ResolveGameId(Table->GameIds[Index - Table->GameIdOffset]);
+			}
+		}
+		else if (Kind == static_cast<uint8>(EReferenceKind::Path))
+		{
+			FString Path;
+			SerializePath(Path);
+			if (!Path.IsEmpty())
+			{
+				// 与 FObjectAndNameAsStringProxyArchive 相同：找不到就加载
+				Value = FindObject<UObject>(nullptr, *Path);
+				if (!Value)
+				{
+					Value = LoadObject<UObject>(nullptr, *Path);
+				}
+			}
+		}
+		return *this;
+	}
+
+	const IOrionInterfaceSerializable* Serializable = Cast<IOrionInterfaceSerializable>(Value);
+	const FGuid GameId = Serializable ? Serializable->GetSerializable().GameId : FGuid();
+
+	if (!Value)
+	{
+		InnerArchive << Kind;
+	}
+	else if (GameId.IsValid())
+	{
+		Kind = static_cast<uint8>(EReferenceKind::GameId);
+		InnerArchive << Kind;
+
+		FReference Reference;
+		Reference.Kind = Kind;
+		Reference.GameId = GameId;
+		WriteReference(MoveTemp(Reference));
+	}
+	else
+	{
+		Kind = static_cast<uint8>(EReferenceKind::Path);
+		FString Path = Value->GetPathName();
+		InnerArchive << Kind;
+		SerializePath(Path);
+	}
+	return *this;
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeObjectPtr(*this, Value);
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FWeakObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeWeakObjectPtr(*this, Value);
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FLazyObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeLazyObjectPtr(*this, Value);
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FSoftObjectPath& Value)
+{
+	FString Path = IsSaving() ? Value.ToString() : FString();
+	SerializePath(Path);
+	if (IsLoading())
+	{
+		Value.SetPath(Path);
+	}
+	return *this;
+}
+
+FArchive& FOrionNameTableArchive::operator<<(FSoftObjectPtr& Value)
+{
+	FSoftObjectPath Path = IsSaving() ? Value.ToSoftObjectPath() : FSoftObjectPath();
+	*this << Path;
+	if (IsLoading())
+	{
+		Value = FSoftObjectPtr(Path);
+	}
+	return *this;
+}
+
+void FOrionNameTableArchive::WriteObject(UObject& Object, FOrionSaveNameTableBuilder& Builder, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	FOrionNameTableArchive Ar(Writer, Builder);
+	Object.Serialize(Ar);
+}
+
+void FOrionNameTableArchive::SnapshotObject(UObject& Object, FRecordSnapshot& OutSnapshot)
+{
+	check(IsInGameThread());
+
+	OutSnapshot.Bytes.Reset();
+	OutSnapshot.References.Reset();
+	FMemoryWriter Writer(OutSnapshot.Bytes);
+	FOrionNameTableArchive Ar(Writer, OutSnapshot.References);
+	Object.Serialize(Ar);
+}
+
+void FOrionNameTableArchive::EncodeSnapshots(const TArrayView<FRecordSnapshot> Snapshots,
+                                             FOrionSaveNameTableBuilder& Builder, TArray<TArray<uint8>>& OutBytes,
+                                             const bool bParallel)
+{
+	OutBytes.SetNum(Snapshots.Num());
+
+	/* ① Workers: the references of each record against its own table (strings only, no UObject) */
+	TArray<FOrionSaveNameTableBuilder> LocalBuilders;
+	LocalBuilders.SetNum(Snapshots.Num());
+
+	ParallelFor(Snapshots.Num(), [&](const int32 i)
+	{
+		OutBytes[i] = MoveTemp(Snapshots[i].Bytes);
+		uint8* Data = OutBytes[i].GetData();
+		for (const FReference& Reference : Snapshots[i].References)
+		{
+			const int32 Index = Reference.Kind == static_cast<uint8>(EReferenceKind::GameId)
+				                    ? LocalBuilders[i].AddGameId(Reference.GameId)
+				                    : LocalBuilders[i].AddName(
+					                    Reference.Kind == static_cast<uint8>(EReferenceKind::Path)
+						                    ? Reference.Path
+						                    : Reference.Name.GetPlainNameString());
+			FMemory::Memcpy(Data + Reference.Offset, &Index, sizeof(Index));
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	/*
+	 * ② In record order. Local entries are numbered by first use, so adding them in index order adds to Builder
+	 * what the Add calls of a serial write would, in the same order
+	 */
+	TArray<int32> NameMap;
+	TArray<int32> GameIdMap;
+	for (int32 i = 0; i < Snapshots.Num(); ++i)
+	{
+		NameMap.Reset();
+		for (const FString& Name : LocalBuilders[i].GetNames())
+		{
+			NameMap.Add(Builder.AddName(Name));
+		}
+		GameIdMap.Reset();
+		for (const FGuid& GameId : LocalBuilders[i].GetGameIds())
+		{
+			GameIdMap.Add(Builder.AddGameId(GameId));
+		}
+
+		uint8* Data = OutBytes[i].GetData();
+		for (const FReference& Reference : Snapshots[i].References)
+		{
+			int32 Index = 0;
+			FMemory::Memcpy(&Index, Data + Reference.Offset, sizeof(Index));
+			Index = Reference.Kind == static_cast<uint8>(EReferenceKind::GameId) ? GameIdMap[Index] : NameMap[Index];
+			FMemory::Memcpy(Data + Reference.Offset, &Index, sizeof(Index));
+		}
+	}
+}
+
+void FOrionNameTableArchive::WriteObjects(const TConstArrayView<UObject*> Objects, FOrionSaveNameTableBuilder& Builder,
+                                          TArray<TArray<uint8>>& OutBytes, const bool bParallel)
+{
+	TArray<FRecordSnapshot> Snapshots;
+	Snapshots.SetNum(Objects.Num());
+	for (int32 i = 0; i < Objects.Num(); ++i)
+	{
+		SnapshotObject(*Objects[i], Snapshots[i]);
+	}
+
+	EncodeSnapshots(Snapshots, Builder, OutBytes, bParallel);
+}
+
+void FOrionNameTableArchive::ReadObject(UObject& Object, const TArray<uint8>& Bytes, const bool bUsesNameTable,
+                                        const FOrionSaveNameTable& Table, const FResolveGameId& ResolveGameId)
+{
+	FMemoryReader Reader(Bytes);
+
+	if (bUsesNameTable)
+	{
+		FOrionNameTableArchive Ar(Reader, Table, ResolveGameId);
+		Object.Serialize(Ar);
+		if (Ar.IsError())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Save] %s: record does not match the name table of the save"),
+			       *Object.GetName());
+		}
+		return;
+	}
+
+	FObjectAndNameAsStringProxyArchive Ar(Reader, /*bLoadIn=*/true);
+	Ar.ArIsSaveGame = true;
+	Object.Serialize(Ar);
+}
+
+void FOrionNameTableArchive::ResetSaveGameProperties(UObject& Object)
+{
+	const UObject* Archetype = Object.GetArchetype();
+	check(Archetype);
+
+	for (TFieldIterator<FProperty> It(Object.GetClass()); It; ++It)
+	{
+		// Instanced subobjects belong to their owner, the archetype's ones must not be shared
+		if (It->HasAnyPropertyFlags(CPF_SaveGame) &&
+			!It->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+		{
+			It->CopyCompleteValue_InContainer(&Object, Archetype);
+		}
+	}
+}
+
+void FOrionNameTableArchive::Benchmark(const TConstArrayView<UObject*> Objects, const FResolveGameId& ResolveGameId,
+                                       const int32 Iterations)
+{
+	if (Objects.Num() == 0 || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Save] Archive benchmark: no objects to serialize."));
+		return;
+	}
+
+	TArray<TArray<uint8>> StringRecords;
+	TArray<TArray<uint8>> TableRecords;
+	StringRecords.SetNum(Objects.Num());
+	TableRecords.SetNum(Objects.Num());
+
+	FOrionSaveNameTableBuilder Builder;
+	FOrionSaveNameTable Table;
+
+	double StringSaveSeconds = 0.0;
+	double TableSaveSeconds = 0.0;
+	double StringLoadSeconds = 0.0;
+	double TableLoadSeconds = 0.0;
+
+	/* ① Save */
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			StringRecords[i].Reset();
+			FMemoryWriter Writer(StringRecords[i]);
+			FObjectAndNameAsStringProxyArchive Ar(Writer, /*bLoadIn=*/false);
+			Ar.ArIsSaveGame = true;
+			Objects[i]->Serialize(Ar);
+		}
+		StringSaveSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		Builder.Reset();
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			WriteObject(*Objects[i], Builder, TableRecords[i]);
+		}
+		Builder.TakeNewEntries(Table);
+		TableSaveSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	/* ② Load: the same values are written back into the objects */
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			ReadObject(*Objects[i], StringRecords[i], /*bUsesNameTable=*/false, Table, ResolveGameId);
+		}
+		StringLoadSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			ReadObject(*Objects[i], TableRecords[i], /*bUsesNameTable=*/true, Table, ResolveGameId);
+		}
+		TableLoadSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	/* ③ Sizes: the table is stored once per save, as its own section */
+	int64 StringBytes = 0;
+	int64 TableRecordBytes = 0;
+	for (int32 i = 0; i < Objects.Num(); ++i)
+	{
+		StringBytes += StringRecords[i].Num();
+		TableRecordBytes += TableRecords[i].Num();
+	}
+
+	TArray<uint8> TableBytes;
+	{
+		FMemoryWriter Writer(TableBytes);
+		FObjectAndNameAsStringProxyArchive Ar(Writer, /*bLoadIn=*/false);
+		Ar.ArIsSaveGame = true;
+		FOrionSaveNameTable::StaticStruct()->SerializeItem(Ar, &Table, nullptr);
+	}
+
+	/* ④ Parallel encoding (identical output: see Orion.Save.NameTable.ParallelEncoding) */
+	double SerialSaveSeconds = 0.0;
+	double ParallelSaveSeconds = 0.0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FOrionSaveNameTableBuilder SerialBuilder;
+		TArray<TArray<uint8>> SerialRecords;
+		double StartTime = FPlatformTime::Seconds();
+		WriteObjects(Objects, SerialBuilder, SerialRecords, /*bParallel=*/false);
+		SerialSaveSeconds += FPlatformTime::Seconds() - StartTime;
+
+		FOrionSaveNameTableBuilder ParallelBuilder;
+		TArray<TArray<uint8>> ParallelRecords;
+		StartTime = FPlatformTime::Seconds();
+		WriteObjects(Objects, ParallelBuilder, ParallelRecords, /*bParallel=*/true);
+		ParallelSaveSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	const double ToMs = 1000.0 / Iterations;
+	UE_LOG(LogTemp, Log, TEXT("[Save] Archive benchmark, %d objects x %d iterations:"), Objects.Num(), Iterations);
+	UE_LOG(LogTemp, Log, TEXT("[Save]   Name as string: %lld bytes, save %.3f ms, load %.3f ms"),
+	       StringBytes, StringSaveSeconds * ToMs, StringLoadSeconds * ToMs);
+	UE_LOG(LogTemp, Log,
+	       TEXT("[Save]   Name table:     %lld bytes (records %lld + table %d, %d names, %d GameIds), save %.3f ms, load %.3f ms"),
+	       TableRecordBytes + TableBytes.Num(), TableRecordBytes, TableBytes.Num(), Table.Names.Num(),
+	       Table.GameIds.Num(), TableSaveSeconds * ToMs, TableLoadSeconds * ToMs);
+	UE_LOG(LogTemp, Log, TEXT("[Save]   Name table save, serial %.3f ms, parallel %.3f ms"),
+	       SerialSaveSeconds * ToMs, ParallelSaveSeconds * ToMs);
+}
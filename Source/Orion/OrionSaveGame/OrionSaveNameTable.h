@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/ArchiveProxy.h"
+#include "OrionSaveNameTable.generated.h"
+
+/**
+ * Names, object paths and GameIds referenced by the SerializedBytes of the records of one save file, each stored
+ * once (see FOrionNameTableArchive).
+ */
+USTRUCT()
+struct FOrionSaveNameTable
+{
+	GENERATED_BODY()
+
+	/** Index of Names[0] in the whole table: delta autosave chunks only carry the entries they appended */
+	UPROPERTY(SaveGame)
+	int32 NameOffset = 0;
+
+	/** FName plain strings and object paths */
+	UPROPERTY(SaveGame)
+	TArray<FString> Names;
+
+	/** Index of GameIds[0] in the whole table */
+	UPROPERTY(SaveGame)
+	int32 GameIdOffset = 0;
+
+	/** Referenced serializable objects */
+	UPROPERTY(SaveGame)
+	TArray<FGuid> GameIds;
+
+	/** FName of each entry of Names, made by DecodeNames before a load (not saved) */
+	TArray<FName> DecodedNames;
+
+	void Reset()
+	{
+		NameOffset = 0;
+		Names.Reset();
+		GameIdOffset = 0;
+		GameIds.Reset();
+		DecodedNames.Reset();
+	}
+
+	/* Appends the entries of a delta chunk, false if entries between this table and the chunk are missing */
+	bool Append(const FOrionSaveNameTable& Delta);
+
+	/* Names to FNames on worker threads, so that the records read on the game thread only copy them */
+	void DecodeNames();
+};
+
+/* Write side of the table: deduplicates, and keeps growing across a base snapshot and its delta chunks */
+class ORION_API FOrionSaveNameTableBuilder
+{
+public:
+	int32 AddName(const FString& Name);
+	int32 AddGameId(const FGuid& GameId);
+
+	/* Entries added since the previous call (all of them the first time) */
+	void TakeNewEntries(FOrionSaveNameTable& OutTable);
+
+	void Reset();
+
+	const TArray<FString>& GetNames() const { return Names; }
+	const TArray<FGuid>& GetGameIds() const { return GameIds; }
+
+private:
+	TMap<FString, int32> NameIndices;
+	TArray<FString> Names;
+	TMap<FGuid, int32> GameIdIndices;
+	TArray<FGuid> GameIds;
+
+	int32 NumTakenNames = 0;
+	int32 NumTakenGameIds = 0;
+};
+
+/**
+ * SaveGame archive for the SerializedBytes of characters and actors.
+ *
+ * FObjectAndNameAsStringProxyArchive writes every FName and object reference as a full string, so the same class
+ * paths and property names are repeated in every record. This archive writes an FName as an index into the name
+ * table of the save (+ number), a reference to a serializable object (actor / character) as an index into its
+ * GameId table, and any other object (assets, classes) as the index of its path.
+ *
+ * GameId references are resolved on load through ResolveGameId: objects that are not spawned (yet) load as null.
+ */
+class ORION_API FOrionNameTableArchive : public FArchiveProxy
+{
+public:
+	using FResolveGameId = TFunction<UObject*(const FGuid&)>;
+
+	/* Name, path or GameId met while snapshotting a record, turned into a table index by EncodeSnapshots */
+	struct FReference
+	{
+		int64 Offset = 0; // Of the index placeholder in the record bytes
+		FName Name;
+		FString Path;
+		FGuid GameId;
+		uint8 Kind = 0; // EReferenceKind, Null: FName
+	};
+
+	/* SaveGame properties of one object with the table indices left open: plain data, no UObject access needed */
+	struct FRecordSnapshot
+	{
+		TArray<uint8> Bytes;
+		TArray<FReference> References;
+	};
+
+	/* Saving */
+	FOrionNameTableArchive(FArchive& InInnerArchive, FOrionSaveNameTableBuilder& InBuilder);
+
+	/* Loading */
+	FOrionNameTableArchive(FArchive& InInnerArchive, const FOrionSaveNameTable& InTable,
+	                       FResolveGameId InResolveGameId);
+
+	virtual FArchive& operator<<(FName& Value) override;
+	virtual FArchive& operator<<(UObject*& Value) override;
+	virtual FArchive& operator<<(FObjectPtr& Value) override;
+	virtual FArchive& operator<<(FWeakObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPath& Value) override;
+	virtual FArchive& operator<<(FLazyObjectPtr& Value) override;
+
+	virtual FString GetArchiveName() const override { return TEXT("FOrionNameTableArchive"); }
+
+	/* SaveGame properties of Object */
+	static void WriteObject(UObject& Object, FOrionSaveNameTableBuilder& Builder, TArray<uint8>& OutBytes);
+
+	/* Game thread: serializes Object with every name / reference kept aside (strings, GameIds resolved here) */
+	static void SnapshotObject(UObject& Object, FRecordSnapshot& OutSnapshot);
+
+	/*
+	 * Table indices of every snapshot (bytes are moved out of them), resolved on worker threads against a table of
+	 * each record, then merged into Builder in record order. Builder and OutBytes are byte identical to the ones of
+	 * a WriteObject loop over the same objects, in parallel or not
+	 */
+	static void EncodeSnapshots(TArrayView<FRecordSnapshot> Snapshots, FOrionSaveNameTableBuilder& Builder,
+	                            TArray<TArray<uint8>>& OutBytes, bool bParallel = true);
+
+	/* SnapshotObject of every object on the game thread, then EncodeSnapshots */
+	static void WriteObjects(TConstArrayView<UObject*> Objects, FOrionSaveNameTableBuilder& Builder,
+	                         TArray<TArray<uint8>>& OutBytes, bool bParallel = true);
+
+	/* Reads bytes written by WriteObject, or by FObjectAndNameAsStringProxyArchive if !bUsesNameTable (old saves) */
+	static void ReadObject(UObject& Object, const TArray<uint8>& Bytes, bool bUsesNameTable,
+	                       const FOrionSaveNameTable& Table, const FResolveGameId& ResolveGameId);
+
+	/*
+	 * SaveGame properties of Object back to the values of its archetype, before ReadObject into an object that
+	 * already lives (tagged serialization skips the values equal to the defaults)
+	 */
+	static void ResetSaveGameProperties(UObject& Object);
+
+	/*
+	 * Sizes and save / load times of both formats for the given objects, in the log. Loads write the same values back.
+	 * Also times WriteObjects in serial and in parallel
+	 */
+	static void Benchmark(TConstArrayView<UObject*> Objects, const FResolveGameId& ResolveGameId, int32 Iterations);
+
+private:
+	enum class EReferenceKind : uint8
+	{
+		Null = 0,
+		GameId = 1,
+		Path = 2,
+	};
+
+	/* Snapshotting */
+	FOrionNameTableArchive(FArchive& InInnerArchive, TArray<FReference>& InReferences);
+
+	void SerializePath(FString& Path);
+	/* Table index of a name / path / GameId, or a placeholder + reference while snapshotting */
+	void WriteReference(FReference&& Reference);
+	bool IsValidIndex(int32 Index, int32 Offset, int32 Num);
+
+	FOrionSaveNameTableBuilder* Builder = nullptr;
+	TArray<FReference>* References = nullptr;
+	const FOrionSaveNameTable* Table = nullptr;
+	FResolveGameId ResolveGameId;
+};
@@ -0,0 +1,555 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionSaveGame/OrionStructureJson.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "HAL/FileManager.h"
+
+/* ====================================================
+ *                  Writer
+ * ====================================================*/
+FOrionStructureJsonWriter::FOrionStructureJsonWriter(FArchive& InAr)
+	: Ar(InAr)
+{
+	check(Ar.IsSaving());
+	Buffer.Reserve(BufferSize);
+	Append(TEXT("[\n"));
+}
+
+FOrionStructureJsonWriter::~FOrionStructureJsonWriter()
+{
+	Close();
+}
+
+void FOrionStructureJsonWriter::Append(const TCHAR* Text)
+{
+	const FTCHARToUTF8 Utf8(Text);
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+	int32 Remaining = Utf8.Length();
+
+	while (Remaining > 0)
+	{
+		if (Buffer.Num() == BufferSize)
+		{
+			Flush();
+		}
+		const int32 Count = FMath::Min(Remaining, BufferSize - Buffer.Num());
+		Buffer.Append(Data, Count);
+		Data += Count;
+		Remaining -= Count;
+	}
+}
+
+void FOrionStructureJsonWriter::AppendEscaped(const FString& Text)
+{
+	// Class paths never need it, any other string stays valid JSON
+	int32 Start = 0;
+	for (int32 i = 0; i < Text.Len(); ++i)
+	{
+		const TCHAR Char = Text[i];
+		if (Char != TEXT('"') && Char != TEXT('\\') && Char >= 0x20)
+		{
+			continue;
+		}
+
+		Append(*Text.Mid(Start, i - Start));
+
+		TCHAR Escaped[8];
+		FCString::Snprintf(Escaped, UE_ARRAY_COUNT(Escaped), TEXT("\\u%04x"), static_cast<uint32>(Char));
+		Append(Char == TEXT('"') ? TEXT("\\\"") : Char == TEXT('\\') ? TEXT("\\\\") : Escaped);
+		Start = i + 1;
+	}
+
+	Append(Start == 0 ? *Text : *Text.Mid(Start));
+}
+
+void FOrionStructureJsonWriter::Write(const FOrionStructureRecord& Record)
+{
+	check(!bClosed);
+
+	// Decompose Transform
+	const FVector Loc = Record.Transform.GetLocation();
+	const FRotator Rot = Record.Transform.GetRotation().Rotator();
+	const FVector Scale = Record.Transform.GetScale3D();
+
+	// The comma of the previous record
+	Append(NumRecords > 0 ? TEXT(",\n  {\n") : TEXT("  {\n"));
+
+	Append(TEXT("    \"ClassPath\": \""));
+	AppendEscaped(Record.ClassPath);
+	Append(TEXT("\",\n"));
+
+	TCHAR Line[256];
+
+	Append(TEXT("    \"Translation\": {\n"));
+	FCString::Snprintf(Line, UE_ARRAY_COUNT(Line), TEXT("      \"X\": %.6f, \"Y\": %.6f, \"Z\": %.6f\n"),
+	                   Loc.X, Loc.Y, Loc.Z);
+	Append(Line);
+	Append(TEXT("    },\n"));
+
+	Append(TEXT("    \"Rotation\": {\n"));
+	FCString::Snprintf(Line, UE_ARRAY_COUNT(Line), TEXT("      \"Pitch\": %.6f, \"Yaw\": %.6f, \"Roll\": %.6f\n"),
+	                   Rot.Pitch, Rot.Yaw, Rot.Roll);
+	Append(Line);
+	Append(TEXT("    },\n"));
+
+	Append(TEXT("    \"Scale\": {\n"));
+	FCString::Snprintf(Line, UE_ARRAY_COUNT(Line), TEXT("      \"X\": %.6f, \"Y\": %.6f, \"Z\": %.6f\n"),
+	                   Scale.X, Scale.Y, Scale.Z);
+	Append(Line);
+	Append(TEXT("    }\n"));
+
+	Append(TEXT("  }"));
+	++NumRecords;
+}
+
+void FOrionStructureJsonWriter::Close()
+{
+	if (bClosed)
+	{
+		return;
+	}
+	bClosed = true;
+
+	Append(NumRecords > 0 ? TEXT("\n]\n") : TEXT("]\n"));
+	Flush();
+}
+
+void FOrionStructureJsonWriter::Flush()
+{
+	if (Buffer.Num() > 0)
+	{
+		Ar.Serialize(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
+
+/* ====================================================
+ *                  Reader
+ * ====================================================*/
+FOrionStructureJsonReader::FOrionStructureJsonReader(FArchive& InAr)
+	: Ar(InAr)
+{
+	check(Ar.IsLoading());
+	Buffer.SetNumUninitialized(BufferSize);
+}
+
+bool FOrionStructureJsonReader::Fail()
+{
+	bError = true;
+	return false;
+}
+
+bool FOrionStructureJsonReader::Peek(ANSICHAR& OutChar)
+{
+	if (BufferPos == BufferEnd)
+	{
+		const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+		if (Remaining <= 0 || Ar.IsError())
+		{
+			return false;
+		}
+
+		BufferEnd = static_cast<int32>(FMath::Min<int64>(Remaining, BufferSize));
+		BufferPos = 0;
+		Ar.Serialize(Buffer.GetData(), BufferEnd);
+	}
+
+	OutChar = static_cast<ANSICHAR>(Buffer[BufferPos]);
+	return true;
+}
+
+bool FOrionStructureJsonReader::Get(ANSICHAR& OutChar)
+{
+	if (!Peek(OutChar))
+	{
+		return false;
+	}
+	++BufferPos;
+	return true;
+}
+
+void FOrionStructureJsonReader::SkipWhitespace()
+{
+	ANSICHAR Char;
+	while (Peek(Char) && (Char == ' ' || Char == '\n' || Char == '\r' || Char == '\t'))
+	{
+		++BufferPos;
+	}
+}
+
+bool FOrionStructureJsonReader::Expect(const ANSICHAR Char)
+{
+	SkipWhitespace();
+	ANSICHAR Read;
+	return (Get(Read) && Read == Char) ? true : Fail();
+}
+
+bool FOrionStructureJsonReader::ReadString()
+{
+	Scratch.Reset();
+	if (!Expect('"'))
+	{
+		return false;
+	}
+
+	ANSICHAR Char;
+	while (Get(Char))
+	{
+		if (Char == '"')
+		{
+			return true;
+		}
+		if (Char != '\\')
+		{
+			Scratch.Add(Char);
+			continue;
+		}
+
+		if (!Get(Char))
+		{
+			break;
+		}
+		switch (Char)
+		{
+		case 'b': Scratch.Add('\b');
+			break;
+		case 'f': Scratch.Add('\f');
+			break;
+		case 'n': Scratch.Add('\n');
+			break;
+		case 'r': Scratch.Add('\r');
+			break;
+		case 't': Scratch.Add('\t');
+			break;
+		case 'u':
+			{
+				ANSICHAR Hex[5] = {};
+				for (int32 i = 0; i < 4; ++i)
+				{
+					if (!Get(Hex[i]) || !FChar::IsHexDigit(Hex[i]))
+					{
+						return Fail();
+					}
+				}
+				// Code point back to UTF-8
+				const TCHAR CodeUnit[2] = {static_cast<TCHAR>(FCStringAnsi::Strtoi(Hex, nullptr, 16)), 0};
+				const FTCHARToUTF8 Utf8(CodeUnit);
+				Scratch.Append(reinterpret_cast<const ANSICHAR*>(Utf8.Get()), Utf8.Length());
+				break;
+			}
+		default: Scratch.Add(Char); // " \ /
+			break;
+		}
+	}
+	return Fail();
+}
+
+bool FOrionStructureJsonReader::ScratchEquals(const ANSICHAR* Text) const
+{
+	const int32 Length = FCStringAnsi::Strlen(Text);
+	return Scratch.Num() == Length && FMemory::Memcmp(Scratch.GetData(), Text, Length) == 0;
+}
+
+FString FOrionStructureJsonReader::ScratchToString() const
+{
+	const FUTF8ToTCHAR Text(Scratch.GetData(), Scratch.Num());
+	return FString(Text.Length(), Text.Get());
+}
+
+bool FOrionStructureJsonReader::ReadNumber(double& OutValue)
+{
+	SkipWhitespace();
+
+	ANSICHAR Number[64];
+	int32 Length = 0;
+	ANSICHAR Char;
+	while (Peek(Char) && (FChar::IsDigit(Char) || Char == '-' || Char == '+' || Char == '.' || Char == 'e' ||
+		Char == 'E'))
+	{
+		if (Length == static_cast<int32>(UE_ARRAY_COUNT(Number)) - 1)
+		{
+			return Fail();
+		}
+		Number[Length++] = Char;
+		++BufferPos;
+	}
+
+	if (Length == 0)
+	{
+		return Fail();
+	}
+	Number[Length] = 0;
+	OutValue = FCStringAnsi::Atod(Number);
+	return true;
+}
+
+bool FOrionStructureJsonReader::ReadVector(const ANSICHAR* const (&Keys)[3], FVector& OutVector)
+{
+	if (!Expect('{'))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	ANSICHAR Char;
+	if (Peek(Char) && Char == '}')
+	{
+		++BufferPos;
+		return true;
+	}
+
+	while (!bError)
+	{
+		if (!ReadString() || !Expect(':'))
+		{
+			return false;
+		}
+
+		int32 Axis = INDEX_NONE;
+		for (int32 i = 0; i < 3; ++i)
+		{
+			if (ScratchEquals(Keys[i]))
+			{
+				Axis = i;
+			}
+		}
+
+		if (Axis == INDEX_NONE)
+		{
+			if (!SkipValue())
+			{
+				return false;
+			}
+		}
+		else if (!ReadNumber(OutVector[Axis]))
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (!Get(Char))
+		{
+			return Fail();
+		}
+		if (Char == '}')
+		{
+			return true;
+		}
+		if (Char != ',')
+		{
+			return Fail();
+		}
+	}
+	return false;
+}
+
+bool FOrionStructureJsonReader::SkipValue(const int32 Depth)
+{
+	if (Depth > 32)
+	{
+		return Fail();
+	}
+
+	SkipWhitespace();
+	ANSICHAR Char;
+	if (!Peek(Char))
+	{
+		return Fail();
+	}
+
+	if (Char == '"')
+	{
+		return ReadString();
+	}
+
+	if (Char == '{' || Char == '[')
+	{
+		const ANSICHAR Close = Char == '{' ? '}' : ']';
+		++BufferPos;
+
+		SkipWhitespace();
+		if (Peek(Char) && Char == Close)
+		{
+			++BufferPos;
+			return true;
+		}
+
+		while (!bError)
+		{
+			if (Close == '}' && (!ReadString() || !Expect(':')))
+			{
+				return false;
+			}
+			if (!SkipValue(Depth + 1))
+			{
+				return false;
+			}
+
+			SkipWhitespace();
+			if (!Get(Char))
+			{
+				return Fail();
+			}
+			if (Char == Close)
+			{
+				return true;
+			}
+			if (Char != ',')
+			{
+				return Fail();
+			}
+		}
+		return false;
+	}
+
+	// Number or true / false / null
+	int32 Length = 0;
+	while (Peek(Char) && (FChar::IsAlnum(Char) || Char == '-' || Char == '+' || Char == '.'))
+	{
+		++BufferPos;
+		++Length;
+	}
+	return Length > 0 ? true : Fail();
+}
+
+bool FOrionStructureJsonReader::ReadRecord(FOrionStructureRecord& OutRecord)
+{
+	static const ANSICHAR* const PositionKeys[3] = {"X", "Y", "Z"};
+	static const ANSICHAR* const RotationKeys[3] = {"Pitch", "Yaw", "Roll"};
+
+	FVector Translation = FVector::ZeroVector;
+	FVector Rotation = FVector::ZeroVector;
+	FVector Scale = FVector::OneVector;
+	OutRecord.ClassPath.Reset();
+
+	if (!Expect('{'))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	ANSICHAR Char;
+	if (Peek(Char) && Char == '}')
+	{
+		++BufferPos;
+	}
+	else
+	{
+		while (true)
+		{
+			if (!ReadString() || !Expect(':'))
+			{
+				return false;
+			}
+
+			bool bRead;
+			if (ScratchEquals("ClassPath"))
+			{
+				bRead = ReadString();
+				OutRecord.ClassPath = ScratchToString();
+			}
+			else if (ScratchEquals("Translation"))
+			{
+				bRead = ReadVector(PositionKeys, Translation);
+			}
+			else if (ScratchEquals("Rotation"))
+			{
+				bRead = ReadVector(RotationKeys, Rotation);
+			}
+			else if (ScratchEquals("Scale"))
+			{
+				bRead = ReadVector(PositionKeys, Scale);
+			}
+			else
+			{
+				bRead = SkipValue();
+			}
+			if (!bRead)
+			{
+				return false;
+			}
+
+			SkipWhitespace();
+			if (!Get(Char))
+			{
+				return Fail();
+			}
+			if (Char == '}')
+			{
+				break;
+			}
+			if (Char != ',')
+			{
+				return Fail();
+			}
+		}
+	}
+
+	OutRecord.Transform = FTransform(FRotator(Rotation.X, Rotation.Y, Rotation.Z), Translation, Scale);
+	return true;
+}
+
+bool FOrionStructureJsonReader::Next(FOrionStructureRecord& OutRecord)
+{
+	if (bFinished || bError)
+	{
+		return false;
+	}
+
+	ANSICHAR Char;
+	if (!bStarted)
+	{
+		bStarted = true;
+		if (!Expect('['))
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Peek(Char) && Char == ']')
+		{
+			++BufferPos;
+			bFinished = true;
+			return false;
+		}
+	}
+	else
+	{
+		SkipWhitespace();
+		if (!Get(Char))
+		{
+			return Fail();
+		}
+		if (Char == ']')
+		{
+			bFinished = true;
+			return false;
+		}
+		if (Char != ',')
+		{
+			return Fail();
+		}
+	}
+
+	return ReadRecord(OutRecord);
+}
+
+bool FOrionStructureJsonReader::ReadFile(const FString& Path, TArray<FOrionStructureRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Path));
+	if (!FileReader)
+	{
+		return false;
+	}
+
+	FOrionStructureJsonReader Reader(*FileReader);
+	FOrionStructureRecord Record;
+	while (Reader.Next(Record))
+	{
+		OutRecords.Add(MoveTemp(Record));
+	}
+	return !Reader.IsError();
+}
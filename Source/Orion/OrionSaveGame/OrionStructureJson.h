@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOrionStructureRecord;
+
+/**
+ * Streaming writer of the structure record JSON (Saved/structure_records.json, read by Scripts/BuildingAnalysis.py):
+ *
+ *   [ { "ClassPath": "...", "Translation": {X, Y, Z}, "Rotation": {Pitch, Yaw, Roll}, "Scale": {X, Y, Z} }, ... ]
+ *
+ * Records are formatted one at a time into a fixed-size UTF-8 buffer that is flushed to the archive when full, so an
+ * export takes constant memory and linear time. The output is byte for byte the one of the former FString builder.
+ */
+class ORION_API FOrionStructureJsonWriter
+{
+public:
+	static constexpr int32 BufferSize = 64 * 1024;
+
+	explicit FOrionStructureJsonWriter(FArchive& InAr);
+	~FOrionStructureJsonWriter();
+
+	void Write(const FOrionStructureRecord& Record);
+
+	/* Closes the array and flushes, called by the destructor if needed */
+	void Close();
+
+private:
+	void Append(const TCHAR* Text);
+	void AppendEscaped(const FString& Text);
+	void Flush();
+
+	FArchive& Ar;
+	TArray<uint8> Buffer;
+	int32 NumRecords = 0;
+	bool bClosed = false;
+};
+
+/**
+ * Pull parser for the same JSON: Next() reads one record at a time from the archive through a fixed-size buffer.
+ * Keys may come in any order, unknown keys are skipped, a missing Scale is (1, 1, 1).
+ */
+class ORION_API FOrionStructureJsonReader
+{
+public:
+	static constexpr int32 BufferSize = 64 * 1024;
+
+	explicit FOrionStructureJsonReader(FArchive& InAr);
+
+	/* False at the end of the array, or on a syntax error (IsError) */
+	bool Next(FOrionStructureRecord& OutRecord);
+
+	bool IsError() const { return bError; }
+
+	/* Whole file, false if it cannot be opened or parsed */
+	static bool ReadFile(const FString& Path, TArray<FOrionStructureRecord>& OutRecords);
+
+private:
+	bool Peek(ANSICHAR& OutChar);
+	bool Get(ANSICHAR& OutChar);
+	bool Expect(ANSICHAR Char);
+	void SkipWhitespace();
+
+	/* String into Scratch (UTF-8, escapes resolved) */
+	bool ReadString();
+	bool ScratchEquals(const ANSICHAR* Text) const;
+	FString ScratchToString() const;
+
+	bool ReadNumber(double& OutValue);
+	bool ReadRecord(FOrionStructureRecord& OutRecord);
+
+	/* Object of numbers, Keys[i] goes into OutVector[i] */
+	bool ReadVector(const ANSICHAR* const (&Keys)[3], FVector& OutVector);
+
+	bool SkipValue(int32 Depth = 0);
+
+	bool Fail();
+
+	FArchive& Ar;
+	TArray<uint8> Buffer;
+	int32 BufferPos = 0;
+	int32 BufferEnd = 0;
+	TArray<ANSICHAR> Scratch;
+
+	bool bStarted = false;
+	bool bFinished = false;
+	bool bError = false;
+};
@@ -0,0 +1,305 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Orion/OrionSaveGame/OrionStructureRecordCodec.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+
+namespace
+{
+	enum class ERecordMode : uint8
+	{
+		Quantized = 0,
+		FullPrecision = 1,
+	};
+
+	uint64 ZigZag(const int64 Value)
+	{
+		return (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+	}
+
+	int64 UnZigZag(const uint64 Value)
+	{
+		return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+	}
+
+	constexpr double AngleTolerance = 0.01; // Degrees
+}
+
+bool FOrionStructureRecordCodec::TryQuantize(const FTransform& Transform, FQuantized& Out)
+{
+	const FRotator Rotation = Transform.Rotator();
+	if (!FMath::IsNearlyZero(Rotation.Pitch, AngleTolerance) || !FMath::IsNearlyZero(Rotation.Roll, AngleTolerance))
+	{
+		return false;
+	}
+
+	const double YawInSteps = FRotator::ClampAxis(Rotation.Yaw) * YawSteps / 360.0;
+	const int64 Yaw = FMath::RoundToInt64(YawInSteps);
+	if (FMath::Abs(YawInSteps - Yaw) * 360.0 / YawSteps > AngleTolerance)
+	{
+		return false;
+	}
+	Out.Yaw = static_cast<uint32>(Yaw % YawSteps);
+
+	const FVector Location = Transform.GetLocation();
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const double Steps = Location[Axis] / PositionStep;
+		if (FMath::Abs(Steps) > MAX_int32)
+		{
+			return false;
+		}
+		Out.Position[Axis] = FMath::RoundToInt64(Steps);
+	}
+	return true;
+}
+
+FTransform FOrionStructureRecordCodec::Dequantize(const FQuantized& Quantized, const FVector& Scale)
+{
+	const FVector Location(Quantized.Position[0] * PositionStep,
+	                       Quantized.Position[1] * PositionStep,
+	                       Quantized.Position[2] * PositionStep);
+	return FTransform(FRotator(0.0, Quantized.Yaw * 360.0 / YawSteps, 0.0), Location, Scale);
+}
+
+FTransform FOrionStructureRecordCodec::Snap(const FTransform& Transform)
+{
+	FQuantized Quantized;
+	return TryQuantize(Transform, Quantized) ? Dequantize(Quantized, Transform.GetScale3D()) : Transform;
+}
+
+bool FOrionStructureRecordCodec::IsQuantizable(const FTransform& Transform)
+{
+	FQuantized Quantized;
+	return TryQuantize(Transform, Quantized);
+}
+
+void FOrionStructureRecordCodec::Serialize(FArchive& Ar, TArray<FOrionStructureRecord>& Records, const uint32 InVersion)
+{
+	if (Ar.IsSaving())
+	{
+		/* ① Class dictionary */
+		TArray<FString> Classes;
+		TMap<FString, int32> ClassIndices;
+		TArray<int32> RecordClasses;
+		RecordClasses.Reserve(Records.Num());
+		for (const FOrionStructureRecord& Record : Records)
+		{
+			int32* Index = ClassIndices.Find(Record.ClassPath);
+			RecordClasses.Add(Index ? *Index : ClassIndices.Add(Record.ClassPath, Classes.Add(Record.ClassPath)));
+		}
+
+		uint32 NumClasses = Classes.Num();
+		Ar.SerializeIntPacked(NumClasses);
+		for (FString& ClassPath : Classes)
+		{
+			Ar << ClassPath;
+		}
+
+		/* ② Quantize, scales into their dictionary */
+		TArray<FQuantized> Quantized;
+		TArray<bool> IsQuantized;
+		Quantized.SetNum(Records.Num());
+		IsQuantized.SetNum(Records.Num());
+
+		TArray<FVector> Scales;
+		TMap<FVector, int32> ScaleIndices;
+		TArray<int32> Order;
+		Order.Reserve(Records.Num());
+		for (int32 i = 0; i < Records.Num(); ++i)
+		{
+			IsQuantized[i] = TryQuantize(Records[i].Transform, Quantized[i]);
+			if (IsQuantized[i])
+			{
+				const FVector Scale = Records[i].Transform.GetScale3D();
+				const int32* Index = ScaleIndices.Find(Scale);
+				Quantized[i].Scale = Index ? *Index : ScaleIndices.Add(Scale, Scales.Add(Scale));
+			}
+			else
+			{
+				// Sort key only
+				Quantized[i] = FQuantized();
+			}
+			Order.Add(i);
+		}
+
+		uint32 NumScales = Scales.Num();
+		Ar.SerializeIntPacked(NumScales);
+		for (FVector& Scale : Scales)
+		{
+			Ar << Scale;
+		}
+
+		/* ③ Sort by class and position so that neighbours are written one after the other */
+		Order.Sort([&](const int32 A, const int32 B)
+		{
+			if (RecordClasses[A] != RecordClasses[B])
+			{
+				return RecordClasses[A] < RecordClasses[B];
+			}
+			for (const int32 Axis : {2, 1, 0})
+			{
+				if (Quantized[A].Position[Axis] != Quantized[B].Position[Axis])
+				{
+					return Quantized[A].Position[Axis] < Quantized[B].Position[Axis];
+				}
+			}
+			if (Quantized[A].Yaw != Quantized[B].Yaw)
+			{
+				return Quantized[A].Yaw < Quantized[B].Yaw;
+			}
+			return Quantized[A].Scale < Quantized[B].Scale;
+		});
+
+		/* ④ Records, relative to the previous one */
+		int32 Num = Records.Num();
+		Ar << Num;
+
+		int32 PrevClass = 0;
+		int64 PrevId = 0;
+		FQuantized Prev;
+		for (const int32 i : Order)
+		{
+			uint32 ClassDelta = RecordClasses[i] - PrevClass;
+			Ar.SerializeIntPacked(ClassDelta);
+			PrevClass = RecordClasses[i];
+
+			uint64 IdDelta = ZigZag(Records[i].StructureId - PrevId);
+			Ar.SerializeIntPacked64(IdDelta);
+			PrevId = Records[i].StructureId;
+
+			uint8 Mode = static_cast<uint8>(IsQuantized[i] ? ERecordMode::Quantized : ERecordMode::FullPrecision);
+			Ar << Mode;
+
+			if (IsQuantized[i])
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					uint64 Delta = ZigZag(Quantized[i].Position[Axis] - Prev.Position[Axis]);
+					Ar.SerializeIntPacked64(Delta);
+				}
+				uint32 Yaw = Quantized[i].Yaw;
+				Ar.SerializeIntPacked(Yaw);
+				uint32 Scale = Quantized[i].Scale;
+				Ar.SerializeIntPacked(Scale);
+				Prev = Quantized[i];
+			}
+			else
+			{
+				FTransform Transform = Records[i].Transform;
+				Ar << Transform;
+			}
+		}
+		return;
+	}
+
+	/* Loading */
+	uint32 NumClasses = 0;
+	Ar.SerializeIntPacked(NumClasses);
+	if (NumClasses > Ar.TotalSize() - Ar.Tell())
+	{
+		Ar.SetError();
+		return;
+	}
+
+	TArray<FString> Classes;
+	Classes.SetNum(NumClasses);
+	for (FString& ClassPath : Classes)
+	{
+		Ar << ClassPath;
+	}
+
+	// Version 2: no dictionary, quantized records are unscaled
+	TArray<FVector> Scales;
+	if (InVersion >= 3)
+	{
+		uint32 NumScales = 0;
+		Ar.SerializeIntPacked(NumScales);
+		if (NumScales > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Scales.SetNum(NumScales);
+		for (FVector& Scale : Scales)
+		{
+			Ar << Scale;
+		}
+	}
+	else
+	{
+		Scales.Add(FVector::OneVector);
+	}
+
+	int32 Num = 0;
+	Ar << Num;
+	// Every record takes at least two bytes
+	if (Ar.IsError() || Num < 0 || Num > Ar.TotalSize() - Ar.Tell())
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Records.Reset(Num);
+	uint32 ClassIndex = 0;
+	int64 StructureId = 0;
+	FQuantized Prev;
+	for (int32 i = 0; i < Num && !Ar.IsError(); ++i)
+	{
+		uint32 ClassDelta = 0;
+		Ar.SerializeIntPacked(ClassDelta);
+		ClassIndex += ClassDelta;
+
+		if (InVersion >= 4)
+		{
+			uint64 IdDelta = 0;
+			Ar.SerializeIntPacked64(IdDelta);
+			StructureId += UnZigZag(IdDelta);
+		}
+
+		uint8 Mode = 0;
+		Ar << Mode;
+
+		FTransform Transform;
+		if (Mode == static_cast<uint8>(ERecordMode::Quantized))
+		{
+			FQuantized Quantized;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				uint64 Delta = 0;
+				Ar.SerializeIntPacked64(Delta);
+				Quantized.Position[Axis] = Prev.Position[Axis] + UnZigZag(Delta);
+			}
+			Ar.SerializeIntPacked(Quantized.Yaw);
+			if (InVersion >= 3)
+			{
+				Ar.SerializeIntPacked(Quantized.Scale);
+			}
+			if (Quantized.Yaw >= static_cast<uint32>(YawSteps) || Quantized.Scale >= static_cast<uint32>(Scales.Num()))
+			{
+				Ar.SetError();
+				break;
+			}
+			Transform = Dequantize(Quantized, Scales[Quantized.Scale]);
+			Prev = Quantized;
+		}
+		else if (Mode == static_cast<uint8>(ERecordMode::FullPrecision))
+		{
+			Ar << Transform;
+		}
+		else
+		{
+			Ar.SetError();
+		}
+
+		if (ClassIndex >= NumClasses)
+		{
+			Ar.SetError();
+		}
+		if (!Ar.IsError())
+		{
+			Records.Emplace(Classes[ClassIndex], Transform, static_cast<uint32>(StructureId));
+		}
+	}
+}
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOrionStructureRecord;
+
+/**
+ * Compact encoding of structure records (Structures section of the save container, version 4):
+ *
+ *   NumClasses | class paths... | NumScales | scales... | NumRecords | records...
+ *
+ * Class paths are written once and records refer to them by index. Records are sorted by class, then by position,
+ * and each one is written relative to the previous one as packed ints: a base of thousands of walls shares a
+ * handful of classes, and neighbours are about one module apart, so most records take a few bytes.
+ *
+ * A yaw-only record is quantized: its position on a grid of PositionStep (1/2048 of a foundation edge, well below
+ * the 1 mm overlap tolerance of the box set) and its yaw in 1/4 degree steps. Its scale is kept exactly, as an
+ * index into the scale dictionary (pieces are placed with the few scales of StructureOriginalScaleMap). Anything
+ * else (pitched roofs, far away positions) is written at full precision. Every record also carries its
+ * StructureId, relative to the previous record's.
+ *
+ * Version 2 had no scale dictionary and quantized unscaled records only; versions before 4 have no StructureId.
+ */
+class ORION_API FOrionStructureRecordCodec
+{
+public:
+	static constexpr double PositionStep = 62.5 / 2048.0; // STRUCTURE_LENGTH_BASE / 2048
+	static constexpr int32 YawSteps = 1440;               // Multiples of 30° and 45° are exact
+	static constexpr uint32 Version = 4;
+
+	/* Writes (always the current Version) or reads Records. Record order is not kept (sorted by class and position) */
+	static void Serialize(FArchive& Ar, TArray<FOrionStructureRecord>& Records, uint32 InVersion = Version);
+
+	/* Transform as it comes back from an encode / decode round trip */
+	static FTransform Snap(const FTransform& Transform);
+
+	/* Whether Transform takes the quantized path */
+	static bool IsQuantizable(const FTransform& Transform);
+
+private:
+	struct FQuantized
+	{
+		int64 Position[3] = {0, 0, 0};
+		uint32 Yaw = 0;
+		uint32 Scale = 0; // Scale dictionary index
+	};
+
+	/* Position and yaw only, the scale index is set by Serialize */
+	static bool TryQuantize(const FTransform& Transform, FQuantized& Out);
+	static FTransform Dequantize(const FQuantized& Quantized, const FVector& Scale);
+};
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Orion/OrionSaveGame/OrionSaveGame.h"
+#include "Orion/OrionSaveGame/OrionSaveNameTable.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/* Save objects of different sizes: their tagged properties repeat some names and add others */
+	TArray<TStrongObjectPtr<UOrionSaveGame>> MakeSaveObjects(const int32 Num)
+	{
+		TArray<TStrongObjectPtr<UOrionSaveGame>> Objects;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			UOrionSaveGame* SaveObj = NewObject<UOrionSaveGame>();
+			for (int32 j = 0; j <= i % 7; ++j)
+			{
+				const FTransform Transform(FRotator(0.0, 90.0 * j, 0.0), FVector(125.0 * i, 62.5 * j, 10.0 * (i % 3)));
+				SaveObj->SavedStructures.Emplace(FString::Printf(TEXT("/Game/Test/BP_Structure_%d.BP_Structure_%d_C"), j, j),
+				                                 Transform, i * 10 + j + 1);
+			}
+			if (i % 3 == 0)
+			{
+				FOrionSaveRemovedRecord& Removed = SaveObj->RemovedRecords.AddDefaulted_GetRef();
+				Removed.Section = i;
+				Removed.Key = FGuid(i, 0, 0, 1);
+			}
+			Objects.Emplace(SaveObj);
+		}
+		return Objects;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOrionSaveNameTableParallelEncodingTest, "Orion.Save.NameTable.ParallelEncoding",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOrionSaveNameTableParallelEncodingTest::RunTest(const FString& Parameters)
+{
+	const TArray<TStrongObjectPtr<UOrionSaveGame>> SaveObjects = MakeSaveObjects(64);
+	TArray<UObject*> Objects;
+	for (const TStrongObjectPtr<UOrionSaveGame>& SaveObj : SaveObjects)
+	{
+		Objects.Add(SaveObj.Get());
+	}
+
+	// Reference: one WriteObject after the other against the shared builder
+	FOrionSaveNameTableBuilder SerialBuilder;
+	TArray<TArray<uint8>> SerialBytes;
+	SerialBytes.SetNum(Objects.Num());
+	for (int32 i = 0; i < Objects.Num(); ++i)
+	{
+		FOrionNameTableArchive::WriteObject(*Objects[i], SerialBuilder, SerialBytes[i]);
+	}
+
+	for (const bool bParallel : {false, true})
+	{
+		FOrionSaveNameTableBuilder Builder;
+		TArray<TArray<uint8>> Bytes;
+		FOrionNameTableArchive::WriteObjects(Objects, Builder, Bytes, bParallel);
+
+		const TCHAR* Mode = bParallel ? TEXT("parallel") : TEXT("serial");
+		TestEqual(FString::Printf(TEXT("Record count (%s)"), Mode), Bytes.Num(), SerialBytes.Num());
+		for (int32 i = 0; i < FMath::Min(Bytes.Num(), SerialBytes.Num()); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Record %d bytes (%s)"), i, Mode), Bytes[i] == SerialBytes[i]);
+		}
+		TestTrue(FString::Printf(TEXT("Names (%s)"), Mode), Builder.GetNames() == SerialBuilder.GetNames());
+		TestTrue(FString::Printf(TEXT("GameIds (%s)"), Mode), Builder.GetGameIds() == SerialBuilder.GetGameIds());
+	}
+
+	// The encoded records read back into the same values
+	FOrionSaveNameTable Table;
+	SerialBuilder.TakeNewEntries(Table);
+	for (int32 i = 0; i < Objects.Num(); ++i)
+	{
+		UOrionSaveGame* Loaded = NewObject<UOrionSaveGame>();
+		FOrionNameTableArchive::ReadObject(*Loaded, SerialBytes[i], /*bUsesNameTable=*/true, Table, nullptr);
+
+		const UOrionSaveGame* Source = SaveObjects[i].Get();
+		if (!TestEqual(FString::Printf(TEXT("Record %d structures"), i), Loaded->SavedStructures.Num(),
+		               Source->SavedStructures.Num()))
+		{
+			continue;
+		}
+		for (int32 j = 0; j < Source->SavedStructures.Num(); ++j)
+		{
+			TestEqual(TEXT("Class path"), Loaded->SavedStructures[j].ClassPath, Source->SavedStructures[j].ClassPath);
+			TestEqual(TEXT("Structure id"), static_cast<int64>(Loaded->SavedStructures[j].StructureId),
+			          static_cast<int64>(Source->SavedStructures[j].StructureId));
+			TestTrue(TEXT("Transform"),
+			         Loaded->SavedStructures[j].Transform.Equals(Source->SavedStructures[j].Transform, 0.0));
+		}
+		TestEqual(FString::Printf(TEXT("Record %d removals"), i), Loaded->RemovedRecords.Num(),
+		          Source->RemovedRecords.Num());
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Orion/OrionGameInstance/OrionStructureBoxSet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const FVector Cube(50.0);
+
+	FOrionOrientedBox MakeBox(const FVector& Center, const FVector& Extent, const double Yaw = 0.0)
+	{
+		return FOrionOrientedBox(Center, FRotator(0.0, Yaw, 0.0).Quaternion(), Extent);
+	}
+
+	bool Touches(const FOrionOrientedBox& A, const FOrionOrientedBox& B)
+	{
+		return FOrionStructureBoxSet::Intersects(A, B, FOrionStructureBoxSet::TouchTolerance);
+	}
+
+	bool Overlaps(const FOrionOrientedBox& A, const FOrionOrientedBox& B)
+	{
+		return FOrionStructureBoxSet::Intersects(A, B, FOrionStructureBoxSet::OverlapTolerance);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOrionStructureBoxIntersectsTest, "Orion.Building.StructureBoxSet.Intersects",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOrionStructureBoxIntersectsTest::RunTest(const FString& Parameters)
+{
+	const FOrionOrientedBox A = MakeBox(FVector::ZeroVector, Cube);
+
+	/* Axis aligned, along X: faces touching, small gaps, penetrations around the tolerances */
+	TestTrue(TEXT("Face contact touches"), Touches(A, MakeBox(FVector(100.0, 0.0, 0.0), Cube)));
+	TestFalse(TEXT("Face contact does not overlap"), Overlaps(A, MakeBox(FVector(100.0, 0.0, 0.0), Cube)));
+	TestTrue(TEXT("3 cm gap touches"), Touches(A, MakeBox(FVector(103.0, 0.0, 0.0), Cube)));
+	TestFalse(TEXT("6 cm gap does not touch"), Touches(A, MakeBox(FVector(106.0, 0.0, 0.0), Cube)));
+	TestFalse(TEXT("0.05 cm penetration does not overlap"), Overlaps(A, MakeBox(FVector(99.95, 0.0, 0.0), Cube)));
+	TestTrue(TEXT("1 cm penetration overlaps"), Overlaps(A, MakeBox(FVector(99.0, 0.0, 0.0), Cube)));
+	TestTrue(TEXT("Same box overlaps"), Overlaps(A, A));
+	TestTrue(TEXT("Contained box overlaps"), Overlaps(A, MakeBox(FVector(10.0, 0.0, 0.0), FVector(5.0))));
+
+	/* Order does not matter without tolerance */
+	const FOrionOrientedBox Near = MakeBox(FVector(99.0, 20.0, 0.0), Cube, 30.0);
+	TestEqual(TEXT("Symmetric"), FOrionStructureBoxSet::Intersects(A, Near),
+	          FOrionStructureBoxSet::Intersects(Near, A));
+
+	/* Rotated: the corner of a 45° box (70.71 cm from its center along X) into a face */
+	TestTrue(TEXT("Rotated corner 0.7 cm deep overlaps"), Overlaps(A, MakeBox(FVector(120.0, 0.0, 0.0), Cube, 45.0)));
+	TestFalse(TEXT("Rotated corner 0.3 cm away does not overlap"),
+	          Overlaps(A, MakeBox(FVector(121.0, 0.0, 0.0), Cube, 45.0)));
+	TestTrue(TEXT("Rotated corner 0.3 cm away touches"), Touches(A, MakeBox(FVector(121.0, 0.0, 0.0), Cube, 45.0)));
+
+	/* Rotated, diagonal: AABBs overlap, the boxes do not (only B's face axes separate them) */
+	const FOrionOrientedBox Diagonal = MakeBox(FVector(110.0, 110.0, 0.0), Cube, 45.0);
+	TestTrue(TEXT("Diagonal AABBs overlap"), A.GetAABB().Intersect(Diagonal.GetAABB()));
+	TestFalse(TEXT("Diagonal boxes do not touch"), Touches(A, Diagonal));
+
+	/* Parallel edges (wall on a foundation, quarter turns): cross axes degenerate, epsilon keeps them robust */
+	const FOrionOrientedBox Foundation = MakeBox(FVector::ZeroVector, FVector(50.0, 50.0, 10.0));
+	TestTrue(TEXT("Wall on foundation touches"),
+	         Touches(Foundation, MakeBox(FVector(0.0, 0.0, 60.0), FVector(50.0, 5.0, 50.0))));
+	TestFalse(TEXT("Wall on foundation does not overlap"),
+	          Overlaps(Foundation, MakeBox(FVector(0.0, 0.0, 60.0), FVector(50.0, 5.0, 50.0))));
+	TestFalse(TEXT("Quarter turned wall on foundation does not overlap"),
+	          Overlaps(Foundation, MakeBox(FVector(0.0, 0.0, 60.0), FVector(50.0, 5.0, 50.0), 90.0)));
+	TestTrue(TEXT("Quarter turned wall 1 cm into foundation overlaps"),
+	         Overlaps(Foundation, MakeBox(FVector(0.0, 0.0, 59.0), FVector(50.0, 5.0, 50.0), 90.0)));
+	TestTrue(TEXT("Side by side quarter turned foundations touch"),
+	         Touches(Foundation, MakeBox(FVector(100.0, 0.0, 0.0), FVector(50.0, 50.0, 10.0), 90.0)));
+	TestFalse(TEXT("Side by side quarter turned foundations do not overlap"),
+	          Overlaps(Foundation, MakeBox(FVector(100.0, 0.0, 0.0), FVector(50.0, 50.0, 10.0), 90.0)));
+
+	/* Negative tolerance larger than the extent clamps to a point instead of inverting the box */
+	TestTrue(TEXT("Collapsed box inside a neighbour still overlaps it"),
+	         FOrionStructureBoxSet::Intersects(MakeBox(FVector::ZeroVector, FVector(1.0)),
+	                                           MakeBox(FVector(8.0, 0.0, 0.0), FVector(10.0)), -5.f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOrionStructureBoxSetQueryTest, "Orion.Building.StructureBoxSet.Queries",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOrionStructureBoxSetQueryTest::RunTest(const FString& Parameters)
+{
+	FOrionStructureBoxSet Boxes;
+	Boxes.Add(1, MakeBox(FVector::ZeroVector, Cube));
+	Boxes.Add(2, MakeBox(FVector(100.0, 0.0, 0.0), Cube));       // Face contact with 1
+	Boxes.Add(3, MakeBox(FVector(0.0, 110.0, 0.0), Cube));       // 10 cm away from 1
+	Boxes.Add(4, MakeBox(FVector(0.0, 0.0, 0.0), FVector(1200.0, 10.0, 10.0))); // Spans several cells
+
+	TArray<int32> Keys;
+	Boxes.QueryTouching(*Boxes.Find(1), Keys, 1);
+	Keys.Sort();
+	TestTrue(TEXT("Neighbours of 1"), Keys == TArray<int32>({2, 4}));
+
+	Keys.Reset();
+	Boxes.QueryTouching(MakeBox(FVector(-1100.0, 0.0, 0.0), FVector(20.0)), Keys);
+	TestTrue(TEXT("Box spanning cells is reported once"), Keys == TArray<int32>({4}));
+
+	TestFalse(TEXT("Face contact is no blocker"), Boxes.AnyOverlapping(MakeBox(FVector(0.0, 210.0, 0.0), Cube)));
+	TestTrue(TEXT("Overlap is a blocker"), Boxes.AnyOverlapping(MakeBox(FVector(0.0, 150.0, 0.0), Cube)));
+	TestFalse(TEXT("Ignored key is no blocker"), Boxes.AnyOverlapping(*Boxes.Find(3), 3));
+
+	// Add with an existing key replaces the box, Remove clears every cell
+	Boxes.Add(4, MakeBox(FVector(5000.0, 5000.0, 0.0), FVector(10.0)));
+	Keys.Reset();
+	Boxes.QueryTouching(MakeBox(FVector(-1100.0, 0.0, 0.0), FVector(20.0)), Keys);
+	TestEqual(TEXT("Moved box left its old cells"), Keys.Num(), 0);
+
+	Boxes.Remove(2);
+	Keys.Reset();
+	Boxes.QueryTouching(*Boxes.Find(1), Keys, 1);
+	TestEqual(TEXT("Removed box is gone"), Keys.Num(), 0);
+	TestEqual(TEXT("Boxes left"), Boxes.Num(), 3);
+
+	return true;
+}
+
+#endif
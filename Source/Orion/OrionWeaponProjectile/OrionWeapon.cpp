@@ -188,7 +188,7 @@ void AOrionWeapon::Fire(const FVector& SpawnLocation, const FVector& Direction,
 					continue; // outside cone
 				}
 
-				if (UOrionAttributeComponent* AttributeComp = HitActor->FindComponentByClass<UOrionAttributeComponent>())
+				if (UOrionAttributeComponent* AttributeComp = UOrionAttributeComponent::FindOnActor(HitActor))
 				{
 					AttributeComp->ReceiveDamage(DamageAmount, GetOwner());
 					DrawDebugSphere(World, HitActor->GetActorLocation(), 20.f, 12, FColor::Green, false, 1.0f);